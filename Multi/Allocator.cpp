@@ -0,0 +1,349 @@
+/**********************************************************************************
+// Allocator (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Poltica de sub-alocao de memria usada pelos buffers da GPU.
+//              Grandes heaps so divididas por um alocador buddy com classes de
+//              tamanho em potncias de 2. A criao das heaps fica a cargo de
+//              um HeapBackend.
+//
+**********************************************************************************/
+
+#include "Allocator.h"
+
+// -------------------------------------------------------------------------------
+// Estados dos ns da rvore
+
+enum BuddyState : byte { NODE_NONE, NODE_FREE, NODE_USED, NODE_SPLIT };
+
+// -------------------------------------------------------------------------------
+
+static ullong NextPow2(ullong value)
+{
+    ullong pow2 = 1;
+    while (pow2 < value)
+        pow2 <<= 1;
+    return pow2;
+}
+
+// -------------------------------------------------------------------------------
+
+float AllocStats::Fragmentation() const
+{
+    ullong free = capacity - bytesReserved;
+
+    if (free == 0)
+        return 0.0f;
+
+    return 1.0f - float(largestFree) / float(free);
+}
+
+// -------------------------------------------------------------------------------
+// BuddyAllocator
+// -------------------------------------------------------------------------------
+
+BuddyAllocator::BuddyAllocator(ullong heapSize, ullong minBlockSize)
+{
+    minBlock = NextPow2(minBlockSize);
+    capacity = NextPow2(heapSize < minBlock ? minBlock : heapSize);
+
+    levels = 0;
+    while ((minBlock << levels) < capacity)
+        ++levels;
+
+    // rvore binria implcita: o n n tem filhos 2n e 2n+1
+    // e a raiz ocupa a posio 1 (o ndice 0 marca lista vazia)
+    uint nodes = 2u << levels;
+    state.assign(nodes, NODE_NONE);
+    next.assign(nodes, 0);
+    prev.assign(nodes, 0);
+    freeHead.assign(levels + 1, 0);
+
+    inUse = 0;
+    reserved = 0;
+    count = 0;
+
+    // a heap comea como um nico bloco livre
+    state[1] = NODE_FREE;
+    Push(1, levels);
+}
+
+// -------------------------------------------------------------------------------
+
+void BuddyAllocator::Push(uint node, uint order)
+{
+    next[node] = freeHead[order];
+    prev[node] = 0;
+
+    if (freeHead[order])
+        prev[freeHead[order]] = node;
+
+    freeHead[order] = node;
+}
+
+// -------------------------------------------------------------------------------
+
+void BuddyAllocator::Remove(uint node, uint order)
+{
+    if (prev[node])
+        next[prev[node]] = next[node];
+    else
+        freeHead[order] = next[node];
+
+    if (next[node])
+        prev[next[node]] = prev[node];
+
+    next[node] = prev[node] = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+uint BuddyAllocator::Order(ullong size) const
+{
+    uint order = 0;
+    while ((minBlock << order) < size)
+        ++order;
+    return order;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong BuddyAllocator::Allocate(ullong size, ullong alignment)
+{
+    // blocos de tamanho 2^k comeam em mltiplos de 2^k,
+    // ento basta arredondar o pedido para o alinhamento
+    ullong blockSize = size > alignment ? size : alignment;
+
+    if (blockSize == 0 || blockSize > capacity)
+        return Invalid;
+
+    uint order = Order(blockSize);
+
+    // procura a menor classe de tamanho com bloco livre
+    uint found = order;
+    while (found <= levels && !freeHead[found])
+        ++found;
+
+    if (found > levels)
+        return Invalid;
+
+    uint node = freeHead[found];
+    Remove(node, found);
+
+    // divide o bloco at chegar no tamanho pedido
+    while (found > order)
+    {
+        state[node] = NODE_SPLIT;
+        --found;
+
+        state[2 * node + 1] = NODE_FREE;
+        Push(2 * node + 1, found);
+
+        node = 2 * node;
+    }
+
+    state[node] = NODE_USED;
+
+    ullong bytes = minBlock << order;
+    uint depth = levels - order;
+
+    inUse += size;
+    reserved += bytes;
+    ++count;
+
+    return ullong(node - (1u << depth)) * bytes;
+}
+
+// -------------------------------------------------------------------------------
+
+void BuddyAllocator::Free(ullong offset, ullong size)
+{
+    // parte da folha que contm o deslocamento e sobe
+    // na rvore at encontrar o bloco ocupado
+    uint node = (1u << levels) + uint(offset / minBlock);
+    uint order = 0;
+
+    while (node > 1 && state[node] != NODE_USED)
+    {
+        node >>= 1;
+        ++order;
+    }
+
+    if (state[node] != NODE_USED)
+        return;
+
+    inUse -= size;
+    reserved -= minBlock << order;
+    --count;
+
+    // junta o bloco com seu vizinho enquanto ambos estiverem livres
+    while (node > 1 && state[node ^ 1] == NODE_FREE)
+    {
+        Remove(node ^ 1, order);
+        state[node ^ 1] = NODE_NONE;
+        state[node] = NODE_NONE;
+
+        node >>= 1;
+        ++order;
+    }
+
+    state[node] = NODE_FREE;
+    Push(node, order);
+}
+
+// -------------------------------------------------------------------------------
+
+ullong BuddyAllocator::LargestFree() const
+{
+    for (uint order = levels + 1; order > 0; --order)
+        if (freeHead[order - 1])
+            return minBlock << (order - 1);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void BuddyAllocator::Stats(AllocStats & stats) const
+{
+    ullong largest = LargestFree();
+
+    stats.capacity += capacity;
+    stats.bytesInUse += inUse;
+    stats.bytesReserved += reserved;
+    stats.allocations += count;
+    stats.heaps += 1;
+
+    if (largest > stats.largestFree)
+        stats.largestFree = largest;
+}
+
+// -------------------------------------------------------------------------------
+// HeapPool
+// -------------------------------------------------------------------------------
+
+HeapPool::HeapPool(HeapBackend * heapBackend, ullong size, ullong minBlockSize)
+    : backend(heapBackend), heapSize(NextPow2(size)), minBlock(minBlockSize)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+HeapPool::~HeapPool()
+{
+    for (auto & b : blocks)
+    {
+        if (b.heap)
+        {
+            backend->Destroy(b.heap);
+            delete b.buddy;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool HeapPool::Allocate(ullong size, ullong alignment, PoolAllocation * alloc)
+{
+    // tenta sub-alocar nas heaps existentes
+    for (uint i = 0; i < blocks.size(); ++i)
+    {
+        if (!blocks[i].heap)
+            continue;
+
+        ullong offset = blocks[i].buddy->Allocate(size, alignment);
+
+        if (offset != BuddyAllocator::Invalid)
+        {
+            alloc->heap = blocks[i].heap;
+            alloc->block = i;
+            alloc->offset = offset;
+            alloc->size = size;
+            return true;
+        }
+    }
+
+    // cria uma nova heap, maior que o padro se o pedido no couber
+    ullong needed = NextPow2(size > alignment ? size : alignment);
+    ullong newSize = needed > heapSize ? needed : heapSize;
+
+    Block block;
+    block.heap = backend->Create(newSize);
+
+    if (!block.heap)
+        return false;
+
+    block.buddy = new BuddyAllocator(newSize, minBlock);
+
+    // reaproveita posies de heaps destrudas por Trim
+    uint index = uint(blocks.size());
+    for (uint i = 0; i < blocks.size(); ++i)
+    {
+        if (!blocks[i].heap)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == blocks.size())
+        blocks.push_back(block);
+    else
+        blocks[index] = block;
+
+    alloc->heap = block.heap;
+    alloc->block = index;
+    alloc->offset = block.buddy->Allocate(size, alignment);
+    alloc->size = size;
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapPool::Free(const PoolAllocation & alloc)
+{
+    if (alloc.block < blocks.size() && blocks[alloc.block].heap == alloc.heap)
+        blocks[alloc.block].buddy->Free(alloc.offset, alloc.size);
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapPool::Trim()
+{
+    // mantm a primeira heap para evitar recriaes constantes
+    bool kept = false;
+
+    for (auto & b : blocks)
+    {
+        if (!b.heap)
+            continue;
+
+        if (b.buddy->Empty() && kept)
+        {
+            backend->Destroy(b.heap);
+            delete b.buddy;
+            b.heap = nullptr;
+            b.buddy = nullptr;
+        }
+
+        kept = true;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+AllocStats HeapPool::Stats() const
+{
+    AllocStats stats;
+
+    for (auto & b : blocks)
+        if (b.heap)
+            b.buddy->Stats(stats);
+
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
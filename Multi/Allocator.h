@@ -0,0 +1,148 @@
+/**********************************************************************************
+// Allocator (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Poltica de sub-alocao de memria usada pelos buffers da GPU.
+//              Grandes heaps so divididas por um alocador buddy com classes de
+//              tamanho em potncias de 2. A criao das heaps fica a cargo de
+//              um HeapBackend.
+//
+**********************************************************************************/
+
+#ifndef DXUT_ALLOCATOR_H_
+#define DXUT_ALLOCATOR_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct AllocStats
+{
+    ullong capacity = 0;                    // bytes disponveis em todas as heaps
+    ullong bytesInUse = 0;                  // bytes solicitados pelas alocaes ativas
+    ullong bytesReserved = 0;               // bytes ocupados pelos blocos (com arredondamento)
+    ullong largestFree = 0;                 // maior bloco livre contguo
+    uint   allocations = 0;                 // nmero de alocaes ativas
+    uint   heaps = 0;                       // nmero de heaps criadas
+
+    float Fragmentation() const;            // 1 - (maior bloco livre / memria livre)
+};
+
+// -------------------------------------------------------------------------------
+// BuddyAllocator
+// -------------------------------------------------------------------------------
+
+class BuddyAllocator
+{
+public:
+    static const ullong Invalid = ~0ULL;    // falha na alocao
+
+private:
+    ullong capacity;                        // tamanho da heap (potncia de 2)
+    ullong minBlock;                        // menor bloco (potncia de 2)
+    uint levels;                            // nmero de divises da heap
+
+    vector<byte> state;                     // estado de cada n da rvore
+    vector<uint> next;                      // prximo n na lista de livres
+    vector<uint> prev;                      // n anterior na lista de livres
+    vector<uint> freeHead;                  // lista de blocos livres por classe de tamanho
+
+    ullong inUse;                           // bytes solicitados
+    ullong reserved;                        // bytes em blocos ocupados
+    uint count;                             // alocaes ativas
+
+    void Push(uint node, uint order);       // insere n na lista de livres
+    void Remove(uint node, uint order);     // remove n da lista de livres
+    uint Order(ullong size) const;          // classe de tamanho para um pedido
+
+public:
+    BuddyAllocator(ullong heapSize, ullong minBlockSize = 256);
+
+    ullong Allocate(ullong size, ullong alignment = 0);     // retorna deslocamento ou Invalid
+    void Free(ullong offset, ullong size);                  // libera bloco alocado no deslocamento
+
+    bool Empty() const;                     // nenhuma alocao ativa
+    ullong Capacity() const;                // tamanho da heap
+    ullong LargestFree() const;             // maior bloco livre
+    void Stats(AllocStats & stats) const;   // acumula estatsticas
+};
+
+// -------------------------------------------------------------------------------
+// HeapBackend
+// -------------------------------------------------------------------------------
+
+class HeapBackend
+{
+public:
+    virtual ~HeapBackend() {}
+    virtual void * Create(ullong size) = 0; // cria uma heap e retorna seu identificador
+    virtual void Destroy(void * heap) = 0;  // destri uma heap criada por Create
+};
+
+// -------------------------------------------------------------------------------
+// MemoryHeap: heaps na memria do sistema, usadas para exercitar a
+// poltica de alocao sem um dispositivo grfico
+// -------------------------------------------------------------------------------
+
+class MemoryHeap : public HeapBackend
+{
+public:
+    void * Create(ullong size) { return new byte[uint(size)]; }
+    void Destroy(void * heap) { delete[] static_cast<byte*>(heap); }
+};
+
+// -------------------------------------------------------------------------------
+// HeapPool
+// -------------------------------------------------------------------------------
+
+struct PoolAllocation
+{
+    void * heap = nullptr;                  // heap que contm o bloco
+    uint   block = 0;                       // ndice da heap no pool
+    ullong offset = 0;                      // deslocamento dentro da heap
+    ullong size = 0;                        // tamanho solicitado
+};
+
+class HeapPool
+{
+private:
+    struct Block
+    {
+        void * heap;                        // heap criada pelo backend
+        BuddyAllocator * buddy;             // sub-alocador da heap
+    };
+
+    HeapBackend * backend;                  // cria e destri heaps
+    ullong heapSize;                        // tamanho padro de cada heap
+    ullong minBlock;                        // menor bloco alocvel
+    vector<Block> blocks;                   // heaps do pool
+
+public:
+    HeapPool(HeapBackend * heapBackend, ullong size, ullong minBlockSize = 256);
+    ~HeapPool();
+
+    bool Allocate(ullong size, ullong alignment, PoolAllocation * alloc);   // sub-aloca um bloco
+    void Free(const PoolAllocation & alloc);                                // devolve um bloco
+    void Trim();                                                            // destri heaps vazias extras
+    AllocStats Stats() const;                                               // estatsticas do pool
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline bool BuddyAllocator::Empty() const
+{ return count == 0; }
+
+inline ullong BuddyAllocator::Capacity() const
+{ return capacity; }
+
+// -------------------------------------------------------------------------------
+
+#endif
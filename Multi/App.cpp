@@ -25,6 +25,9 @@
 Graphics*& App::graphics = Engine::graphics;    // componente grfico 
 Window*& App::window = Engine::window;          // janela da aplicao
 Input*& App::input = Engine::input;             // dispositivos de entrada
+JobSystem*& App::jobs = Engine::jobs;           // threads de trabalho
+FrameHandoff*& App::handoff = Engine::handoff; // cpias do quadro em atualizao e em desenho
+bool& App::pipelined = Engine::pipelined;       // Draw em thread prpria
 double& App::frameTime = Engine::frameTime;     // tempo do ltimo quadro
 
 // -------------------------------------------------------------------------------
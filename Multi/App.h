@@ -19,6 +19,8 @@
 #include "Graphics.h"
 #include "Window.h"
 #include "Input.h"
+#include "Jobs.h"
+#include "Handoff.h"
 
 // ---------------------------------------------------------------------------------
 
@@ -32,6 +34,9 @@ protected:
 	static Graphics*& graphics;					// componente grfico
 	static Window*& window;						// janela da aplicao
 	static Input*& input;						// dispositivos de entrada
+	static JobSystem*& jobs;					// threads de trabalho
+	static FrameHandoff*& handoff;				// cpias do quadro em atualizao e em desenho
+	static bool& pipelined;						// Draw em thread prpria, um quadro atrs de Update
 	static double& frameTime;					// tempo do ltimo quadro
 
 public:
@@ -51,6 +56,8 @@ public:
 	// - Display  chamado apenas uma vez no incio da aplicao
 	//   e deve ser chamado manualmente em Update toda vez
 	//   que a tela precisar ser redesenhada.
+	// Com pipelined ligado, Draw roda em outra thread, um quadro
+	// atrs de Update, e s deve ler a cpia indicada por handoff.
 
 	virtual void Draw() {}						// desenho
 	virtual void Display() {}					// exibio
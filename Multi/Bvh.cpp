@@ -0,0 +1,510 @@
+/**********************************************************************************
+// Bvh (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de volumes envolventes (BVH) sobre as caixas dos
+//              objetos da cena. A rvore  construda com SAH em compartimentos
+//              (binned SAH) e guardada em um vetor plano de ns de 32 bytes,
+//              com os filhos de cada n em posies vizinhas. Objetos movidos
+//              apenas reajustam as caixas dos ancestrais (refit) e a rvore 
+//              reconstruda quando o custo SAH degrada demais. Consultas por
+//              raio visitam primeiro o filho mais prximo.
+//
+**********************************************************************************/
+
+#include "Bvh.h"
+#include "Culling.h"
+#include <algorithm>
+#include <cfloat>
+
+// -------------------------------------------------------------------------------
+
+// metade da rea da superfcie de uma caixa
+static float Area(const float * min, const float * max)
+{
+    float dx = max[0] - min[0];
+    float dy = max[1] - min[1];
+    float dz = max[2] - min[2];
+
+    if (dx < 0 || dy < 0 || dz < 0)
+        return 0;
+
+    return dx * dy + dy * dz + dz * dx;
+}
+
+// -------------------------------------------------------------------------------
+
+// caixa vazia, pronta para crescer
+static void Empty(float * min, float * max)
+{
+    for (uint k = 0; k < 3; ++k)
+    {
+        min[k] = FLT_MAX;
+        max[k] = -FLT_MAX;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+// aumenta a caixa (min, max) para conter a caixa (bmin, bmax)
+static void Grow(float * min, float * max, const float * bmin, const float * bmax)
+{
+    for (uint k = 0; k < 3; ++k)
+    {
+        if (bmin[k] < min[k]) min[k] = bmin[k];
+        if (bmax[k] > max[k]) max[k] = bmax[k];
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+Bvh::Bvh(float degradation)
+{
+    rebuild = false;
+    refitted = false;
+    maxDegradation = degradation;
+}
+
+// -------------------------------------------------------------------------------
+
+uint Bvh::Add(const Bounds & b)
+{
+    Box box;
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        box.min[k] = b.center[k] - b.extents[k];
+        box.max[k] = b.center[k] + b.extents[k];
+    }
+
+    boxes.push_back(box);
+
+    // a topologia muda: a rvore  refeita na prxima atualizao
+    rebuild = true;
+    return uint(boxes.size() - 1);
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Remove(uint index)
+{
+    if (index >= boxes.size())
+        return;
+
+    // a ltima caixa ocupa o lugar da removida; a rvore  refeita no Update
+    boxes[index] = boxes.back();
+    boxes.pop_back();
+    rebuild = true;
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Set(uint index, const Bounds & b)
+{
+    Box & box = boxes[index];
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        box.min[k] = b.center[k] - b.extents[k];
+        box.max[k] = b.center[k] + b.extents[k];
+    }
+
+    if (rebuild || nodes.empty())
+        return;
+
+    // reajusta a folha e sobe at o primeiro ancestral que no muda
+    uint node = leafOf[index];
+
+    while (node != None && Enclose(node))
+        node = parents[node];
+
+    ++stats.refits;
+    refitted = true;
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Clear()
+{
+    boxes.clear();
+    nodes.clear();
+    indices.clear();
+    parents.clear();
+    leafOf.clear();
+    rebuild = false;
+    refitted = false;
+    stats = BvhStats();
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Build()
+{
+    uint count = uint(boxes.size());
+
+    nodes.clear();
+    parents.clear();
+    indices.resize(count);
+    leafOf.assign(count, uint(None));
+    rebuild = false;
+    refitted = false;
+
+    stats.depth = 0;
+    stats.leaves = 0;
+    ++stats.builds;
+
+    // as caixas so particionadas junto com os ndices para
+    // que a construo percorra a memria em sequncia
+    sorted = boxes;
+
+    for (uint i = 0; i < count; ++i)
+        indices[i] = i;
+
+    if (count > 0)
+    {
+        // uma rvore binria com folhas no vazias tem menos de 2n ns:
+        // a reserva evita realocaes durante a diviso
+        nodes.reserve(2 * size_t(count));
+        parents.reserve(2 * size_t(count));
+
+        nodes.push_back({ { 0, 0, 0 }, 0, { 0, 0, 0 }, count });
+        parents.push_back(uint(None));
+        Enclose(0);
+        Split(0, 1);
+
+        for (uint n = 0; n < nodes.size(); ++n)
+        {
+            if (nodes[n].Leaf())
+            {
+                ++stats.leaves;
+
+                for (uint i = 0; i < nodes[n].count; ++i)
+                    leafOf[indices[nodes[n].first + i]] = n;
+            }
+        }
+    }
+
+    stats.nodes = uint(nodes.size());
+    stats.buildCost = stats.cost = Cost();
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Split(uint node, uint depth)
+{
+    if (depth > stats.depth)
+        stats.depth = depth;
+
+    uint first = nodes[node].first;
+    uint count = nodes[node].count;
+
+    if (count <= 1)
+        return;
+
+    // caixa dos centros: define os compartimentos de cada eixo
+    float cmin[3], cmax[3];
+    Empty(cmin, cmax);
+
+    for (uint i = first; i < first + count; ++i)
+    {
+        const Box & b = sorted[i];
+        float c[3] = { (b.min[0] + b.max[0]) * 0.5f, (b.min[1] + b.max[1]) * 0.5f, (b.min[2] + b.max[2]) * 0.5f };
+        Grow(cmin, cmax, c, c);
+    }
+
+    // custo de manter uma folha e de dividir (travessia + filhos)
+    float nodeArea = Area(nodes[node].min, nodes[node].max);
+    float leafCost = nodeArea * count;
+    float bestCost = FLT_MAX;
+    uint bestAxis = None;
+    uint bestBin = 0;
+
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+        float extent = cmax[axis] - cmin[axis];
+
+        if (extent <= 0)
+            continue;
+
+        struct Bin { float min[3], max[3]; uint count; } bins[Bins];
+
+        for (auto & bin : bins)
+        {
+            Empty(bin.min, bin.max);
+            bin.count = 0;
+        }
+
+        float scale = Bins / extent;
+
+        for (uint i = first; i < first + count; ++i)
+        {
+            const Box & b = sorted[i];
+            float c = (b.min[axis] + b.max[axis]) * 0.5f;
+            uint k = std::min(Bins - 1, uint((c - cmin[axis]) * scale));
+            Grow(bins[k].min, bins[k].max, b.min, b.max);
+            ++bins[k].count;
+        }
+
+        // reas e contagens acumuladas da esquerda para a direita e vice-versa
+        float leftArea[Bins - 1], rightArea[Bins - 1];
+        uint leftCount[Bins - 1], rightCount[Bins - 1];
+        float lmin[3], lmax[3], rmin[3], rmax[3];
+        Empty(lmin, lmax);
+        Empty(rmin, rmax);
+        uint lsum = 0, rsum = 0;
+
+        for (uint i = 0; i < Bins - 1; ++i)
+        {
+            lsum += bins[i].count;
+            leftCount[i] = lsum;
+            if (bins[i].count) Grow(lmin, lmax, bins[i].min, bins[i].max);
+            leftArea[i] = Area(lmin, lmax);
+
+            uint j = Bins - 1 - i;
+            rsum += bins[j].count;
+            rightCount[j - 1] = rsum;
+            if (bins[j].count) Grow(rmin, rmax, bins[j].min, bins[j].max);
+            rightArea[j - 1] = Area(rmin, rmax);
+        }
+
+        for (uint i = 0; i < Bins - 1; ++i)
+        {
+            if (leftCount[i] == 0 || rightCount[i] == 0)
+                continue;
+
+            float cost = nodeArea + leftArea[i] * leftCount[i] + rightArea[i] * rightCount[i];
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = i;
+            }
+        }
+    }
+
+    uint mid;
+
+    if (bestAxis != None && (bestCost < leafCost || count > MaxLeaf))
+    {
+        // primitivas dos compartimentos at bestBin vo para a esquerda
+        float scale = Bins / (cmax[bestAxis] - cmin[bestAxis]);
+        auto left = [&](const Box & b)
+        {
+            float c = (b.min[bestAxis] + b.max[bestAxis]) * 0.5f;
+            return std::min(Bins - 1, uint((c - cmin[bestAxis]) * scale)) <= bestBin;
+        };
+
+        uint i = first;
+        uint j = first + count;
+
+        while (i < j)
+        {
+            if (left(sorted[i]))
+            {
+                ++i;
+            }
+            else
+            {
+                --j;
+                std::swap(sorted[i], sorted[j]);
+                std::swap(indices[i], indices[j]);
+            }
+        }
+
+        mid = i;
+    }
+    else if (count > MaxLeaf)
+    {
+        // centros coincidentes: divide a lista ao meio
+        mid = first + count / 2;
+    }
+    else
+    {
+        return;
+    }
+
+    // filhos em posies vizinhas do vetor de ns
+    uint left = uint(nodes.size());
+    nodes.push_back({ { 0, 0, 0 }, first, { 0, 0, 0 }, mid - first });
+    nodes.push_back({ { 0, 0, 0 }, mid, { 0, 0, 0 }, first + count - mid });
+    parents.push_back(node);
+    parents.push_back(node);
+
+    nodes[node].first = left;
+    nodes[node].count = 0;
+
+    Enclose(left);
+    Enclose(left + 1);
+    Split(left, depth + 1);
+    Split(left + 1, depth + 1);
+}
+
+// -------------------------------------------------------------------------------
+
+bool Bvh::Enclose(uint node)
+{
+    BvhNode & n = nodes[node];
+    float min[3], max[3];
+    Empty(min, max);
+
+    if (n.Leaf())
+    {
+        for (uint i = 0; i < n.count; ++i)
+        {
+            const Box & b = boxes[indices[n.first + i]];
+            Grow(min, max, b.min, b.max);
+        }
+    }
+    else
+    {
+        Grow(min, max, nodes[n.first].min, nodes[n.first].max);
+        Grow(min, max, nodes[n.first + 1].min, nodes[n.first + 1].max);
+    }
+
+    bool changed = false;
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        if (min[k] != n.min[k] || max[k] != n.max[k])
+            changed = true;
+
+        n.min[k] = min[k];
+        n.max[k] = max[k];
+    }
+
+    return changed;
+}
+
+// -------------------------------------------------------------------------------
+
+float Bvh::Cost() const
+{
+    if (nodes.empty())
+        return 0;
+
+    float rootArea = Area(nodes[0].min, nodes[0].max);
+
+    if (rootArea <= 0)
+        return 0;
+
+    // ns internos custam uma travessia, folhas um teste por primitiva
+    float cost = 0;
+
+    for (const BvhNode & n : nodes)
+        cost += Area(n.min, n.max) * (n.Leaf() ? float(n.count) : 1.0f);
+
+    return cost / rootArea;
+}
+
+// -------------------------------------------------------------------------------
+
+bool Bvh::Update()
+{
+    if (rebuild)
+    {
+        Build();
+        return true;
+    }
+
+    if (refitted)
+    {
+        // reajustes sucessivos alargam as caixas e misturam os ramos
+        refitted = false;
+        stats.cost = Cost();
+
+        if (stats.cost > stats.buildCost * maxDegradation)
+        {
+            Build();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------
+
+// entrada do raio na caixa, ou FLT_MAX se no a cruza antes de maxT
+static float Slab(const float * min, const float * max, const float * origin, const float * inverse, float maxT)
+{
+    float tmin = 0;
+    float tmax = maxT;
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        float t0 = (min[k] - origin[k]) * inverse[k];
+        float t1 = (max[k] - origin[k]) * inverse[k];
+
+        if (t0 > t1) { float s = t0; t0 = t1; t1 = s; }
+        if (t0 > tmin) tmin = t0;
+        if (t1 < tmax) tmax = t1;
+    }
+
+    return tmin <= tmax ? tmin : FLT_MAX;
+}
+
+// -------------------------------------------------------------------------------
+
+float Bvh::Raycast(const float * origin, const float * direction, float maxT,
+                   const function<float(uint, float)> & hit) const
+{
+    if (nodes.empty())
+        return maxT;
+
+    // direes nulas viram infinitos e o teste de placas continua vlido
+    float inverse[3];
+    for (uint k = 0; k < 3; ++k)
+        inverse[k] = direction[k] != 0 ? 1.0f / direction[k] : FLT_MAX;
+
+    float closest = maxT;
+    // a pilha nunca passa de um irmo pendente por nvel
+    vector<uint> stack;
+    stack.reserve(size_t(stats.depth) + 2);
+
+    if (Slab(nodes[0].min, nodes[0].max, origin, inverse, closest) != FLT_MAX)
+        stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const BvhNode & n = nodes[stack.back()];
+        stack.pop_back();
+
+        if (n.Leaf())
+        {
+            for (uint i = 0; i < n.count; ++i)
+                closest = hit(indices[n.first + i], closest);
+
+            continue;
+        }
+
+        uint a = n.first;
+        uint b = n.first + 1;
+        float ta = Slab(nodes[a].min, nodes[a].max, origin, inverse, closest);
+        float tb = Slab(nodes[b].min, nodes[b].max, origin, inverse, closest);
+
+        // o filho mais prximo fica no topo da pilha
+        if (ta > tb) { uint s = a; a = b; b = s; float t = ta; ta = tb; tb = t; }
+
+        if (tb != FLT_MAX) stack.push_back(b);
+        if (ta != FLT_MAX) stack.push_back(a);
+    }
+
+    return closest;
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Primitive(uint index, float * min, float * max) const
+{
+    for (uint k = 0; k < 3; ++k)
+    {
+        min[k] = boxes[index].min[k];
+        max[k] = boxes[index].max[k];
+    }
+}
+
+// -------------------------------------------------------------------------------
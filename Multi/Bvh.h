@@ -0,0 +1,123 @@
+/**********************************************************************************
+// Bvh (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de volumes envolventes (BVH) sobre as caixas dos
+//              objetos da cena. A rvore  construda com SAH em compartimentos
+//              (binned SAH) e guardada em um vetor plano de ns de 32 bytes,
+//              com os filhos de cada n em posies vizinhas. Objetos movidos
+//              apenas reajustam as caixas dos ancestrais (refit) e a rvore 
+//              reconstruda quando o custo SAH degrada demais. Consultas por
+//              raio visitam primeiro o filho mais prximo.
+//
+**********************************************************************************/
+
+#ifndef DXUT_BVH_H_
+#define DXUT_BVH_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <functional>
+#include <vector>
+using std::function;
+using std::vector;
+
+struct Bounds;
+
+// -------------------------------------------------------------------------------
+
+struct BvhNode
+{
+    float min[3];                           // canto mnimo da caixa
+    uint  first;                            // primeiro filho (interno) ou primeira primitiva (folha)
+    float max[3];                           // canto mximo da caixa
+    uint  count;                            // primitivas na folha (0 em ns internos)
+
+    bool Leaf() const { return count > 0; }
+};
+
+// -------------------------------------------------------------------------------
+
+struct BvhStats
+{
+    uint  nodes = 0;                        // ns da rvore
+    uint  leaves = 0;                       // folhas da rvore
+    uint  depth = 0;                        // profundidade mxima
+    uint  builds = 0;                       // construes completas
+    uint  refits = 0;                       // objetos reajustados sem reconstruo
+    float buildCost = 0;                    // custo SAH logo aps a construo
+    float cost = 0;                         // custo SAH atual
+};
+
+// -------------------------------------------------------------------------------
+
+class Bvh
+{
+public:
+    static const uint MaxLeaf = 4;          // primitivas por folha
+    static const uint Bins = 12;            // compartimentos por eixo na construo
+    static const uint None = ~0u;           // n ou primitiva inexistente
+
+private:
+    struct Box { float min[3]; float max[3]; };
+
+    vector<Box> boxes;                      // caixa de cada primitiva (ndice do objeto)
+    vector<BvhNode> nodes;                  // rvore em vetor plano, raiz na posio 0
+    vector<uint> indices;                   // primitivas ordenadas pelas folhas
+    vector<Box> sorted;                     // caixas na ordem de indices durante a construo
+    vector<uint> parents;                   // pai de cada n
+    vector<uint> leafOf;                    // folha que contm cada primitiva
+    bool rebuild;                           // primitivas inseridas ou removidas
+    bool refitted;                          // houve reajuste desde a ltima avaliao
+    float maxDegradation;                   // razo de custo que dispara a reconstruo
+    BvhStats stats;                         // estatsticas da rvore
+
+    void Split(uint node, uint depth);      // divide um n com binned SAH
+    bool Enclose(uint node);                // recalcula a caixa do n a partir do contedo
+    float Cost() const;                     // custo SAH relativo  caixa da raiz
+
+public:
+    Bvh(float degradation = 1.5f);
+
+    uint Add(const Bounds & bounds);                // insere primitiva e retorna seu ndice
+    void Remove(uint index);                        // a ltima primitiva ocupa o lugar da removida
+    void Set(uint index, const Bounds & bounds);    // move uma primitiva (refit incremental)
+    void Clear();                                   // remove todas as primitivas
+
+    void Build();                                   // reconstri a rvore inteira
+    bool Update();                                  // reconstri se necessrio; retorna true se reconstruiu
+
+    // percorre as caixas cruzadas por origem + t * direo, t em [0, maxT); hit testa
+    // uma primitiva e devolve o t da interseo ou o maxT recebido se no houver
+    float Raycast(const float * origin, const float * direction, float maxT,
+                  const function<float(uint, float)> & hit) const;
+
+    const vector<BvhNode> & Nodes() const;          // ns para percorrer a rvore
+    const vector<uint> & Indices() const;           // primitivas referenciadas pelas folhas
+    void Primitive(uint index, float * min, float * max) const;  // caixa de uma primitiva
+    uint Size() const;                              // nmero de primitivas
+    BvhStats Stats() const;                         // estatsticas da rvore
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline const vector<BvhNode> & Bvh::Nodes() const
+{ return nodes; }
+
+inline const vector<uint> & Bvh::Indices() const
+{ return indices; }
+
+inline uint Bvh::Size() const
+{ return uint(boxes.size()); }
+
+inline BvhStats Bvh::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,33 @@
+/**********************************************************************************
+// Camera (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Define uma vista da cena: cmera, projeo e regio da tela
+//
+**********************************************************************************/
+
+#ifndef DXUT_CAMERA_H_
+#define DXUT_CAMERA_H_
+
+#include "Types.h"
+#include <d3d12.h>
+#include <DirectXMath.h>
+using DirectX::XMFLOAT4X4;
+
+struct Camera
+{
+	XMFLOAT4X4 view = {             // matriz da cmera
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f };
+
+	XMFLOAT4X4 proj = view;         // matriz de projeo
+	XMFLOAT4X4 viewProj = view;     // view x proj do quadro atual
+	D3D12_VIEWPORT viewport {};     // regio da tela ocupada pela vista
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**********************************************************************************
+// CommandStream (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Fluxo de comandos de renderizao independente da API grfica.
+//              A aplicao grava registros de tamanho fixo (32 bytes) em um
+//              vetor contguo: associaes de pipeline, buffers e constantes,
+//              viewports e desenhos. Um CommandBackend consome o fluxo, seja
+//              traduzindo-o para uma lista de comandos do Direct3D, seja no
+//              NullBackend, que apenas conta e valida os comandos e permite
+//              medir a lgica de submisso sem GPU. Recursos so guardados
+//              como inteiros de 64 bits (ponteiros ou endereos da GPU).
+//
+**********************************************************************************/
+
+#include "CommandStream.h"
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Pipeline(ullong pso)
+{
+    Next(CMD_PIPELINE).handle = pso;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::RootSignature(ullong signature)
+{
+    Next(CMD_ROOTSIGNATURE).handle = signature;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Topology(uint topology)
+{
+    Next(CMD_TOPOLOGY, topology).handle = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Viewport(float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+    RenderCommand & cmd = Next(CMD_VIEWPORT);
+    cmd.viewport.x = x;
+    cmd.viewport.y = y;
+    cmd.viewport.width = width;
+    cmd.viewport.height = height;
+    cmd.viewport.minDepth = minDepth;
+    cmd.viewport.maxDepth = maxDepth;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Constants(uint slot, ullong address)
+{
+    Next(CMD_CONSTANTS, slot).handle = address;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Table(uint slot, ullong descriptor)
+{
+    Next(CMD_TABLE, slot).handle = descriptor;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::VertexBuffer(ullong address, uint size, uint stride)
+{
+    RenderCommand & cmd = Next(CMD_VERTEXBUFFER);
+    cmd.buffer.address = address;
+    cmd.buffer.size = size;
+    cmd.buffer.stride = stride;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::IndexBuffer(ullong address, uint size, uint indexSize)
+{
+    RenderCommand & cmd = Next(CMD_INDEXBUFFER);
+    cmd.buffer.address = address;
+    cmd.buffer.size = size;
+    cmd.buffer.stride = indexSize;
+}
+
+// -------------------------------------------------------------------------------
+
+void CommandStream::Draw(uint indexCount, uint startIndex, int baseVertex, uint instanceCount)
+{
+    RenderCommand & cmd = Next(CMD_DRAW);
+    cmd.draw.indexCount = indexCount;
+    cmd.draw.startIndex = startIndex;
+    cmd.draw.baseVertex = baseVertex;
+    cmd.draw.instanceCount = instanceCount;
+}
+
+// -------------------------------------------------------------------------------
+// NullBackend
+// -------------------------------------------------------------------------------
+
+void NullBackend::Execute(const CommandStream & stream)
+{
+    const RenderCommand * cmd = stream.Data();
+    const RenderCommand * end = cmd + stream.Size();
+
+    for (; cmd != end; ++cmd)
+    {
+        ++stats.commands;
+
+        if (cmd->type >= CMD_COUNT)
+        {
+            ++stats.errors;
+            continue;
+        }
+
+        ++stats.counts[cmd->type];
+        bool valid = true;
+
+        switch (cmd->type)
+        {
+        case CMD_TOPOLOGY:
+            break;
+
+        case CMD_VIEWPORT:
+            valid = cmd->viewport.width > 0.0f && cmd->viewport.height > 0.0f
+                 && cmd->viewport.minDepth <= cmd->viewport.maxDepth;
+            break;
+
+        case CMD_VERTEXBUFFER:
+            valid = cmd->buffer.address && cmd->buffer.stride && cmd->buffer.size >= cmd->buffer.stride;
+            break;
+
+        case CMD_INDEXBUFFER:
+            valid = cmd->buffer.address && (cmd->buffer.stride == 2 || cmd->buffer.stride == 4);
+            indexBytes = cmd->buffer.size;
+            indexSize = cmd->buffer.stride;
+            break;
+
+        case CMD_DRAW:
+        {
+            // pipeline, assinatura, topologia, viewport, constantes e buffers
+            // precisam ter sido definidos antes, neste ou em fluxos anteriores
+            for (uint state = 0; state < CMD_DRAW; ++state)
+                valid &= defined[state];
+
+            // os ndices lidos precisam estar dentro do index buffer
+            ullong last = ullong(cmd->draw.startIndex) + cmd->draw.indexCount;
+            valid &= cmd->draw.indexCount > 0 && cmd->draw.instanceCount > 0 && last * indexSize <= indexBytes;
+
+            ++stats.draws;
+            stats.indices += ullong(cmd->draw.indexCount) * cmd->draw.instanceCount;
+            break;
+        }
+
+        default:
+            valid = cmd->handle != 0;
+        }
+
+        if (valid && cmd->type < CMD_DRAW)
+            defined[cmd->type] = true;
+
+        if (!valid)
+            ++stats.errors;
+    }
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,156 @@
+/**********************************************************************************
+// CommandStream (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Fluxo de comandos de renderizao independente da API grfica.
+//              A aplicao grava registros de tamanho fixo (32 bytes) em um
+//              vetor contguo: associaes de pipeline, buffers e constantes,
+//              viewports e desenhos. Um CommandBackend consome o fluxo, seja
+//              traduzindo-o para uma lista de comandos do Direct3D, seja no
+//              NullBackend, que apenas conta e valida os comandos e permite
+//              medir a lgica de submisso sem GPU. Recursos so guardados
+//              como inteiros de 64 bits (ponteiros ou endereos da GPU).
+//
+**********************************************************************************/
+
+#ifndef DXUT_COMMANDSTREAM_H_
+#define DXUT_COMMANDSTREAM_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// tipos de comando do fluxo
+enum CommandType
+{
+    CMD_PIPELINE,                           // estado do pipeline
+    CMD_ROOTSIGNATURE,                      // assinatura raiz
+    CMD_TOPOLOGY,                           // topologia das primitivas
+    CMD_VIEWPORT,                           // viewport
+    CMD_CONSTANTS,                          // buffer constante em um parmetro raiz
+    CMD_TABLE,                              // tabela de descritores em um parmetro raiz
+    CMD_VERTEXBUFFER,                       // vertex buffer
+    CMD_INDEXBUFFER,                        // index buffer
+    CMD_DRAW,                               // desenho indexado
+    CMD_COUNT
+};
+
+// -------------------------------------------------------------------------------
+
+struct RenderCommand
+{
+    uint type;                              // tipo do comando
+    uint slot;                              // parmetro raiz ou topologia
+
+    union
+    {
+        ullong handle;                                              // pipeline, assinatura, constantes ou tabela
+        struct { ullong address; uint size; uint stride; } buffer;  // vrtices (stride) ou ndices (bytes por ndice)
+        struct { float x, y, width, height, minDepth, maxDepth; } viewport;
+        struct { uint indexCount, startIndex; int baseVertex; uint instanceCount; } draw;
+    };
+};
+
+// -------------------------------------------------------------------------------
+
+class CommandStream
+{
+private:
+    vector<RenderCommand> commands;         // comandos na ordem de gravao
+
+    RenderCommand & Next(uint type, uint slot = 0);
+
+public:
+    void Clear();                                                   // descarta os comandos gravados
+
+    void Pipeline(ullong pso);                                      // define o pipeline
+    void RootSignature(ullong signature);                           // define a assinatura raiz
+    void Topology(uint topology);                                   // define a topologia
+    void Viewport(float x, float y, float width, float height,
+                  float minDepth = 0.0f, float maxDepth = 1.0f);    // define a viewport
+    void Constants(uint slot, ullong address);                      // buffer constante no parmetro raiz
+    void Table(uint slot, ullong descriptor);                       // tabela de descritores no parmetro raiz
+    void VertexBuffer(ullong address, uint size, uint stride);      // define os vrtices
+    void IndexBuffer(ullong address, uint size, uint indexSize);    // define os ndices (2 ou 4 bytes)
+    void Draw(uint indexCount, uint startIndex = 0,
+              int baseVertex = 0, uint instanceCount = 1);          // desenha com os estados atuais
+
+    const RenderCommand * Data() const;     // comandos gravados
+    uint Size() const;                      // nmero de comandos
+};
+
+// -------------------------------------------------------------------------------
+// CommandBackend
+// -------------------------------------------------------------------------------
+
+class CommandBackend
+{
+public:
+    virtual ~CommandBackend() {}
+    virtual void Execute(const CommandStream & stream) = 0;         // executa os comandos do fluxo
+};
+
+// -------------------------------------------------------------------------------
+// NullBackend: conta e valida os comandos sem dispositivo
+// -------------------------------------------------------------------------------
+
+struct CommandStats
+{
+    uint   commands = 0;                    // comandos executados
+    uint   draws = 0;                       // desenhos
+    ullong indices = 0;                     // ndices desenhados (todas as instncias)
+    uint   counts[CMD_COUNT] = {};          // comandos de cada tipo
+    uint   errors = 0;                      // comandos invlidos
+};
+
+class NullBackend : public CommandBackend
+{
+private:
+    CommandStats stats;                     // contagens acumuladas
+    bool defined[CMD_DRAW] = {};            // estados j definidos na lista
+    uint indexBytes = 0;                    // tamanho do index buffer atual
+    uint indexSize = 0;                     // bytes por ndice do index buffer atual
+
+public:
+    void Execute(const CommandStream & stream);     // estados persistem entre fluxos da mesma lista
+    void Reset();                           // zera as contagens e os estados (nova lista)
+    CommandStats Stats() const;             // contagens desde o ltimo Reset
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline RenderCommand & CommandStream::Next(uint type, uint slot)
+{
+    commands.emplace_back();
+    RenderCommand & cmd = commands.back();
+    cmd.type = type;
+    cmd.slot = slot;
+    return cmd;
+}
+
+inline void CommandStream::Clear()
+{ commands.clear(); }
+
+inline const RenderCommand * CommandStream::Data() const
+{ return commands.data(); }
+
+inline uint CommandStream::Size() const
+{ return uint(commands.size()); }
+
+inline void NullBackend::Reset()
+{ *this = NullBackend(); }
+
+inline CommandStats NullBackend::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,492 @@
+/**********************************************************************************
+// Culling (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Descarte de objetos fora do volume de viso. Os volumes
+//              envolventes dos objetos (esfera e caixa alinhada aos eixos, no
+//              espao do mundo) ficam em estrutura de vetores e so testados
+//              contra os planos de todas as vistas ativas em uma nica passada
+//              SSE, 4 objetos por vez. Cada vista recebe sua lista de objetos
+//              visveis. Cenas grandes podem ser percorridas por uma BVH,
+//              testando cada n contra at 4 vistas de uma vez.
+//
+**********************************************************************************/
+
+#include "Culling.h"
+#include "Bvh.h"
+#include <cmath>
+#include <immintrin.h>
+
+// -------------------------------------------------------------------------------
+
+Bounds Bounds::FromPoints(const void * points, uint count, uint stride)
+{
+    Bounds b;
+
+    if (count == 0)
+        return b;
+
+    const byte * src = (const byte *) points;
+    float lo[3], hi[3];
+
+    for (uint k = 0; k < 3; ++k)
+        lo[k] = hi[k] = ((const float *) src)[k];
+
+    for (uint i = 1; i < count; ++i)
+    {
+        const float * p = (const float *) (src + ullong(i) * stride);
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            if (p[k] < lo[k]) lo[k] = p[k];
+            if (p[k] > hi[k]) hi[k] = p[k];
+        }
+    }
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        b.center[k] = (lo[k] + hi[k]) * 0.5f;
+        b.extents[k] = (hi[k] - lo[k]) * 0.5f;
+    }
+
+    // esfera centrada na caixa, com o ponto mais distante na borda
+    float r2 = 0;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        const float * p = (const float *) (src + ullong(i) * stride);
+        float dx = p[0] - b.center[0];
+        float dy = p[1] - b.center[1];
+        float dz = p[2] - b.center[2];
+        float d2 = dx * dx + dy * dy + dz * dz;
+
+        if (d2 > r2)
+            r2 = d2;
+    }
+
+    b.radius = sqrtf(r2);
+    return b;
+}
+
+// -------------------------------------------------------------------------------
+
+Bounds Bounds::Transform(const float * m) const
+{
+    Bounds b;
+
+    // centro transformado como ponto (vetor linha vezes matriz)
+    for (uint c = 0; c < 3; ++c)
+    {
+        b.center[c] = center[0] * m[c] + center[1] * m[4 + c] + center[2] * m[8 + c] + m[12 + c];
+
+        // a caixa transformada  envolvida por outra alinhada aos eixos
+        b.extents[c] = extents[0] * fabsf(m[c]) + extents[1] * fabsf(m[4 + c]) + extents[2] * fabsf(m[8 + c]);
+    }
+
+    // o raio cresce com o maior fator de escala da matriz
+    float scale = 0;
+
+    for (uint r = 0; r < 3; ++r)
+    {
+        float s = m[r * 4] * m[r * 4] + m[r * 4 + 1] * m[r * 4 + 1] + m[r * 4 + 2] * m[r * 4 + 2];
+
+        if (s > scale)
+            scale = s;
+    }
+
+    b.radius = radius * sqrtf(scale);
+    return b;
+}
+
+// -------------------------------------------------------------------------------
+
+FrustumCuller::FrustumCuller() : count(0)
+{
+    for (uint v = 0; v < MaxViews; ++v)
+        for (uint p = 0; p < 6; ++p)
+            for (uint k = 0; k < 4; ++k)
+                planes[v][p][k] = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+uint FrustumCuller::Add(const Bounds & b)
+{
+    cx.push_back(b.center[0]);
+    cy.push_back(b.center[1]);
+    cz.push_back(b.center[2]);
+    ex.push_back(b.extents[0]);
+    ey.push_back(b.extents[1]);
+    ez.push_back(b.extents[2]);
+    radius.push_back(b.radius);
+
+    return count++;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::Remove(uint index)
+{
+    if (index >= count)
+        return;
+
+    vector<float> * arrays[] = { &cx, &cy, &cz, &ex, &ey, &ez, &radius };
+
+    // o ltimo volume ocupa o lugar do removido
+    for (auto a : arrays)
+    {
+        (*a)[index] = a->back();
+        a->pop_back();
+    }
+
+    --count;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::Set(uint index, const Bounds & b)
+{
+    cx[index] = b.center[0];
+    cy[index] = b.center[1];
+    cz[index] = b.center[2];
+    ex[index] = b.extents[0];
+    ey[index] = b.extents[1];
+    ez[index] = b.extents[2];
+    radius[index] = b.radius;
+}
+
+// -------------------------------------------------------------------------------
+
+Bounds FrustumCuller::Get(uint index) const
+{
+    Bounds b;
+    b.center[0] = cx[index];
+    b.center[1] = cy[index];
+    b.center[2] = cz[index];
+    b.extents[0] = ex[index];
+    b.extents[1] = ey[index];
+    b.extents[2] = ez[index];
+    b.radius = radius[index];
+    return b;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::Clear()
+{
+    vector<float> * arrays[] = { &cx, &cy, &cz, &ex, &ey, &ez, &radius };
+
+    for (auto a : arrays)
+        a->clear();
+
+    count = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::View(uint view, const float * m)
+{
+    // coluna j da matriz: coeficientes de x, y, z e w na coordenada de recorte j
+    auto column = [m](uint j, float sign, float * out)
+    {
+        for (uint r = 0; r < 4; ++r)
+            out[r] = m[r * 4 + 3] + sign * m[r * 4 + j];
+    };
+
+    float (&p)[6][4] = planes[view];
+
+    column(0, 1.0f, p[0]);                  // esquerda: w + x >= 0
+    column(0, -1.0f, p[1]);                 // direita:  w - x >= 0
+    column(1, 1.0f, p[2]);                  // baixo:    w + y >= 0
+    column(1, -1.0f, p[3]);                 // cima:     w - y >= 0
+    column(2, -1.0f, p[5]);                 // longe:    w - z >= 0
+
+    // perto: z >= 0 (profundidade do Direct3D vai de 0 a w)
+    for (uint r = 0; r < 4; ++r)
+        p[4][r] = m[r * 4 + 2];
+
+    // planos normalizados para que as distncias sejam comparveis aos raios
+    for (uint i = 0; i < 6; ++i)
+    {
+        float len = sqrtf(p[i][0] * p[i][0] + p[i][1] * p[i][1] + p[i][2] * p[i][2]);
+
+        if (len > 0)
+            for (uint k = 0; k < 4; ++k)
+                p[i][k] /= len;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+uint FrustumCuller::Views(uint viewMask, uint * views)
+{
+    uint viewCount = 0;
+
+    for (uint v = 0; v < MaxViews; ++v)
+    {
+        if (viewMask & (1u << v))
+        {
+            views[viewCount++] = v;
+            visible[v].clear();
+            stats[v].tested = 0;
+            stats[v].culled = 0;
+        }
+    }
+
+    return viewCount;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::Cull(uint viewMask)
+{
+    uint views[MaxViews];
+    uint viewCount = Views(viewMask, views);
+
+    if (viewCount == 0)
+        return;
+
+    // coeficientes dos planos replicados nos 4 canais, mais os valores
+    // absolutos das normais usados no teste da caixa
+    __m128 plane[MaxViews][6][4];
+    __m128 absNormal[MaxViews][6][3];
+
+    for (uint i = 0; i < viewCount; ++i)
+        for (uint p = 0; p < 6; ++p)
+        {
+            for (uint k = 0; k < 4; ++k)
+                plane[i][p][k] = _mm_set1_ps(planes[views[i]][p][k]);
+
+            for (uint k = 0; k < 3; ++k)
+                absNormal[i][p][k] = _mm_set1_ps(fabsf(planes[views[i]][p][k]));
+        }
+
+    const __m128 zero = _mm_setzero_ps();
+    uint n = 0;
+
+    // uma passada pelos volumes: cada bloco de 4  testado em todas as vistas
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 x = _mm_loadu_ps(&cx[n]);
+        __m128 y = _mm_loadu_ps(&cy[n]);
+        __m128 z = _mm_loadu_ps(&cz[n]);
+        __m128 bx = _mm_loadu_ps(&ex[n]);
+        __m128 by = _mm_loadu_ps(&ey[n]);
+        __m128 bz = _mm_loadu_ps(&ez[n]);
+        __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(&radius[n]));
+
+        for (uint i = 0; i < viewCount; ++i)
+        {
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (uint p = 0; p < 6; ++p)
+            {
+                // distncia assinada do centro ao plano
+                __m128 d = _mm_add_ps(_mm_mul_ps(x, plane[i][p][0]), plane[i][p][3]);
+                d = _mm_add_ps(d, _mm_mul_ps(y, plane[i][p][1]));
+                d = _mm_add_ps(d, _mm_mul_ps(z, plane[i][p][2]));
+
+                // projeo da caixa sobre a normal do plano
+                __m128 e = _mm_mul_ps(bx, absNormal[i][p][0]);
+                e = _mm_add_ps(e, _mm_mul_ps(by, absNormal[i][p][1]));
+                e = _mm_add_ps(e, _mm_mul_ps(bz, absNormal[i][p][2]));
+
+                // fora se a esfera ou a caixa estiver toda atrs do plano
+                __m128 sphere = _mm_cmpge_ps(d, negRadius);
+                __m128 box = _mm_cmpge_ps(_mm_add_ps(d, e), zero);
+                inside = _mm_and_ps(inside, _mm_and_ps(sphere, box));
+
+            }
+
+            int bits = _mm_movemask_ps(inside);
+            vector<uint> & list = visible[views[i]];
+
+            for (uint k = 0; k < 4; ++k)
+                if (bits & (1 << k))
+                    list.push_back(n + k);
+        }
+    }
+
+    // volumes restantes
+    for (; n < count; ++n)
+    {
+        for (uint i = 0; i < viewCount; ++i)
+        {
+            bool inside = true;
+
+            for (uint p = 0; p < 6 && inside; ++p)
+            {
+                const float * pl = planes[views[i]][p];
+                float d = cx[n] * pl[0] + cy[n] * pl[1] + cz[n] * pl[2] + pl[3];
+                float e = ex[n] * fabsf(pl[0]) + ey[n] * fabsf(pl[1]) + ez[n] * fabsf(pl[2]);
+                inside = d >= -radius[n] && d + e >= 0;
+            }
+
+            if (inside)
+                visible[views[i]].push_back(n);
+        }
+    }
+
+    for (uint i = 0; i < viewCount; ++i)
+    {
+        stats[views[i]].tested = count;
+        stats[views[i]].culled = count - uint(visible[views[i]].size());
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void FrustumCuller::Cull(uint viewMask, const Bvh & bvh)
+{
+    uint views[MaxViews];
+    uint viewCount = Views(viewMask, views);
+
+    const vector<BvhNode> & nodes = bvh.Nodes();
+    const vector<uint> & indices = bvh.Indices();
+
+    if (viewCount == 0 || nodes.empty())
+        return;
+
+    // at 4 vistas por percurso: cada canal do registrador  uma vista
+    for (uint group = 0; group < viewCount; group += 4)
+    {
+        uint lanes = viewCount - group < 4 ? viewCount - group : 4;
+        uint * laneView = views + group;
+
+        // coeficientes de cada plano nas vistas do grupo; canais sem
+        // vista recebem um plano que aceita tudo e ficam fora da mscara
+        __m128 pa[6], pb[6], pc[6], pd[6], aa[6], ab[6], ac[6];
+
+        for (uint p = 0; p < 6; ++p)
+        {
+            float k[4][4] = {};
+
+            for (uint l = 0; l < lanes; ++l)
+                for (uint j = 0; j < 4; ++j)
+                    k[j][l] = planes[laneView[l]][p][j];
+
+            pa[p] = _mm_loadu_ps(k[0]);
+            pb[p] = _mm_loadu_ps(k[1]);
+            pc[p] = _mm_loadu_ps(k[2]);
+            pd[p] = _mm_loadu_ps(k[3]);
+
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            aa[p] = _mm_and_ps(pa[p], absMask);
+            ab[p] = _mm_and_ps(pb[p], absMask);
+            ac[p] = _mm_and_ps(pc[p], absMask);
+        }
+
+        // classifica uma caixa nas vistas do grupo: retorna os canais em
+        // que ela cruza ou est dentro e, em inside, os totalmente dentro
+        auto classify = [&](const float * min, const float * max, int & inside)
+        {
+            __m128 x = _mm_set1_ps((min[0] + max[0]) * 0.5f);
+            __m128 y = _mm_set1_ps((min[1] + max[1]) * 0.5f);
+            __m128 z = _mm_set1_ps((min[2] + max[2]) * 0.5f);
+            __m128 ex = _mm_set1_ps((max[0] - min[0]) * 0.5f);
+            __m128 ey = _mm_set1_ps((max[1] - min[1]) * 0.5f);
+            __m128 ez = _mm_set1_ps((max[2] - min[2]) * 0.5f);
+            __m128 zero = _mm_setzero_ps();
+            __m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            __m128 all = in;
+
+            for (uint p = 0; p < 6; ++p)
+            {
+                __m128 d = _mm_add_ps(_mm_mul_ps(x, pa[p]), pd[p]);
+                d = _mm_add_ps(d, _mm_mul_ps(y, pb[p]));
+                d = _mm_add_ps(d, _mm_mul_ps(z, pc[p]));
+
+                __m128 e = _mm_mul_ps(ex, aa[p]);
+                e = _mm_add_ps(e, _mm_mul_ps(ey, ab[p]));
+                e = _mm_add_ps(e, _mm_mul_ps(ez, ac[p]));
+
+                in = _mm_and_ps(in, _mm_cmpge_ps(_mm_add_ps(d, e), zero));
+                all = _mm_and_ps(all, _mm_cmpge_ps(_mm_sub_ps(d, e), zero));
+            }
+
+            inside = _mm_movemask_ps(all);
+            return _mm_movemask_ps(in);
+        };
+
+        // cada entrada da pilha: n, vistas a testar e vistas j aceitas
+        int laneMask = (1 << lanes) - 1;
+        stack.clear();
+        stack.push_back(0);
+        stack.push_back(uint(laneMask));
+
+        while (!stack.empty())
+        {
+            uint entry = stack.back(); stack.pop_back();
+            uint node = stack.back(); stack.pop_back();
+            int test = int(entry & 0xf);
+            int accept = int(entry >> 4);
+
+            const BvhNode & n = nodes[node];
+
+            if (test)
+            {
+                int inside;
+                int hit = classify(n.min, n.max, inside) & test;
+
+                // vistas que contm o n inteiro aceitam toda a subrvore
+                accept |= hit & inside;
+                test = hit & ~inside;
+            }
+
+            if (!test && !accept)
+                continue;
+
+            if (!n.Leaf())
+            {
+                uint masks = uint(test) | uint(accept) << 4;
+                stack.push_back(n.first + 1);
+                stack.push_back(masks);
+                stack.push_back(n.first);
+                stack.push_back(masks);
+                continue;
+            }
+
+            for (uint i = 0; i < n.count; ++i)
+            {
+                uint prim = indices[n.first + i];
+                int keep = accept;
+
+                if (test)
+                {
+                    // o objeto passa pelo mesmo teste de esfera e caixa da passada linear
+                    for (uint l = 0; l < lanes; ++l)
+                    {
+                        if (!(test & (1 << l)) || prim >= count)
+                            continue;
+
+                        ++stats[laneView[l]].tested;
+                        bool in = true;
+
+                        for (uint p = 0; p < 6 && in; ++p)
+                        {
+                            const float * pl = planes[laneView[l]][p];
+                            float d = cx[prim] * pl[0] + cy[prim] * pl[1] + cz[prim] * pl[2] + pl[3];
+                            float e = ex[prim] * fabsf(pl[0]) + ey[prim] * fabsf(pl[1]) + ez[prim] * fabsf(pl[2]);
+                            in = d >= -radius[prim] && d + e >= 0;
+                        }
+
+                        if (in)
+                            keep |= 1 << l;
+                    }
+                }
+
+                for (uint l = 0; l < lanes; ++l)
+                    if (keep & (1 << l))
+                        visible[laneView[l]].push_back(prim);
+            }
+        }
+    }
+
+    for (uint i = 0; i < viewCount; ++i)
+        stats[views[i]].culled = count - uint(visible[views[i]].size());
+}
+
+// -------------------------------------------------------------------------------
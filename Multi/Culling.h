@@ -0,0 +1,104 @@
+/**********************************************************************************
+// Culling (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Descarte de objetos fora do volume de viso. Os volumes
+//              envolventes dos objetos (esfera e caixa alinhada aos eixos, no
+//              espao do mundo) ficam em estrutura de vetores e so testados
+//              contra os planos de todas as vistas ativas em uma nica passada
+//              SSE, 4 objetos por vez. Cada vista recebe sua lista de objetos
+//              visveis. Cenas grandes podem ser percorridas por uma BVH,
+//              testando cada n contra at 4 vistas de uma vez.
+//
+**********************************************************************************/
+
+#ifndef DXUT_CULLING_H_
+#define DXUT_CULLING_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+class Bvh;
+
+// -------------------------------------------------------------------------------
+
+struct Bounds
+{
+    float center[3] = { 0, 0, 0 };          // centro da caixa e da esfera
+    float extents[3] = { 0, 0, 0 };         // meia dimenso da caixa em cada eixo
+    float radius = 0;                       // raio da esfera
+
+    // volume que envolve count pontos separados por stride bytes
+    static Bounds FromPoints(const void * points, uint count, uint stride);
+
+    // volume no espao do mundo de um volume local transformado por world
+    Bounds Transform(const float * world) const;
+};
+
+// -------------------------------------------------------------------------------
+
+struct CullStats
+{
+    uint tested = 0;                        // objetos testados na vista
+    uint culled = 0;                        // objetos descartados na vista
+};
+
+// -------------------------------------------------------------------------------
+
+class FrustumCuller
+{
+public:
+    static const uint MaxViews = 8;         // vistas testadas na mesma passada
+
+private:
+    vector<float> cx, cy, cz;               // centros dos volumes
+    vector<float> ex, ey, ez;               // meias dimenses das caixas
+    vector<float> radius;                   // raios das esferas
+    uint count;                             // nmero de volumes
+
+    float planes[MaxViews][6][4];           // planos normalizados (a, b, c, d) de cada vista
+    vector<uint> visible[MaxViews];         // ndices visveis em cada vista
+    CullStats stats[MaxViews];              // estatsticas da ltima passada
+    vector<uint> stack;                     // pilha do percurso da hierarquia
+
+    uint Views(uint viewMask, uint * views);        // reinicia as listas das vistas da mscara
+
+public:
+    FrustumCuller();
+
+    uint Add(const Bounds & bounds);                // insere no final e retorna o ndice
+    void Remove(uint index);                        // remove em O(1): o ltimo ocupa o lugar
+    void Set(uint index, const Bounds & bounds);    // substitui um volume
+    Bounds Get(uint index) const;                   // volume no espao do mundo
+    void Clear();                                   // remove todos os volumes
+
+    void View(uint view, const float * viewProj);   // extrai os planos da vista
+    void Cull(uint viewMask);                       // testa os volumes contra as vistas da mscara
+    void Cull(uint viewMask, const Bvh & bvh);      // percorre a hierarquia em vez de todos os volumes
+
+    const vector<uint> & Visible(uint view) const;  // objetos visveis na vista
+    CullStats Stats(uint view) const;               // estatsticas da vista
+    uint Size() const;                              // nmero de volumes
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline const vector<uint> & FrustumCuller::Visible(uint view) const
+{ return visible[view]; }
+
+inline CullStats FrustumCuller::Stats(uint view) const
+{ return stats[view]; }
+
+inline uint FrustumCuller::Size() const
+{ return count; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -23,6 +23,26 @@
 #include "Mesh.h"
 #include "Geometry.h"
 #include "Object.h"
+#include "Camera.h"
+#include "Tessellation.h"
+#include "Allocator.h"
+#include "Ring.h"
+#include "Descriptors.h"
+#include "Frames.h"
+#include "Shaders.h"
+#include "Pipeline.h"
+#include "Lines.h"
+#include "Culling.h"
+#include "Bvh.h"
+#include "Picking.h"
+#include "Occlusion.h"
+#include "SceneGraph.h"
+#include "SlotMap.h"
+#include "RenderQueue.h"
+#include "CommandStream.h"
+#include "Jobs.h"
+#include "Recorder.h"
+#include "Handoff.h"
 
 // Cabealhos do DirectX 
 #include <D3DCompiler.h>
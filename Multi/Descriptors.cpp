@@ -0,0 +1,148 @@
+/**********************************************************************************
+// Descriptors (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Distribui os ndices de uma heap de descritores nica. A heap 
+//              dividida em uma regio persistente, com lista de intervalos
+//              livres, e uma regio linear reiniciada a cada quadro.
+//
+**********************************************************************************/
+
+#include "Descriptors.h"
+
+// -------------------------------------------------------------------------------
+
+DescriptorAllocator::DescriptorAllocator(uint persistentCount, uint frameDescriptors, uint frames)
+{
+    persistent = persistentCount;
+    frameSize = frameDescriptors;
+    frameCount = frames;
+    capacity = persistent + frameSize * frameCount;
+    frame = 0;
+    frameOffset = 0;
+
+    // a regio persistente comea como um nico intervalo livre
+    if (persistent > 0)
+        freeRanges.push_back({ 0, persistent });
+
+    stats.capacity = capacity;
+    stats.persistentFree = persistent;
+    stats.largestFree = persistent;
+}
+
+// -------------------------------------------------------------------------------
+
+uint DescriptorAllocator::Allocate(uint count)
+{
+    // primeiro intervalo com espao suficiente (first-fit)
+    for (uint i = 0; i < freeRanges.size(); ++i)
+    {
+        Range & range = freeRanges[i];
+
+        if (range.count >= count)
+        {
+            uint index = range.start;
+            bool largest = (range.count == stats.largestFree);
+
+            range.start += count;
+            range.count -= count;
+
+            if (range.count == 0)
+                freeRanges.erase(freeRanges.begin() + i);
+
+            stats.persistentUsed += count;
+            stats.persistentFree -= count;
+
+            // o maior intervalo s precisa ser recalculado se foi o usado
+            if (largest)
+            {
+                stats.largestFree = 0;
+                for (auto & r : freeRanges)
+                    if (r.count > stats.largestFree)
+                        stats.largestFree = r.count;
+            }
+
+            return index;
+        }
+    }
+
+    return Invalid;
+}
+
+// -------------------------------------------------------------------------------
+
+void DescriptorAllocator::Free(uint index, uint count)
+{
+    if (index == Invalid || count == 0)
+        return;
+
+    // posio de insero mantendo a lista ordenada
+    uint pos = 0;
+    while (pos < freeRanges.size() && freeRanges[pos].start < index)
+        ++pos;
+
+    freeRanges.insert(freeRanges.begin() + pos, { index, count });
+
+    // junta com o intervalo seguinte
+    if (pos + 1 < freeRanges.size() &&
+        freeRanges[pos].start + freeRanges[pos].count == freeRanges[pos + 1].start)
+    {
+        freeRanges[pos].count += freeRanges[pos + 1].count;
+        freeRanges.erase(freeRanges.begin() + pos + 1);
+    }
+
+    // junta com o intervalo anterior
+    if (pos > 0 &&
+        freeRanges[pos - 1].start + freeRanges[pos - 1].count == freeRanges[pos].start)
+    {
+        freeRanges[pos - 1].count += freeRanges[pos].count;
+        freeRanges.erase(freeRanges.begin() + pos);
+        --pos;
+    }
+
+    stats.persistentUsed -= count;
+    stats.persistentFree += count;
+
+    if (freeRanges[pos].count > stats.largestFree)
+        stats.largestFree = freeRanges[pos].count;
+}
+
+// -------------------------------------------------------------------------------
+
+uint DescriptorAllocator::AllocateFrame(uint count)
+{
+    if (frameOffset + count > frameSize)
+        return Invalid;
+
+    uint index = persistent + frame * frameSize + frameOffset;
+    frameOffset += count;
+
+    stats.frameUsed = frameOffset;
+    if (frameOffset > stats.framePeak)
+        stats.framePeak = frameOffset;
+
+    return index;
+}
+
+// -------------------------------------------------------------------------------
+
+void DescriptorAllocator::BeginFrame(uint frameIndex)
+{
+    // a regio s pode ser reiniciada depois que a GPU
+    // terminou o quadro que usou esses descritores
+    frame = frameCount ? frameIndex % frameCount : 0;
+    frameOffset = 0;
+    stats.frameUsed = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+DescriptorStats DescriptorAllocator::Stats() const
+{
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
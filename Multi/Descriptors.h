@@ -0,0 +1,78 @@
+/**********************************************************************************
+// Descriptors (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Distribui os ndices de uma heap de descritores nica. A heap 
+//              dividida em uma regio persistente, com lista de intervalos
+//              livres, e uma regio linear reiniciada a cada quadro.
+//
+**********************************************************************************/
+
+#ifndef DXUT_DESCRIPTORS_H_
+#define DXUT_DESCRIPTORS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct DescriptorStats
+{
+    uint capacity = 0;                      // total de descritores na heap
+    uint persistentUsed = 0;                // descritores persistentes em uso
+    uint persistentFree = 0;                // descritores persistentes livres
+    uint largestFree = 0;                   // maior intervalo persistente livre
+    uint frameUsed = 0;                     // descritores usados no quadro atual
+    uint framePeak = 0;                     // maior uso de um quadro
+};
+
+// -------------------------------------------------------------------------------
+
+class DescriptorAllocator
+{
+public:
+    static const uint Invalid = ~0u;        // falha na alocao
+
+private:
+    struct Range
+    {
+        uint start;                         // primeiro descritor livre
+        uint count;                         // nmero de descritores livres
+    };
+
+    uint capacity;                          // total de descritores
+    uint persistent;                        // tamanho da regio persistente
+    uint frameSize;                         // tamanho da regio de cada quadro
+    uint frameCount;                        // nmero de regies de quadro
+    uint frame;                             // regio de quadro em uso
+    uint frameOffset;                       // prximo descritor livre no quadro
+    vector<Range> freeRanges;               // intervalos livres ordenados por incio
+    DescriptorStats stats;                  // estatsticas de uso
+
+public:
+    DescriptorAllocator(uint persistentCount, uint frameDescriptors, uint frames = 1);
+
+    uint Allocate(uint count = 1);                  // reserva descritores persistentes
+    void Free(uint index, uint count = 1);          // devolve descritores persistentes
+    uint AllocateFrame(uint count = 1);             // reserva descritores vlidos s no quadro atual
+    void BeginFrame(uint frameIndex = 0);           // reinicia a regio do quadro
+
+    uint Capacity() const;                          // total de descritores
+    DescriptorStats Stats() const;                  // estatsticas de uso
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint DescriptorAllocator::Capacity() const
+{ return capacity; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -22,6 +22,10 @@ using std::stringstream;
 Graphics* Engine::graphics  = nullptr;	// dispositivo grfico
 Window*   Engine::window    = nullptr;	// janela da aplicao
 Input*    Engine::input     = nullptr;	// dispositivos de entrada
+JobSystem* Engine::jobs     = nullptr;	// threads de trabalho
+FrameHandoff* Engine::handoff = nullptr;	// entrega de quadros  renderizao
+bool      Engine::pipelined = false;	// Draw em thread prpria
+std::thread Engine::renderThread;		// thread de renderizao
 App*      Engine::app       = nullptr;	// apontadador da aplicao
 double    Engine::frameTime = 0.0;		// tempo do quadro atual
 bool      Engine::paused    = false;	// estado do motor
@@ -33,6 +37,8 @@ Engine::Engine()
 {
 	window = new Window();
 	graphics = new Graphics();
+	jobs = new JobSystem();
+	handoff = new FrameHandoff();
 }
 
 // -------------------------------------------------------------------------------
@@ -43,6 +49,8 @@ Engine::~Engine()
 	delete graphics;
 	delete input;
 	delete window;
+	delete jobs;
+	delete handoff;
 }
 
 // -----------------------------------------------------------------------------
@@ -93,9 +101,25 @@ double Engine::FrameTime()
 		text << std::fixed;			// sempre mostra a parte fracionria
 		text.precision(3);			// trs casas depois da vrgula
 
+		// a thread de renderizao pode estar usando os pools
+		std::lock_guard<std::mutex> lock(graphics->Mutex());
+
+		// uso dos pools de memria de vdeo e de upload
+		AllocStats gpuMem = graphics->MemoryStats(GPU);
+		AllocStats uploadMem = graphics->MemoryStats(UPLOAD);
+		RingStats ring = graphics->UploadStats();
+		FrameStats frames = graphics->FrameSyncStats();
+
 		text << window->Title().c_str() << "    "
 			<< "FPS: " << frameCount << "    "
-			<< "Frame Time: " << frameTime * 1000 << " (ms)";
+			<< "Frame Time: " << frameTime * 1000 << " (ms)    "
+			<< "GPU: " << gpuMem.bytesInUse / 1024 << "/" << gpuMem.capacity / 1024 << " KB ("
+			<< gpuMem.Fragmentation() * 100 << "% frag)    "
+			<< "Upload: " << uploadMem.bytesInUse / 1024 << "/" << uploadMem.capacity / 1024 << " KB ("
+			<< uploadMem.Fragmentation() * 100 << "% frag)    "
+			<< "Ring: " << ring.Occupancy() * 100 << "% (pico " << ring.peak / 1024 << " KB, "
+			<< ring.stalls << " esperas)    "
+			<< "Quadros em voo: " << Graphics::FrameCount << " (" << frames.waits << " esperas)";
 
 		SetWindowText(window->Id(), text.str().c_str());
 
@@ -145,16 +169,27 @@ int Engine::Loop()
 
 			// -----------------------------------------------
 
+			// a aplicao pode ligar ou desligar a renderizao em paralelo
+			Pipelining();
+
 			if (!paused)
 			{
 				// calcula o tempo do quadro
 				frameTime = FrameTime();
 
-				// atualizao da aplicao 
+				// atualizao da aplicao: com a renderizao em paralelo,
+				// espera apenas que a cpia do quadro anterior fique livre
+				handoff->BeginUpdate();
 				app->Update();
+				handoff->EndUpdate();
 
 				// desenho da aplicao
-				app->Draw();
+				if (!pipelined)
+				{
+					handoff->BeginRender();
+					app->Draw();
+					handoff->EndRender();
+				}
 			}
 			else
 			{
@@ -164,6 +199,10 @@ int Engine::Loop()
 
 	} while (msg.message != WM_QUIT);
 
+	// quadros j entregues so desenhados antes da finalizao
+	pipelined = false;
+	Pipelining();
+
 	// finalizao do aplicao
 	app->Finalize();	
 
@@ -173,6 +212,37 @@ int Engine::Loop()
 
 // -------------------------------------------------------------------------------
 
+void Engine::Pipelining()
+{
+	if (pipelined && !renderThread.joinable())
+	{
+		handoff->Start();
+		renderThread = std::thread(RenderLoop);
+	}
+	else if (!pipelined && renderThread.joinable())
+	{
+		handoff->Stop();
+		renderThread.join();
+	}
+}
+
+// -------------------------------------------------------------------------------
+
+void Engine::RenderLoop()
+{
+	// tarefas da renderizao ficam em uma fila prpria
+	jobs->Attach(0);
+
+	// desenha cada quadro entregue pela atualizao, na ordem
+	while (handoff->BeginRender())
+	{
+		app->Draw();
+		handoff->EndRender();
+	}
+}
+
+// -------------------------------------------------------------------------------
+
 LRESULT CALLBACK Engine::EngineProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	switch (msg)
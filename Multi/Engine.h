@@ -21,6 +21,8 @@
 #include "Input.h"						// dispositivo de entrada
 #include "Timer.h"						// medidor de tempo
 #include "App.h"						// aplicao grfica
+#include "Jobs.h"						// sistema de tarefas
+#include "Handoff.h"					// entrega de quadros entre threads
 
 // ---------------------------------------------------------------------------------
 
@@ -29,14 +31,20 @@ class Engine
 private:
 	static Timer timer;                 // medidor de tempo
 	static bool paused;                 // estado do aplicao
+	static std::thread renderThread;    // desenha enquanto o prximo quadro  atualizado
 
 	double FrameTime();                 // calcula o tempo do quadro
 	int Loop();                         // inicia lao principal do motor
+	static void RenderLoop();           // lao da thread de renderizao
+	static void Pipelining();           // inicia ou encerra a thread de renderizao
 
 public:
 	static Graphics* graphics;          // dispositivo grfico
 	static Window* window;              // janela da aplicao
 	static Input* input;                // entrada da aplicao
+	static JobSystem* jobs;             // threads de trabalho
+	static FrameHandoff* handoff;       // entrega de quadros  renderizao
+	static bool pipelined;              // Draw em thread prpria, um quadro atrs de Update
 	static App* app;                    // aplicao a ser executada
 	static double frameTime;            // tempo do quadro atual
 
@@ -0,0 +1,57 @@
+/**********************************************************************************
+// Frames (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Controle dos quadros em voo. Cada quadro guarda o valor da cerca
+//              sinalizada ao final de sua submisso e a CPU s espera a GPU
+//              quando tenta reutilizar os recursos de um quadro ainda no
+//              concludo. A cerca  acessada por um FenceBackend, que pode ser
+//              a fila do Direct3D ou uma implementao nula sem dispositivo.
+//
+**********************************************************************************/
+
+#include "Frames.h"
+
+// -------------------------------------------------------------------------------
+
+FrameSync::FrameSync(FenceBackend * fenceBackend, uint frames)
+    : fence(fenceBackend), count(frames ? frames : 1), index(0)
+{
+    frameFences.assign(count, 0);
+}
+
+// -------------------------------------------------------------------------------
+
+ullong FrameSync::EndFrame()
+{
+    // cerca que indica o fim do quadro atual na GPU
+    ullong value = fence->Signal();
+    frameFences[index] = value;
+    ++stats.frames;
+
+    // os recursos do prximo quadro s podem ser reutilizados
+    // depois que a GPU concluir o quadro que os usou por ltimo
+    index = (index + 1) % count;
+
+    if (frameFences[index] > fence->Completed())
+    {
+        ++stats.waits;
+        fence->Wait(frameFences[index]);
+    }
+
+    return value;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameSync::WaitIdle()
+{
+    for (ullong value : frameFences)
+        if (value > fence->Completed())
+            fence->Wait(value);
+}
+
+// -------------------------------------------------------------------------------
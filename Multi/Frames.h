@@ -0,0 +1,108 @@
+/**********************************************************************************
+// Frames (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Controle dos quadros em voo. Cada quadro guarda o valor da cerca
+//              sinalizada ao final de sua submisso e a CPU s espera a GPU
+//              quando tenta reutilizar os recursos de um quadro ainda no
+//              concludo. A cerca  acessada por um FenceBackend, que pode ser
+//              a fila do Direct3D ou uma implementao nula sem dispositivo.
+//
+**********************************************************************************/
+
+#ifndef DXUT_FRAMES_H_
+#define DXUT_FRAMES_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+// FenceBackend
+// -------------------------------------------------------------------------------
+
+class FenceBackend
+{
+public:
+    virtual ~FenceBackend() {}
+    virtual ullong Signal() = 0;            // insere cerca aps os comandos submetidos
+    virtual ullong Completed() = 0;         // ltimo valor atingido pela GPU
+    virtual void Wait(ullong value) = 0;    // espera a GPU atingir o valor
+};
+
+// -------------------------------------------------------------------------------
+// NullFence: simula uma GPU que conclui os quadros com atraso fixo
+// -------------------------------------------------------------------------------
+
+class NullFence : public FenceBackend
+{
+private:
+    ullong signaled = 0;                    // ltimo valor sinalizado
+    ullong completed = 0;                   // ltimo valor concludo
+    uint latency;                           // sinais pendentes mantidos pela "GPU"
+
+public:
+    NullFence(uint frames = 0) : latency(frames) {}
+
+    ullong Signal()
+    {
+        ++signaled;
+        if (signaled > completed + latency)
+            completed = signaled - latency;
+        return signaled;
+    }
+
+    ullong Completed() { return completed; }
+    void Wait(ullong value) { if (value > completed) completed = value; }
+};
+
+// -------------------------------------------------------------------------------
+// FrameSync
+// -------------------------------------------------------------------------------
+
+struct FrameStats
+{
+    ullong frames = 0;                      // quadros concludos pela CPU
+    uint   waits = 0;                       // vezes em que a CPU esperou a GPU
+};
+
+class FrameSync
+{
+private:
+    FenceBackend * fence;                   // cerca usada na sincronizao
+    uint count;                             // nmero de quadros em voo
+    uint index;                             // quadro em gravao pela CPU
+    vector<ullong> frameFences;             // cerca sinalizada por cada quadro
+    FrameStats stats;                       // estatsticas de sincronizao
+
+public:
+    FrameSync(FenceBackend * fenceBackend, uint frames);
+
+    ullong EndFrame();                      // sinaliza o quadro atual e avana para o prximo
+    void WaitIdle();                        // espera todos os quadros em voo
+
+    uint Index() const;                     // quadro atual
+    uint Count() const;                     // nmero de quadros em voo
+    FrameStats Stats() const;               // estatsticas de sincronizao
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint FrameSync::Index() const
+{ return index; }
+
+inline uint FrameSync::Count() const
+{ return count; }
+
+inline FrameStats FrameSync::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
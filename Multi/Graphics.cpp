@@ -38,6 +38,9 @@ Graphics::Graphics()
     commandQueue      = nullptr;
     commandList       = nullptr;
     commandListAlloc  = nullptr;
+
+    for (uint i = 0; i < FrameCount; ++i)
+        frameAllocs[i] = nullptr;
     
     // pipeline do Direct3D
     renderTargets     = new ID3D12Resource*[backBufferCount] {nullptr};
@@ -51,7 +54,43 @@ Graphics::Graphics()
     // sincronizao cpu/gpu
     fence = nullptr;
     fenceEvent = nullptr;
-    fenceValue = 0;
+    queueFence = nullptr;
+    frameSync = nullptr;
+    listBackend = nullptr;
+
+    // fila de cpia
+    copyQueue = nullptr;
+    copyList = nullptr;
+    copyAllocIndex = 0;
+    copyFence = nullptr;
+    copyEvent = nullptr;
+    copyQueueFence = nullptr;
+    copyOpen = false;
+    copyRequired = 0;
+    copyWaited = 0;
+
+    for (uint i = 0; i < FrameCount; ++i)
+    {
+        copyAllocs[i] = nullptr;
+        copyAllocFences[i] = 0;
+    }
+
+    // sub-alocao de memria
+    gpuBackend = nullptr;
+    uploadBackend = nullptr;
+    gpuPool = nullptr;
+    uploadPool = nullptr;
+
+    // upload
+    ringBuffer = nullptr;
+    uploadRing = nullptr;
+    releaseBudget = 16 * 1024 * 1024;
+
+    // descritores
+    descriptorHeap = nullptr;
+    descriptors = nullptr;
+    descriptorCount = 16384;
+    descriptorSize = 0;
 }
 
 // ------------------------------------------------------------------------------
@@ -61,6 +100,50 @@ Graphics::~Graphics()
     // espera GPU finalizar comandos na fila
     WaitCommandQueue();
 
+    // espera a fila de cpia
+    if (copyQueueFence)
+    {
+        if (copyOpen)
+            copyList->Close();
+
+        copyQueueFence->Wait(copyQueueFence->Signal());
+        delete copyQueueFence;
+    }
+
+    if (copyList)
+        copyList->Release();
+
+    for (uint i = 0; i < FrameCount; ++i)
+        if (copyAllocs[i])
+            copyAllocs[i]->Release();
+
+    if (copyFence)
+        copyFence->Release();
+
+    if (copyEvent)
+        CloseHandle(copyEvent);
+
+    if (copyQueue)
+        copyQueue->Release();
+
+    // libera buffer circular
+    if (ringBuffer)
+        uploadBackend->Destroy(ringBuffer);
+
+    delete uploadRing;
+
+    // libera heap global de descritores
+    if (descriptorHeap)
+        descriptorHeap->Release();
+
+    delete descriptors;
+
+    // libera heaps de memria
+    delete gpuPool;
+    delete uploadPool;
+    delete gpuBackend;
+    delete uploadBackend;
+
     // libera depth stencil buffer
     if (depthStencil)
         depthStencil->Release();
@@ -100,10 +183,19 @@ Graphics::~Graphics()
     if (commandList)
         commandList->Release();
 
-    // libera alocador de comandos
+    // libera alocadores de comandos
     if (commandListAlloc)
         commandListAlloc->Release();
 
+    for (uint i = 0; i < FrameCount; ++i)
+        if (frameAllocs[i])
+            frameAllocs[i]->Release();
+
+    // libera controle dos quadros em voo
+    delete listBackend;
+    delete frameSync;
+    delete queueFence;
+
     // libera fila de comandos
     if (commandQueue)
         commandQueue->Release();
@@ -292,6 +384,45 @@ void Graphics::Initialize(Window * window)
     LogHardwareInfo();
 #endif 
 
+    // ---------------------------------------------------
+    // Heaps de memria para buffers
+    // ---------------------------------------------------
+
+    // buffers de vrtices, ndices e constantes so sub-alocados em
+    // heaps de 16MB com blocos de no mnimo 256 bytes (alinhamento
+    // exigido pelos constant buffers), evitando um recurso comprometido
+    // (alinhado em 64KB) para cada buffer
+    gpuBackend = new BufferBackend(device, D3D12_HEAP_TYPE_DEFAULT);
+    uploadBackend = new BufferBackend(device, D3D12_HEAP_TYPE_UPLOAD);
+    gpuPool = new HeapPool(gpuBackend, 16 * 1048576ULL, 256);
+    uploadPool = new HeapPool(uploadBackend, 16 * 1048576ULL, 256);
+
+    // os dados de vrtices e ndices passam por um buffer circular
+    // compartilhado, reciclado  medida que a GPU conclui as cpias
+    ringBuffer = static_cast<BufferHeap*>(uploadBackend->Create(16 * 1048576ULL));
+    uploadRing = new UploadRing(16 * 1048576ULL);
+
+    // ---------------------------------------------------
+    // Heap global de descritores
+    // ---------------------------------------------------
+
+    // uma nica heap visvel aos shaders evita trocas de heap durante
+    // o desenho: a regio persistente guarda os descritores das malhas
+    // e a regio de quadro recebe descritores temporrios; a heap no
+    // passa do maior tamanho aceito em todos os nveis de hardware
+    const uint frameDescriptors = 1024;
+    uint limit = D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1 - frameDescriptors * FrameCount;
+    uint persistent = descriptorCount < limit ? descriptorCount : limit;
+    descriptors = new DescriptorAllocator(persistent, frameDescriptors, FrameCount);
+
+    D3D12_DESCRIPTOR_HEAP_DESC descHeapDesc = {};
+    descHeapDesc.NumDescriptors = descriptors->Capacity();
+    descHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    descHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    ThrowIfFailed(device->CreateDescriptorHeap(&descHeapDesc, IID_PPV_ARGS(&descriptorHeap)));
+
+    descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
     // ---------------------------------------------------
     // Fila, lista e alocador de commandos
     // ---------------------------------------------------
@@ -307,6 +438,13 @@ void Graphics::Initialize(Window * window)
         D3D12_COMMAND_LIST_TYPE_DIRECT,
         IID_PPV_ARGS(&commandListAlloc)));
 
+    // cada quadro em voo tem seu prprio alocador, reutilizado 
+    // apenas quando a GPU concluir o quadro que o usou
+    for (uint i = 0; i < FrameCount; ++i)
+        ThrowIfFailed(device->CreateCommandAllocator(
+            D3D12_COMMAND_LIST_TYPE_DIRECT,
+            IID_PPV_ARGS(&frameAllocs[i])));
+
     // cria a lista de comandos
     ThrowIfFailed(device->CreateCommandList(
         0,                                      // usando apenas uma GPU
@@ -315,6 +453,9 @@ void Graphics::Initialize(Window * window)
         nullptr,                                // estado inicial do pipeline
         IID_PPV_ARGS(&commandList)));           // objeto lista de comandos
 
+    // fluxos de comandos gravados pela aplicao vo para esta lista
+    listBackend = new ListBackend(commandList);
+
     // ---------------------------------------------------
     // Cria cerca para sincronizar CPU/GPU
     // ---------------------------------------------------
@@ -332,6 +473,46 @@ void Graphics::Initialize(Window * window)
         ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
     }
 
+    // a CPU grava at FrameCount quadros  frente da GPU
+    queueFence = new QueueFence(commandQueue, fence, fenceEvent);
+    frameSync = new FrameSync(queueFence, FrameCount);
+
+    // ---------------------------------------------------
+    // Fila de cpia
+    // ---------------------------------------------------
+
+    // os envios de vrtices e ndices usam uma fila prpria e
+    // so agrupados em um nico lote por quadro
+    D3D12_COMMAND_QUEUE_DESC copyQueueDesc = {};
+    copyQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+    copyQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    ThrowIfFailed(device->CreateCommandQueue(&copyQueueDesc, IID_PPV_ARGS(&copyQueue)));
+
+    for (uint i = 0; i < FrameCount; ++i)
+        ThrowIfFailed(device->CreateCommandAllocator(
+            D3D12_COMMAND_LIST_TYPE_COPY,
+            IID_PPV_ARGS(&copyAllocs[i])));
+
+    ThrowIfFailed(device->CreateCommandList(
+        0,
+        D3D12_COMMAND_LIST_TYPE_COPY,
+        copyAllocs[0],
+        nullptr,
+        IID_PPV_ARGS(&copyList)));
+
+    // a lista  aberta apenas quando surgir a primeira cpia
+    copyList->Close();
+
+    ThrowIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&copyFence)));
+
+    copyEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (copyEvent == nullptr)
+    {
+        ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+    }
+
+    copyQueueFence = new QueueFence(copyQueue, copyFence, copyEvent);
+
     // ---------------------------------------------------
     // Swap Chain
     // ---------------------------------------------------
@@ -484,14 +665,26 @@ void Graphics::Initialize(Window * window)
 
 void Graphics::Clear(ID3D12PipelineState * pso)
 {
-    // reutiliza a memria associada com a lista de comandos
-    // a lista de comandos deve ter terminado de executar na GPU
-    commandListAlloc->Reset();
+    // reutiliza a memria associada com a lista de comandos do quadro
+    // Present garante que a GPU terminou o quadro que a usou por ltimo
+    uint frame = frameSync->Index();
+    frameAllocs[frame]->Reset();
 
     // uma lista de comandos pode ser reinicializada depois de 
     // adicionada  fila de comandos da GPU (via ExecuteCommandList)
     // reutilizando a lista de comandos reutiliza memria
-    commandList->Reset(commandListAlloc, pso);
+    commandList->Reset(frameAllocs[frame], pso);
+
+    // descritores temporrios deste quadro j foram consumidos;
+    // a atualizao pode estar alocando descritores persistentes
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        descriptors->BeginFrame(frame);
+    }
+
+    // a heap global de descritores  definida uma nica vez por quadro
+    ID3D12DescriptorHeap * descriptorHeaps[] = { descriptorHeap };
+    commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
 
     // indica que o backbuffer ser usado como alvo de renderizao
     D3D12_RESOURCE_BARRIER barrier = {};
@@ -522,32 +715,116 @@ void Graphics::Clear(ID3D12PipelineState * pso)
 
 bool Graphics::WaitCommandQueue()
 {
-    // avana o valor da cerca para marcar novos comandos a partir desse ponto
-    fenceValue++;
+    if (!queueFence)
+        return false;
 
     // adiciona uma instruo na fila de comandos para inserir uma nova barreira
     // GPU vai finalizar todos os comandos em curso antes de processar esse sinal
-    if (FAILED(commandQueue->Signal(fence, fenceValue)))
+    ullong value = queueFence->Signal();
+    if (value == 0)
         return false;
 
     // espera a GPU completar todos os comandos anteriores
-    if (fence->GetCompletedValue() < fenceValue)
+    queueFence->Wait(value);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+void Graphics::Submitted(ullong value)
+{
+    // recursos liberados desde a ltima submisso podem ter sido
+    // usados por essa lista ou por quadros anteriores ainda em voo
+    for (auto & pending : pendingFrees)
+        if (pending.fence == 0)
+            pending.fence = value;
+
+    Retire();
+}
+
+// ------------------------------------------------------------------------------
+
+void Graphics::Retire(bool all)
+{
+    // recicla trechos do buffer circular j copiados pela fila de cpia
+    ullong copied = copyQueueFence->Completed();
+    uploadRing->Retire(copied);
+
+    for (uint i = 0; i < copyFrees.size();)
+    {
+        if (copyFrees[i].fence && copyFrees[i].fence <= copied)
+        {
+            Release(copyFrees[i].alloc);
+            copyFrees[i] = copyFrees.back();
+            copyFrees.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    ullong completed = queueFence->Completed();
+
+    // devolve memria e descritores que a GPU no usa mais
+    for (uint i = 0; i < pendingFrees.size();)
     {
-        // aciona evento quando a GPU atingir a barreira atual  
-        if (FAILED(fence->SetEventOnCompletion(fenceValue, fenceEvent)))
-            return false;
+        PendingFree & pending = pendingFrees[i];
 
-        // espera at o evento ser acionado
-        WaitForSingleObject(fenceEvent, INFINITE);
+        if (pending.fence && pending.fence <= completed)
+        {
+            // muitas remoes de uma vez so espalhadas por vrios quadros: 
+            // ao atingir o oramento, o restante espera o prximo quadro
+            if (!all && releaseBudget && pending.alloc.resource && releaseStats.releasedBytes
+                && releaseStats.releasedBytes + pending.alloc.size > releaseBudget)
+            {
+                ++releaseStats.deferred;
+                ++i;
+                continue;
+            }
+
+            if (pending.alloc.resource)
+            {
+                Release(pending.alloc);
+                releaseStats.pendingBytes -= pending.alloc.size;
+                releaseStats.releasedBytes += pending.alloc.size;
+            }
+
+            if (pending.descriptorCount)
+            {
+                descriptors->Free(pending.descriptor, pending.descriptorCount);
+                releaseStats.liveDescriptors -= pending.descriptorCount;
+            }
+
+            ++releaseStats.released;
+            --releaseStats.pending;
+            pendingFrees[i] = pendingFrees.back();
+            pendingFrees.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
     }
+}
 
-    return true;
+// -----------------------------------------------------------------------------
+
+void Graphics::Release(const Allocation & alloc)
+{
+    (alloc.type == GPU ? gpuPool : uploadPool)->Free(alloc.block);
+
+    --releaseStats.liveBuffers;
+    releaseStats.liveBytes -= alloc.size;
 }
 
 // -----------------------------------------------------------------------------
 
 void Graphics::ResetCommands()
 {
+    // a ltima lista de inicializao foi concluda em SubmitCommands
+    commandListAlloc->Reset();
+
     // reinicia a lista de comandos para preparar para os comandos de inicializao
     commandList->Reset(commandListAlloc, nullptr);
 }
@@ -557,34 +834,164 @@ void Graphics::ResetCommands()
 void Graphics::SubmitCommands()
 {
     // submete os comandos gravados na lista para execuo na GPU
+    WaitUploads();
     commandList->Close();
     ID3D12CommandList* cmdsLists[] = { commandList };
     commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
 
+    // recursos liberados so devolvidos quando a GPU atingir esta cerca
+    ullong value = queueFence->Signal();
+
     // espera at a GPU completar a execuo dos comandos
-    WaitCommandQueue();
+    queueFence->Wait(value);
+    Submitted(value);
+}
+
+// -----------------------------------------------------------------------------
+
+QueueFence::QueueFence(ID3D12CommandQueue * cmdQueue, ID3D12Fence * cmdFence, HANDLE waitEvent)
+    : queue(cmdQueue), fence(cmdFence), event(waitEvent), value(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ullong QueueFence::Signal()
+{
+    // avana o valor da cerca e insere o sinal depois dos comandos j submetidos
+    if (FAILED(queue->Signal(fence, value + 1)))
+        return 0;
+
+    return ++value;
+}
+
+// -----------------------------------------------------------------------------
+
+ullong QueueFence::Value() const
+{
+    return value;
+}
+
+// -----------------------------------------------------------------------------
+
+ID3D12Fence * QueueFence::Fence() const
+{
+    return fence;
+}
+
+// -----------------------------------------------------------------------------
+
+ullong QueueFence::Completed()
+{
+    return fence->GetCompletedValue();
+}
+
+// -----------------------------------------------------------------------------
+
+void QueueFence::Wait(ullong target)
+{
+    if (fence->GetCompletedValue() < target)
+    {
+        // aciona evento quando a GPU atingir a barreira e espera
+        if (SUCCEEDED(fence->SetEventOnCompletion(target, event)))
+            WaitForSingleObject(event, INFINITE);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ListBackend::ListBackend(ID3D12GraphicsCommandList * cmdList)
+    : commandList(cmdList)
+{
 }
 
 // -----------------------------------------------------------------------------
 
-void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
+void ListBackend::Execute(const CommandStream & stream)
+{
+    const RenderCommand * cmd = stream.Data();
+    const RenderCommand * end = cmd + stream.Size();
+
+    // cada registro vira uma chamada da lista de comandos
+    for (; cmd != end; ++cmd)
+    {
+        switch (cmd->type)
+        {
+        case CMD_PIPELINE:
+            commandList->SetPipelineState(reinterpret_cast<ID3D12PipelineState*>(cmd->handle));
+            break;
+
+        case CMD_ROOTSIGNATURE:
+            commandList->SetGraphicsRootSignature(reinterpret_cast<ID3D12RootSignature*>(cmd->handle));
+            break;
+
+        case CMD_TOPOLOGY:
+            commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY(cmd->slot));
+            break;
+
+        case CMD_VIEWPORT:
+        {
+            D3D12_VIEWPORT viewport = { cmd->viewport.x, cmd->viewport.y, cmd->viewport.width,
+                                        cmd->viewport.height, cmd->viewport.minDepth, cmd->viewport.maxDepth };
+            commandList->RSSetViewports(1, &viewport);
+            break;
+        }
+
+        case CMD_CONSTANTS:
+            commandList->SetGraphicsRootConstantBufferView(cmd->slot, cmd->handle);
+            break;
+
+        case CMD_TABLE:
+            commandList->SetGraphicsRootDescriptorTable(cmd->slot, D3D12_GPU_DESCRIPTOR_HANDLE { cmd->handle });
+            break;
+
+        case CMD_VERTEXBUFFER:
+        {
+            D3D12_VERTEX_BUFFER_VIEW view = { cmd->buffer.address, cmd->buffer.size, cmd->buffer.stride };
+            commandList->IASetVertexBuffers(0, 1, &view);
+            break;
+        }
+
+        case CMD_INDEXBUFFER:
+        {
+            DXGI_FORMAT format = (cmd->buffer.stride == 2) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+            D3D12_INDEX_BUFFER_VIEW view = { cmd->buffer.address, cmd->buffer.size, format };
+            commandList->IASetIndexBuffer(&view);
+            break;
+        }
+
+        case CMD_DRAW:
+            commandList->DrawIndexedInstanced(cmd->draw.indexCount, cmd->draw.instanceCount,
+                                              cmd->draw.startIndex, cmd->draw.baseVertex, 0);
+            break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+BufferBackend::BufferBackend(ID3D12Device9 * dev, D3D12_HEAP_TYPE heapType)
+    : device(dev), type(heapType)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void * BufferBackend::Create(ullong size)
 {
     // propriedades da heap do buffer
     D3D12_HEAP_PROPERTIES bufferProp = {};    
-    bufferProp.Type = D3D12_HEAP_TYPE_UPLOAD;
+    bufferProp.Type = type;
     bufferProp.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
     bufferProp.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
     bufferProp.CreationNodeMask = 1;
     bufferProp.VisibleNodeMask = 1;
-    
-    if (type == GPU)
-        bufferProp.Type = D3D12_HEAP_TYPE_DEFAULT;
 
     // descrio do buffer 
     D3D12_RESOURCE_DESC bufferDesc = {};
     bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
     bufferDesc.Alignment = 0;
-    bufferDesc.Width = sizeInBytes;
+    bufferDesc.Width = size;
     bufferDesc.Height = 1;
     bufferDesc.DepthOrArraySize = 1;
     bufferDesc.MipLevels = 1;
@@ -594,122 +1001,301 @@ void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
     bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-    // estado inicial do recurso
+    // estado inicial do recurso: buffers da GPU ficam no estado comum e so 
+    // promovidos implicitamente para cpia e leitura, voltando ao estado 
+    // comum ao final de cada ExecuteCommandLists
     D3D12_RESOURCE_STATES initState = D3D12_RESOURCE_STATE_GENERIC_READ;
     
-    if (type == GPU)
+    if (type == D3D12_HEAP_TYPE_DEFAULT)
         initState = D3D12_RESOURCE_STATE_COMMON;
 
-    // cria um buffer para o recurso
+    BufferHeap * heap = new BufferHeap();
+
+    // cria um buffer que ocupa toda a heap
     ThrowIfFailed(device->CreateCommittedResource(
         &bufferProp,
         D3D12_HEAP_FLAG_NONE,
         &bufferDesc,
         initState,
         nullptr,
-        IID_PPV_ARGS(resource)));
+        IID_PPV_ARGS(&heap->resource)));
+
+    // heaps de upload ficam mapeadas durante toda a sua existncia
+    if (type == D3D12_HEAP_TYPE_UPLOAD)
+        ThrowIfFailed(heap->resource->Map(0, nullptr, reinterpret_cast<void**>(&heap->data)));
+
+    return heap;
+}
+
+// -----------------------------------------------------------------------------
+
+void BufferBackend::Destroy(void * heap)
+{
+    BufferHeap * buffer = static_cast<BufferHeap*>(heap);
+
+    if (buffer->data)
+        buffer->resource->Unmap(0, nullptr);
+
+    buffer->resource->Release();
+    delete buffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::Allocate(uint type, uint sizeInBytes, Allocation * alloc)
+{
+    HeapPool * pool = (type == GPU) ? gpuPool : uploadPool;
+
+    // constant buffers precisam de endereos mltiplos de 256 bytes,
+    // garantidos pelo tamanho mnimo dos blocos do pool
+    if (!pool->Allocate(sizeInBytes, 256, &alloc->block))
+    {
+        // o oramento de liberao no pode causar falta de memria:
+        // devolve tudo que a GPU j concluiu e tenta novamente
+        Retire(true);
+
+        if (!pool->Allocate(sizeInBytes, 256, &alloc->block))
+            ThrowIfFailed(E_OUTOFMEMORY);
+    }
+
+    BufferHeap * heap = static_cast<BufferHeap*>(alloc->block.heap);
+
+    alloc->resource = heap->resource;
+    alloc->offset = alloc->block.offset;
+    alloc->size = sizeInBytes;
+    alloc->data = heap->data ? heap->data + alloc->block.offset : nullptr;
+    alloc->type = type;
+
+    ++releaseStats.liveBuffers;
+    releaseStats.liveBytes += sizeInBytes;
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::Free(Allocation & alloc)
+{
+    if (!alloc.resource)
+        return;
+
+    // quadros em voo ainda podem ler a memria: ela s 
+    // volta ao pool quando a GPU atingir a prxima cerca
+    PendingFree pending;
+    pending.alloc = alloc;
+    pendingFrees.push_back(pending);
+
+    ++releaseStats.pending;
+    releaseStats.pendingBytes += alloc.size;
+
+    alloc = Allocation();
+}
+
+// -----------------------------------------------------------------------------
+
+uint Graphics::AllocateDescriptors(uint count)
+{
+    uint index = descriptors->Allocate(count);
+
+    if (index == DescriptorAllocator::Invalid)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    releaseStats.liveDescriptors += count;
+    return index;
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::FreeDescriptors(uint index, uint count)
+{
+    // descritores tambm podem estar em uso por quadros em voo
+    PendingFree pending;
+    pending.descriptor = index;
+    pending.descriptorCount = count;
+    pendingFrees.push_back(pending);
+    ++releaseStats.pending;
+}
+
+// -----------------------------------------------------------------------------
+
+uint Graphics::FrameDescriptors(uint count)
+{
+    uint index = descriptors->AllocateFrame(count);
+
+    if (index == DescriptorAllocator::Invalid)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    return index;
 }
 
 // -----------------------------------------------------------------------------
 
-void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3D12Resource* bufferUpload, ID3D12Resource* bufferGPU)
+D3D12_CPU_DESCRIPTOR_HANDLE Graphics::CpuDescriptor(uint index)
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = descriptorHeap->GetCPUDescriptorHandleForHeapStart();
+    handle.ptr += SIZE_T(index) * SIZE_T(descriptorSize);
+    return handle;
+}
+
+// -----------------------------------------------------------------------------
+
+D3D12_GPU_DESCRIPTOR_HANDLE Graphics::GpuDescriptor(uint index)
+{
+    D3D12_GPU_DESCRIPTOR_HANDLE handle = descriptorHeap->GetGPUDescriptorHandleForHeapStart();
+    handle.ptr += ullong(index) * ullong(descriptorSize);
+    return handle;
+}
+
+// -----------------------------------------------------------------------------
+
+AllocStats Graphics::MemoryStats(uint type)
+{
+    return (type == GPU) ? gpuPool->Stats() : uploadPool->Stats();
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::OpenCopies()
+{
+    if (copyOpen)
+        return;
+
+    // o alocador s  reutilizado depois que a fila de cpia concluiu o lote
+    copyAllocIndex = (copyAllocIndex + 1) % FrameCount;
+    copyQueueFence->Wait(copyAllocFences[copyAllocIndex]);
+
+    copyAllocs[copyAllocIndex]->Reset();
+    copyList->Reset(copyAllocs[copyAllocIndex], nullptr);
+    copyOpen = true;
+}
+
+// -----------------------------------------------------------------------------
+
+ullong Graphics::Copy(const void* vertices, uint sizeInBytes, const Allocation & bufferGPU)
 {
     // ----------------------------------------------------------------------------------
     // Copia vrtices para o buffer padro (GPU)
     // ----------------------------------------------------------------------------------
     //
     //  Para copiar dados para a GPU:
-    //  - primeiro copia-se os dados para a heap intermediria de upload
-    //  - depois usando ID3D12CommandList::CopyBufferRegion copia-se de upload para a GPU
+    //  - primeiro copia-se os dados para um trecho do buffer circular de upload
+    //  - depois grava-se um CopyBufferRegion na lista da fila de cpia
+    //  - as cpias so submetidas em lote por FlushUploads, sem esperar a GPU
+    //  - o trecho  reciclado quando a fila de cpia atingir a cerca do lote
+    //
+    //  O buffer da GPU  compartilhado por vrias alocaes e fica no estado comum:
+    //  a cpia o promove implicitamente para COPY_DEST e ele retorna ao estado comum
+    //  ao final da execuo da lista, podendo ento ser lido pela fila direta
     //
     // ----------------------------------------------------------------------------------
 
-    // descreve os dados que sero copiados
-    D3D12_SUBRESOURCE_DATA vertexSubResourceData = {};
-    vertexSubResourceData.pData = vertices;
-    vertexSubResourceData.RowPitch = sizeInBytes;
-    vertexSubResourceData.SlicePitch = sizeInBytes;
-
-    // descreve o layout da memria de vdeo (GPU)
-    D3D12_PLACED_SUBRESOURCE_FOOTPRINT layouts;
-    uint numRows;
-    ullong rowSizesInBytes;
-    ullong requiredSize = 0;
+    Retire();
 
-    D3D12_RESOURCE_DESC bufferGPUDesc = bufferGPU->GetDesc();
+    ullong offset = uploadRing->Allocate(sizeInBytes);
 
-    // pega layout da memria de vdeo
-    device->GetCopyableFootprints(
-        &bufferGPUDesc,
-        0, 1, 0, &layouts, &numRows,
-        &rowSizesInBytes, &requiredSize);
+    // buffer cheio: submete o lote atual e espera a 
+    // fila de cpia liberar os trechos mais antigos
+    while (offset == UploadRing::Invalid)
+    {
+        if (uploadRing->Pending())
+        {
+            uploadRing->Stall();
+            copyQueueFence->Wait(uploadRing->OldestFence());
+            Retire();
+        }
+        else if (copyOpen)
+        {
+            FlushUploads();
+        }
+        else
+        {
+            break;
+        }
 
-    // --------------------------------------
-    // Copia Vrtices no Upload Buffer
-    // --------------------------------------
+        offset = uploadRing->Allocate(sizeInBytes);
+    }
 
-    // trava memria do upload buffer para acesso exclusivo 
-    BYTE* pData;
-    bufferUpload->Map(0, nullptr, (void**)&pData);
+    ID3D12Resource * source;
+    ullong sourceOffset;
+    byte * data;
 
-    // descreve o destino de uma operao de cpia
-    D3D12_MEMCPY_DEST DestData =
+    if (offset != UploadRing::Invalid)
     {
-        pData + layouts.Offset,
-        layouts.Footprint.RowPitch,
-        layouts.Footprint.RowPitch * ullong(numRows)
-    };
-
-    // copia vrtices no upload buffer
-    for (uint z = 0; z < layouts.Footprint.Depth; ++z)
+        source = ringBuffer->resource;
+        sourceOffset = offset;
+        data = ringBuffer->data + offset;
+    }
+    else
     {
-        // endereo de destino
-        BYTE * destSlice = (BYTE*)(DestData.pData) + DestData.SlicePitch * z;
+        // dados maiores que o buffer circular usam uma
+        // alocao temporria liberada pela cerca do lote
+        uploadRing->Overflow();
 
-        // endereo da fonte
-        const BYTE* srcSlice = (const BYTE*)(vertexSubResourceData.pData) + vertexSubResourceData.SlicePitch * z;
-        
-        // faz cpia linha a linha
-        for (uint y = 0; y < numRows; ++y)
-            memcpy(destSlice + DestData.RowPitch * y,
-                   srcSlice + vertexSubResourceData.RowPitch * y,
-                   (size_t)rowSizesInBytes);
+        PendingFree temp;
+        Allocate(UPLOAD, sizeInBytes, &temp.alloc);
+        copyFrees.push_back(temp);
+
+        source = temp.alloc.resource;
+        sourceOffset = temp.alloc.offset;
+        data = temp.alloc.data;
     }
 
-    // libera trava de memria do upload buffer 
-    bufferUpload->Unmap(0, nullptr);
+    // copia vrtices no upload buffer (mapeado permanentemente)
+    memcpy(data, vertices, sizeInBytes);
 
-    // --------------------------------------
-    // Copia Vrtices do Upload -> GPU Buffer
-    // --------------------------------------
+    // grava a cpia do upload buffer para a GPU no lote atual
+    OpenCopies();
+    copyList->CopyBufferRegion(
+        bufferGPU.resource,
+        bufferGPU.offset,
+        source,
+        sourceOffset,
+        sizeInBytes);
 
-    // altera estado da memria da GPU (de leitura para escrita)
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = bufferGPU;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    commandList->ResourceBarrier(1, &barrier);
+    // cerca que ser sinalizada ao final deste lote
+    return copyQueueFence->Value() + 1;
+}
 
-    // copia vertex buffer do upload buffer para a GPU
-    commandList->CopyBufferRegion(
-        bufferGPU,
-        0,
-        bufferUpload,
-        layouts.Offset,
-        layouts.Footprint.Width);
+// -----------------------------------------------------------------------------
 
-    // altera estado da memria da GPU (de escrita para leitura)
-    barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = bufferGPU;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    commandList->ResourceBarrier(1, &barrier);
+void Graphics::FlushUploads()
+{
+    if (!copyOpen)
+        return;
+
+    // submete todas as cpias gravadas desde o ltimo lote
+    copyList->Close();
+    ID3D12CommandList* cmdsLists[] = { copyList };
+    copyQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+    copyOpen = false;
+
+    ullong value = copyQueueFence->Signal();
+    copyAllocFences[copyAllocIndex] = value;
+
+    // trechos e uploads temporrios do lote so liberados por esta cerca
+    uploadRing->Close(value);
+
+    for (auto & temp : copyFrees)
+        if (temp.fence == 0)
+            temp.fence = value;
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::WaitUploads()
+{
+    // um lote por quadro: cpias ainda no submetidas seguem agora
+    FlushUploads();
+
+    // a fila direta s espera pela fila de cpia quando um desenho
+    // usa dados de um lote que ela ainda no aguardou; a espera
+    // ocorre na GPU, sem bloquear a CPU; a atualizao do prximo
+    // quadro pode elevar o valor exigido, por isso ele  lido uma vez
+    ullong required = copyRequired.load();
+
+    if (required > copyWaited)
+    {
+        commandQueue->Wait(copyQueueFence->Fence(), required);
+        copyWaited = required;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -726,12 +1312,36 @@ void Graphics::Present()
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     commandList->ResourceBarrier(1, &barrier);
 
+    // o lote de cpias  compartilhado com a atualizao
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        WaitUploads();
+    }
+
     // submete a lista de comandos para execuo na GPU
-    SubmitCommands();
+    commandList->Close();
+    ID3D12CommandList* cmdsLists[] = { commandList };
+    commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
 
-    // apresenta frame e troca front/back buffer
+    // apresenta frame e troca front/back buffer; a espera pelo vsync
+    // e pela GPU ocorre sem a trava para no bloquear a atualizao
     swapChain->Present(vSync, 0);
     backBufferIndex = (backBufferIndex + 1) % backBufferCount;
+
+    // sinaliza o fim do quadro sem esperar a GPU: a CPU s 
+    // bloqueia se estiver FrameCount quadros  frente
+    ullong value = frameSync->EndFrame();
+
+    // memria e descritores liberados so compartilhados com a atualizao
+    std::lock_guard<std::mutex> lock(mutex);
+    frameStats = frameSync->Stats();
+
+    // o oramento de liberao recomea a cada quadro
+    releaseStats.released = 0;
+    releaseStats.releasedBytes = 0;
+    releaseStats.deferred = 0;
+
+    Submitted(value);
 }
 
 // -----------------------------------------------------------------------------
@@ -20,13 +20,120 @@
 #include "Window.h"              // cria e configura uma janela do Windows
 #include "Types.h"               // tipos especficos da engine
 #include <D3DCompiler.h>         // fornece D3DBlob
+#include "Allocator.h"           // poltica de sub-alocao de memria
+#include "Ring.h"                // controle do buffer circular de upload
+#include "Descriptors.h"         // distribuio de descritores da heap global
+#include "Frames.h"              // controle dos quadros em voo
+#include "CommandStream.h"       // fluxo de comandos independente da API
+#include <atomic>
+#include <mutex>
+#include <vector>
+using std::vector;
 
 enum AllocationType { GPU, UPLOAD, CBUFFER };
 
 // --------------------------------------------------------------------------------
 
+struct BufferHeap
+{
+    ID3D12Resource * resource = nullptr;    // buffer que ocupa toda a heap
+    byte           * data = nullptr;        // endereo na CPU (apenas heaps de upload)
+};
+
+// --------------------------------------------------------------------------------
+
+class BufferBackend : public HeapBackend
+{
+private:
+    ID3D12Device9  * device;                // dispositivo grfico
+    D3D12_HEAP_TYPE  type;                  // heap da GPU (DEFAULT) ou de upload (UPLOAD)
+
+public:
+    BufferBackend(ID3D12Device9 * dev, D3D12_HEAP_TYPE heapType);
+
+    void * Create(ullong size);             // cria um buffer comprometido do tamanho da heap
+    void Destroy(void * heap);              // libera o buffer
+};
+
+// --------------------------------------------------------------------------------
+
+struct Allocation
+{
+    ID3D12Resource * resource = nullptr;    // buffer da heap que contm a alocao
+    ullong           offset = 0;            // deslocamento dentro do buffer
+    ullong           size = 0;              // tamanho solicitado
+    byte           * data = nullptr;        // endereo na CPU (apenas UPLOAD e CBUFFER)
+    uint             type = GPU;            // tipo de memria
+    PoolAllocation   block;                 // bloco reservado no pool
+
+    D3D12_GPU_VIRTUAL_ADDRESS Address() const
+    { return resource->GetGPUVirtualAddress() + offset; }
+};
+
+// --------------------------------------------------------------------------------
+
+struct PendingFree
+{
+    Allocation alloc;                       // memria a devolver ao pool
+    uint       descriptor = 0;              // primeiro descritor a devolver
+    uint       descriptorCount = 0;         // nmero de descritores a devolver
+    ullong     fence = 0;                   // cerca que libera os recursos (0 = no submetida)
+};
+
+// --------------------------------------------------------------------------------
+
+struct ReleaseStats
+{
+    uint   liveBuffers = 0;                 // alocaes ainda presas aos pools
+    ullong liveBytes = 0;                   // bytes dessas alocaes
+    uint   liveDescriptors = 0;             // descritores persistentes reservados
+    uint   pending = 0;                     // liberaes esperando a GPU ou o oramento
+    ullong pendingBytes = 0;                // bytes aguardando liberao
+    uint   released = 0;                    // liberaes concludas no quadro
+    ullong releasedBytes = 0;               // bytes devolvidos aos pools no quadro
+    uint   deferred = 0;                    // liberaes prontas adiadas pelo oramento
+};
+
+// --------------------------------------------------------------------------------
+
+class QueueFence : public FenceBackend
+{
+private:
+    ID3D12CommandQueue         * queue;     // fila de comandos sinalizada
+    ID3D12Fence                * fence;     // cerca da fila
+    HANDLE                       event;     // evento usado na espera
+    ullong                       value;     // ltimo valor sinalizado
+
+public:
+    QueueFence(ID3D12CommandQueue * cmdQueue, ID3D12Fence * cmdFence, HANDLE waitEvent);
+
+    ullong Signal();                        // insere cerca aps os comandos submetidos (0 = falha)
+    ullong Completed();                     // ltimo valor atingido pela GPU
+    void Wait(ullong target);               // espera a GPU atingir o valor
+    ullong Value() const;                   // ltimo valor sinalizado
+    ID3D12Fence * Fence() const;            // cerca da fila
+};
+
+// --------------------------------------------------------------------------------
+
+class ListBackend : public CommandBackend
+{
+private:
+    ID3D12GraphicsCommandList * commandList;    // lista que recebe os comandos traduzidos
+
+public:
+    ListBackend(ID3D12GraphicsCommandList * cmdList);
+
+    void Execute(const CommandStream & stream); // grava o fluxo na lista de comandos
+};
+
+// --------------------------------------------------------------------------------
+
 class Graphics
 {
+public:
+    static const uint FrameCount = 3;                       // nmero de quadros em voo
+
 private:
     // configurao
     uint                         backBufferCount;           // nmero de buffers na swap chain (double, triple, etc.)
@@ -43,7 +150,8 @@ private:
     
     ID3D12CommandQueue         * commandQueue;              // fila de comandos da GPU
     ID3D12GraphicsCommandList  * commandList;               // lista de comandos a submeter para GPU
-    ID3D12CommandAllocator     * commandListAlloc;          // memria utilizada pela lista de comandos
+    ID3D12CommandAllocator     * commandListAlloc;          // memria da lista de comandos de inicializao
+    ID3D12CommandAllocator     * frameAllocs[FrameCount];   // memria da lista de comandos de cada quadro
      
     ID3D12Resource            ** renderTargets;             // buffers para renderizao (front e back)
     ID3D12Resource             * depthStencil;              // buffer de profundidade e estampa            
@@ -56,37 +164,103 @@ private:
     // sincronizao                         
     ID3D12Fence                * fence;                     // barreira para sincronizar CPU/GPU
     HANDLE                       fenceEvent;                // sinalizador de eventos
-    ullong                       fenceValue;				// nmero atual da barreira
+    QueueFence                 * queueFence;                // sinaliza e espera a cerca da fila
+    FrameSync                  * frameSync;                 // controla os quadros em voo
+    FrameStats                   frameStats;                // cpia das estatsticas protegida pela trava
+    ListBackend                * listBackend;               // traduz fluxos de comandos para a lista
+
+    // memria
+    BufferBackend              * gpuBackend;                // cria heaps na memria de vdeo
+    BufferBackend              * uploadBackend;             // cria heaps de upload
+    HeapPool                   * gpuPool;                   // sub-aloca buffers da GPU
+    HeapPool                   * uploadPool;                // sub-aloca buffers de upload e constantes
+
+    // upload
+    BufferHeap                 * ringBuffer;                // buffer circular de upload (mapeado)
+    UploadRing                 * uploadRing;                // controle das regies do buffer circular
+    vector<PendingFree>          pendingFrees;              // recursos aguardando a GPU para serem liberados
+    ullong                       releaseBudget;             // bytes devolvidos aos pools por quadro (0 = sem limite)
+    ReleaseStats                 releaseStats;              // contagens de recursos vivos e pendentes
+
+    // fila de cpia
+    ID3D12CommandQueue         * copyQueue;                 // fila de comandos de cpia
+    ID3D12GraphicsCommandList  * copyList;                  // lista que agrupa as cpias pendentes
+    ID3D12CommandAllocator     * copyAllocs[FrameCount];    // memria das listas de cpia
+    ullong                       copyAllocFences[FrameCount]; // cerca que libera cada alocador de cpia
+    uint                         copyAllocIndex;            // alocador da lista em gravao
+    ID3D12Fence                * copyFence;                 // cerca da fila de cpia
+    HANDLE                       copyEvent;                 // evento usado na espera da fila de cpia
+    QueueFence                 * copyQueueFence;            // sinaliza e espera a cerca da fila de cpia
+    bool                         copyOpen;                  // lista de cpia em gravao
+    std::atomic<ullong>          copyRequired;              // maior cerca de cpia usada pelos desenhos
+    ullong                       copyWaited;                // ltima cerca de cpia aguardada pela fila direta
+    vector<PendingFree>          copyFrees;                 // uploads temporrios liberados pela fila de cpia
+
+    // descritores
+    ID3D12DescriptorHeap       * descriptorHeap;            // heap global de descritores CBV/SRV/UAV
+    DescriptorAllocator        * descriptors;               // distribui ndices da heap global
+    uint                         descriptorCount;           // descritores persistentes da heap global
+    uint                         descriptorSize;            // tamanho de um descritor CBV/SRV/UAV
+
+    // threads
+    std::mutex                   mutex;                     // serializa atualizao e renderizao no dispositivo
 
     // mtodos privados
     void LogHardwareInfo();                                 // mostra informaes do hardware
     bool WaitCommandQueue();                                // espera execuo da fila de comandos
+    void Submitted(ullong value);                           // associa uploads e liberaes a uma cerca
+    void Retire(bool all = false);                          // libera recursos j consumidos pela GPU
+    void Release(const Allocation & alloc);                 // devolve memria ao pool
+    void OpenCopies();                                      // inicia a gravao de um lote de cpias
+    void WaitUploads();                                     // fila direta espera as cpias usadas
 
 public:
     Graphics();                                             // constructor
     ~Graphics();                                            // destructor
 
     void VSync(bool state);                                 // liga/desliga vertical sync
+    void Descriptors(uint count);                           // descritores persistentes (antes de Initialize)
     void Initialize(Window * window);                       // inicializa o Direct3D
     void Clear(ID3D12PipelineState * pso);                  // limpa o backbuffer com a cor de fundo
     void Present();                                         // apresenta desenho na tela
 
+    CommandBackend & Commands();                            // grava fluxos de comandos na lista do quadro
     void ResetCommands();                                   // reinicia lista para receber novos comandos
     void SubmitCommands();                                  // submete para execuo os comandos pendentes
 
     void Allocate(uint type,
                   uint sizeInBytes, 
-                  ID3D12Resource** resource);               // aloca memria da GPU para recurso
+                  Allocation * alloc);                      // sub-aloca memria da GPU para recurso
+
+    void Free(Allocation & alloc);                          // devolve memria ao pool aps a GPU us-la
+
+    ullong Copy(const void* vertices, 
+                uint sizeInBytes,
+                const Allocation & bufferGPU);              // agenda cpia para a GPU e retorna sua cerca
+
+    void FlushUploads();                                    // submete o lote de cpias pendentes
+    void UseUpload(ullong copyValue);                       // indica uso de dados copiados no quadro
+
+    uint AllocateDescriptors(uint count = 1);               // reserva descritores persistentes
+    void FreeDescriptors(uint index, uint count = 1);       // devolve descritores persistentes
+    uint FrameDescriptors(uint count = 1);                  // reserva descritores vlidos apenas no quadro
 
-    void Copy(const void* vertices, 
-              uint sizeInBytes,
-              ID3D12Resource* bufferUpload,
-              ID3D12Resource* bufferGPU);                   // copia vrtices para a GPU
+    D3D12_CPU_DESCRIPTOR_HANDLE CpuDescriptor(uint index);  // endereo do descritor para a CPU
+    D3D12_GPU_DESCRIPTOR_HANDLE GpuDescriptor(uint index);  // endereo do descritor para a GPU
+    ID3D12DescriptorHeap* DescriptorHeap();                 // retorna heap global de descritores
+
+    AllocStats MemoryStats(uint type);                      // estatsticas de uso da memria
+    RingStats UploadStats();                                // estatsticas do buffer circular de upload
+    ReleaseStats Releases() const;                          // recursos vivos e liberaes pendentes
+    void ReleaseBudget(ullong bytes);                       // limita os bytes liberados por quadro
 
     ID3D12Device9* Device();                                // retorna dispositivo Direct3D
     ID3D12GraphicsCommandList* CommandList();               // retorna lista de comandos
+    uint FrameIndex();                                      // retorna ndice do quadro em gravao
+    FrameStats FrameSyncStats();                            // estatsticas dos quadros em voo
     uint Antialiasing();                                    // retorna nmero de amostras por pixel
     uint Quality();                                         // retorna qualidade das amostras
+    std::mutex & Mutex();                                   // trava das alocaes, cpias e submisses
 };
 
 // --------------------------------------------------------------------------------
@@ -96,6 +270,10 @@ public:
 inline void Graphics::VSync(bool state)
 { vSync = state; }
 
+// ajusta o nmero de descritores persistentes da heap global
+inline void Graphics::Descriptors(uint count)
+{ descriptorCount = count; }
+
 // retorna dispositivo Direct3D
 inline ID3D12Device9* Graphics::Device()
 { return device; }
@@ -104,6 +282,18 @@ inline ID3D12Device9* Graphics::Device()
 inline ID3D12GraphicsCommandList* Graphics::CommandList()
 { return commandList; }
 
+// retorna o tradutor de fluxos de comandos para a lista do quadro
+inline CommandBackend & Graphics::Commands()
+{ return *listBackend; }
+
+// retorna ndice do quadro em gravao
+inline uint Graphics::FrameIndex()
+{ return frameSync->Index(); }
+
+// retorna estatsticas dos quadros em voo
+inline FrameStats Graphics::FrameSyncStats()
+{ return frameStats; }
+
 // retorna nmero de amostras por pixel
 inline uint Graphics::Antialiasing()
 { return antialiasing; }
@@ -112,6 +302,34 @@ inline uint Graphics::Antialiasing()
 inline uint Graphics::Quality()
 { return quality; }
 
+// retorna a trava do dispositivo compartilhado entre threads
+inline std::mutex & Graphics::Mutex()
+{ return mutex; }
+
+// indica que o quadro usa dados enviados pela fila de cpia
+// (pode ser chamado pela atualizao enquanto outro quadro  gravado)
+inline void Graphics::UseUpload(ullong copyValue)
+{
+    ullong required = copyRequired.load();
+    while (copyValue > required && !copyRequired.compare_exchange_weak(required, copyValue));
+}
+
+// retorna heap global de descritores
+inline ID3D12DescriptorHeap* Graphics::DescriptorHeap()
+{ return descriptorHeap; }
+
+// retorna contagens de recursos vivos e liberaes pendentes
+inline ReleaseStats Graphics::Releases() const
+{ return releaseStats; }
+
+// limita os bytes devolvidos aos pools em cada quadro
+inline void Graphics::ReleaseBudget(ullong bytes)
+{ releaseBudget = bytes; }
+
+// retorna estatsticas do buffer circular de upload
+inline RingStats Graphics::UploadStats()
+{ return uploadRing->Stats(); }
+
 // --------------------------------------------------------------------------------
 
 #endif
\ No newline at end of file
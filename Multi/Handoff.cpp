@@ -0,0 +1,147 @@
+/**********************************************************************************
+// Handoff (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Entrega de quadros entre a thread de atualizao e a thread de
+//              renderizao. A aplicao mantm duas cpias dos dados de um
+//              quadro (transformaes, constantes, listas de desenho): a
+//              atualizao do quadro N+1 escreve em uma cpia enquanto o
+//              quadro N  gravado e submetido a partir da outra. A entrega
+//               em ordem e nenhum quadro  descartado; a atualizao s
+//              espera quando a renderizao est um quadro inteiro atrs.
+//              Os tempos de cada lado, as esperas e a latncia entre o
+//              incio da atualizao e o fim da renderizao so medidos.
+//
+**********************************************************************************/
+
+#include "Handoff.h"
+
+// -------------------------------------------------------------------------------
+
+FrameHandoff::FrameHandoff()
+    : published(0), consumed(0), stopped(false), anyPresented(false)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::BeginUpdate()
+{
+    Clock::time_point waitBegin = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // a cpia a escrever foi usada pelo quadro de Slots entregas atrs:
+    // ela s fica livre quando a renderizao termina esse quadro
+    changed.wait(lock, [this] { return published - consumed < Slots; });
+
+    updateBegin = Clock::now();
+    started[published % Slots] = updateBegin;
+    sums.updateWait += Milliseconds(waitBegin, updateBegin);
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::EndUpdate()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sums.update += Milliseconds(updateBegin, Clock::now());
+        ++published;
+    }
+
+    changed.notify_all();
+}
+
+// -------------------------------------------------------------------------------
+
+bool FrameHandoff::BeginRender()
+{
+    Clock::time_point waitBegin = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // os quadros entregues so renderizados antes do encerramento
+    changed.wait(lock, [this] { return consumed < published || stopped; });
+
+    if (consumed == published)
+        return false;
+
+    renderBegin = Clock::now();
+    sums.renderWait += Milliseconds(waitBegin, renderBegin);
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::EndRender()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Clock::time_point now = Clock::now();
+
+        sums.render += Milliseconds(renderBegin, now);
+        sums.latency += Milliseconds(started[consumed % Slots], now);
+
+        if (anyPresented)
+            sums.interval += Milliseconds(presented, now);
+
+        presented = now;
+        anyPresented = true;
+        ++sums.frames;
+        ++consumed;
+    }
+
+    changed.notify_all();
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = false;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+
+    changed.notify_all();
+}
+
+// -------------------------------------------------------------------------------
+
+HandoffStats FrameHandoff::Stats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    HandoffStats stats = sums;
+
+    if (stats.frames)
+    {
+        stats.update /= stats.frames;
+        stats.render /= stats.frames;
+        stats.updateWait /= stats.frames;
+        stats.renderWait /= stats.frames;
+        stats.latency /= stats.frames;
+        stats.interval /= stats.frames;
+    }
+
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameHandoff::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sums = HandoffStats();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+/**********************************************************************************
+// Handoff (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Entrega de quadros entre a thread de atualizao e a thread de
+//              renderizao. A aplicao mantm duas cpias dos dados de um
+//              quadro (transformaes, constantes, listas de desenho): a
+//              atualizao do quadro N+1 escreve em uma cpia enquanto o
+//              quadro N  gravado e submetido a partir da outra. A entrega
+//               em ordem e nenhum quadro  descartado; a atualizao s
+//              espera quando a renderizao est um quadro inteiro atrs.
+//              Os tempos de cada lado, as esperas e a latncia entre o
+//              incio da atualizao e o fim da renderizao so medidos.
+//
+**********************************************************************************/
+
+#ifndef DXUT_HANDOFF_H_
+#define DXUT_HANDOFF_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// -------------------------------------------------------------------------------
+
+struct HandoffStats
+{
+    uint   frames = 0;                      // quadros renderizados
+    double update = 0;                      // milissegundos por atualizao
+    double render = 0;                      // milissegundos por renderizao
+    double updateWait = 0;                  // atualizao esperando uma cpia livre
+    double renderWait = 0;                  // renderizao esperando um quadro
+    double interval = 0;                    // milissegundos entre quadros apresentados
+    double latency = 0;                     // do incio da atualizao ao fim da renderizao
+};
+
+// -------------------------------------------------------------------------------
+
+class FrameHandoff
+{
+public:
+    static const uint Slots = 2;            // cpias dos dados de um quadro
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex mutex;                       // protege contadores e estatsticas
+    std::condition_variable changed;        // quadro entregue ou cpia liberada
+    ullong published;                       // quadros entregues pela atualizao
+    ullong consumed;                        // quadros concludos pela renderizao
+    bool   stopped;                         // renderizao deve encerrar
+
+    Clock::time_point started[Slots];       // incio da atualizao de cada cpia
+    Clock::time_point updateBegin;          // incio da atualizao em curso
+    Clock::time_point renderBegin;          // incio da renderizao em curso
+    Clock::time_point presented;            // fim da ltima renderizao
+    bool   anyPresented;                    // j houve um quadro apresentado?
+
+    HandoffStats sums;                      // somas desde o ltimo ResetStats
+
+    static double Milliseconds(Clock::time_point from, Clock::time_point to);
+
+public:
+    FrameHandoff();
+
+    void BeginUpdate();                     // espera a cpia do prximo quadro ficar livre
+    void EndUpdate();                       // entrega o quadro  renderizao
+    bool BeginRender();                     // espera um quadro (false: encerrar)
+    void EndRender();                       // libera a cpia lida
+
+    void Start();                           // permite novas renderizaes
+    void Stop();                            // encerra a renderizao aps os quadros entregues
+
+    uint UpdateSlot() const;                // cpia escrita pela atualizao
+    uint RenderSlot() const;                // cpia lida pela renderizao
+
+    HandoffStats Stats();                   // mdias por quadro desde o ltimo ResetStats
+    void ResetStats();                      // reinicia as mdias
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+// cada contador s  alterado pela thread que o consulta
+
+inline uint FrameHandoff::UpdateSlot() const
+{ return uint(published % Slots); }
+
+inline uint FrameHandoff::RenderSlot() const
+{ return uint(consumed % Slots); }
+
+inline double FrameHandoff::Milliseconds(Clock::time_point from, Clock::time_point to)
+{ return std::chrono::duration<double, std::milli>(to - from).count(); }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,42 @@
+/**********************************************************************************
+// Hash (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hash FNV-1a de 64 bits, usado para identificar o bytecode dos
+//              shaders e as descries de pipelines e assinaturas raiz. Um
+//              hash pode ser continuado passando o resultado anterior.
+//
+**********************************************************************************/
+
+#ifndef DXUT_HASH_H_
+#define DXUT_HASH_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+
+// -------------------------------------------------------------------------------
+
+const ullong Fnv1aBasis = 14695981039346656037ull;      // valor inicial do hash
+const ullong Fnv1aPrime = 1099511628211ull;             // multiplicador de cada byte
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline ullong Fnv1a(const void * data, ullong size, ullong hash = Fnv1aBasis)
+{
+    const byte * bytes = (const byte *) data;
+    for (ullong i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= Fnv1aPrime;
+    }
+    return hash;
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,332 @@
+/**********************************************************************************
+// Jobs (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Sistema de tarefas com roubo de trabalho. Cada thread tem sua
+//              prpria fila dupla: a dona insere e retira tarefas pelo final
+//              (a mais recente, ainda quente na cache) e as threads ociosas
+//              roubam pelo incio (a mais antiga, em geral a maior parte do
+//              trabalho restante). Contadores de dependncia indicam quando
+//              um grupo de tarefas terminou e podem liberar tarefas que
+//              dependem dele. A thread principal  a thread 0 e ajuda a
+//              executar tarefas enquanto espera um contador. Threads de fora
+//              do sistema, como a de renderizao, podem ser registradas com
+//              fila e estatsticas prprias; elas e a principal roubam apenas
+//              das threads de trabalho, no umas das outras.
+//
+**********************************************************************************/
+
+#include "Jobs.h"
+
+// -------------------------------------------------------------------------------
+
+// thread atual dentro do sistema que a criou (threads no registradas usam a fila 0)
+static thread_local const JobSystem * owner = nullptr;
+static thread_local uint ownerIndex = 0;
+
+// instante atual em nanossegundos; ResetStats e Stats podem ser chamadas
+// de threads diferentes, por isso o incio das estatsticas  atmico
+static llong Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------------------------------------------------------------
+
+JobSystem::JobSystem(uint threads, uint external)
+    : external(external), queued(0), sleeping(0), quit(false)
+{
+    count = threads ? threads : 1;
+    queues = new Queue[count + external];
+    counters = new Counters[count + external];
+    since = Now();
+
+    // a thread que cria o sistema  a thread principal
+    owner = this;
+    ownerIndex = 0;
+
+    for (uint i = 1; i < count; ++i)
+        this->threads.emplace_back(&JobSystem::Worker, this, i);
+}
+
+// -------------------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+
+    wake.notify_all();
+
+    for (auto & thread : threads)
+        thread.join();
+
+    delete[] queues;
+    delete[] counters;
+}
+
+// -------------------------------------------------------------------------------
+
+uint JobSystem::ThreadIndex() const
+{
+    return owner == this ? ownerIndex : 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Attach(uint slot)
+{
+    // as tarefas criadas pela thread ficam na sua fila e as esperas
+    // dela no executam tarefas que a thread principal acabou de criar;
+    // uma nova thread pode ocupar a fila de outra que j terminou
+    if (slot < external)
+    {
+        owner = this;
+        ownerIndex = count + slot;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Worker(uint thread)
+{
+    owner = this;
+    ownerIndex = thread;
+
+    Job job;
+
+    for (;;)
+    {
+        if (Take(thread, job))
+        {
+            Execute(thread, job);
+            continue;
+        }
+
+        // sem tarefas em nenhuma fila: dorme at uma nova insero
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        ++sleeping;
+        wake.wait(lock, [&] { return quit || queued.load() > 0; });
+        --sleeping;
+
+        if (quit)
+            return;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Push(Job && job)
+{
+    Queue & queue = queues[ThreadIndex()];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    ++queued;
+
+    // a trava garante que uma thread prestes a dormir veja a nova tarefa
+    if (sleeping.load() > 0)
+    {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool JobSystem::Take(uint thread, Job & job)
+{
+    if (queued.load() == 0)
+        return false;
+
+    // a prpria fila  usada como pilha: a tarefa mais recente primeiro
+    {
+        Queue & queue = queues[thread];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            --queued;
+            return true;
+        }
+    }
+
+    // rouba a tarefa mais antiga das outras filas; sem threads de trabalho,
+    // a principal e as registradas roubam umas das outras para no travar
+    uint total = count + external;
+    bool worker = thread > 0 && thread < count;
+
+    for (uint i = 1; i < total; ++i)
+    {
+        uint index = (thread + i) % total;
+
+        if (!worker && count > 1 && (index == 0 || index >= count))
+            continue;
+
+        Queue & victim = queues[index];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.jobs.empty())
+        {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            --queued;
+            ++counters[thread].steals;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Execute(uint thread, Job & job)
+{
+    auto start = std::chrono::steady_clock::now();
+    job.task();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    counters[thread].busy += ullong(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    ++counters[thread].jobs;
+
+    if (JobCounter * counter = job.counter)
+    {
+        vector<Job> released;
+
+        // a concluso acontece sob a trava: quem espera o contador
+        // s o descarta depois que esta thread deixou de us-lo
+        {
+            std::lock_guard<std::mutex> lock(counter->mutex);
+
+            if (--counter->pending == 0)
+                released.swap(counter->waiting);
+        }
+
+        for (Job & next : released)
+            Push(std::move(next));
+    }
+
+    job = Job();
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Run(std::function<void()> task, JobCounter * counter)
+{
+    if (counter)
+        ++counter->pending;
+
+    Push(Job { std::move(task), counter });
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Run(std::function<void()> task, JobCounter * counter, JobCounter & dependency)
+{
+    if (counter)
+        ++counter->pending;
+
+    Job job { std::move(task), counter };
+
+    // a tarefa espera no contador da dependncia at ele zerar
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+
+        if (dependency.pending.load() > 0)
+        {
+            dependency.waiting.push_back(std::move(job));
+            return;
+        }
+    }
+
+    Push(std::move(job));
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Wait(JobCounter & counter)
+{
+    uint thread = ThreadIndex();
+    Job job;
+
+    // a thread que espera executa tarefas em vez de bloquear
+    while (!counter.Done())
+    {
+        if (Take(thread, job))
+            Execute(thread, job);
+        else
+            std::this_thread::yield();
+    }
+
+    // a ltima thread a concluir pode ainda estar liberando a trava
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::ParallelFor(uint count, uint grain, const Range & range)
+{
+    if (grain == 0)
+        grain = 1;
+
+    // trabalho pequeno demais para dividir
+    if (count <= grain || this->count == 1)
+    {
+        if (count)
+            range(0, count);
+        return;
+    }
+
+    JobCounter counter;
+
+    for (uint begin = grain; begin < count; begin += grain)
+    {
+        uint end = (count - begin > grain) ? begin + grain : count;
+        Run([&range, begin, end] { range(begin, end); }, &counter);
+    }
+
+    // o primeiro intervalo fica com a thread que chamou
+    range(0, grain);
+    Wait(counter);
+}
+
+// -------------------------------------------------------------------------------
+
+JobStats JobSystem::Stats(uint thread) const
+{
+    JobStats stats;
+    stats.jobs = counters[thread].jobs.load();
+    stats.steals = counters[thread].steals.load();
+    stats.busy = counters[thread].busy.load() / 1e6;
+
+    double elapsed = (Now() - since.load()) / 1e6;
+    stats.utilization = elapsed > 0 ? stats.busy / elapsed : 0;
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::ResetStats()
+{
+    for (uint i = 0; i < count + external; ++i)
+    {
+        counters[i].jobs = 0;
+        counters[i].steals = 0;
+        counters[i].busy = 0;
+    }
+
+    since = Now();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/**********************************************************************************
+// Jobs (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Sistema de tarefas com roubo de trabalho. Cada thread tem sua
+//              prpria fila dupla: a dona insere e retira tarefas pelo final
+//              (a mais recente, ainda quente na cache) e as threads ociosas
+//              roubam pelo incio (a mais antiga, em geral a maior parte do
+//              trabalho restante). Contadores de dependncia indicam quando
+//              um grupo de tarefas terminou e podem liberar tarefas que
+//              dependem dele. A thread principal  a thread 0 e ajuda a
+//              executar tarefas enquanto espera um contador. Threads de fora
+//              do sistema, como a de renderizao, podem ser registradas com
+//              fila e estatsticas prprias; elas e a principal roubam apenas
+//              das threads de trabalho, no umas das outras.
+//
+**********************************************************************************/
+
+#ifndef DXUT_JOBS_H_
+#define DXUT_JOBS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using std::vector;
+
+class JobCounter;
+
+// -------------------------------------------------------------------------------
+
+struct JobStats
+{
+    uint   jobs = 0;                        // tarefas executadas pela thread
+    uint   steals = 0;                      // tarefas roubadas de outras threads
+    double busy = 0;                        // milissegundos executando tarefas
+    double utilization = 0;                 // frao do tempo executando tarefas
+};
+
+// -------------------------------------------------------------------------------
+
+struct Job
+{
+    std::function<void()> task;             // trabalho a executar
+    JobCounter * counter = nullptr;         // contador decrementado ao final
+};
+
+// -------------------------------------------------------------------------------
+
+class JobCounter
+{
+    friend class JobSystem;
+
+private:
+    std::atomic<uint> pending { 0 };        // tarefas ainda no concludas
+    std::mutex mutex;                       // protege a concluso e as dependentes
+    vector<Job> waiting;                    // tarefas liberadas quando o contador zerar
+
+public:
+    bool Done() const;                      // todas as tarefas do contador terminaram?
+};
+
+// -------------------------------------------------------------------------------
+
+class JobSystem
+{
+public:
+    using Range = std::function<void(uint begin, uint end)>;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;                   // protege a fila
+        std::deque<Job> jobs;               // dona usa o final, ladres o incio
+    };
+
+    struct Counters
+    {
+        std::atomic<uint> jobs { 0 };       // tarefas executadas
+        std::atomic<uint> steals { 0 };     // tarefas roubadas
+        std::atomic<ullong> busy { 0 };     // nanossegundos executando tarefas
+        char padding[48];                   // evita compartilhar a linha de cache
+    };
+
+    uint count;                             // threads, incluindo a principal
+    uint external;                          // filas reservadas para threads registradas
+    Queue * queues;                         // uma fila por thread
+    Counters * counters;                    // estatsticas por thread
+    vector<std::thread> threads;            // threads auxiliares (1 a count - 1)
+
+    std::atomic<uint> queued;               // tarefas nas filas
+    std::atomic<uint> sleeping;             // threads dormindo
+    std::mutex sleepMutex;                  // protege o sono das threads
+    std::condition_variable wake;           // acorda threads quando h tarefas
+    bool quit;                              // encerra as threads auxiliares
+    std::atomic<llong> since;               // incio das estatsticas (nanossegundos)
+
+    void Worker(uint thread);                       // lao das threads auxiliares
+    void Push(Job && job);                          // insere na fila da thread atual
+    bool Take(uint thread, Job & job);              // retira da prpria fila ou rouba
+    void Execute(uint thread, Job & job);           // executa e conclui uma tarefa
+
+public:
+    JobSystem(uint threads = std::thread::hardware_concurrency(), uint external = 1);
+    ~JobSystem();
+
+    void Attach(uint slot);                                                     // registra a thread atual em uma fila externa
+    void Run(std::function<void()> task, JobCounter * counter = nullptr);      // agenda uma tarefa
+    void Run(std::function<void()> task, JobCounter * counter,
+             JobCounter & dependency);                                          // agenda aps a dependncia
+    void Wait(JobCounter & counter);                                            // ajuda at o contador zerar
+
+    // divide [0, count) em intervalos de grain elementos e espera todos
+    void ParallelFor(uint count, uint grain, const Range & range);
+
+    uint Threads() const;                   // threads, incluindo a principal
+    uint Queues() const;                    // filas, incluindo as das threads registradas
+    uint ThreadIndex() const;               // ndice da thread atual (0 = principal)
+    JobStats Stats(uint thread) const;      // contagens e ocupao de uma thread
+    void ResetStats();                      // reinicia as contagens
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline bool JobCounter::Done() const
+{ return pending.load() == 0; }
+
+inline uint JobSystem::Threads() const
+{ return count; }
+
+inline uint JobSystem::Queues() const
+{ return count + external; }
+
+// -------------------------------------------------------------------------------
+
+#endif
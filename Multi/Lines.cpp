@@ -0,0 +1,156 @@
+/**********************************************************************************
+// Lines (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Desenho de linhas de depurao e de interface. Os segmentos so
+//              acumulados durante o quadro em um nico vertex buffer de upload,
+//              com uma regio para cada quadro em voo, e desenhados com uma s
+//              chamada LINELIST. As posies j chegam transformadas para o
+//              espao de recorte da tela inteira.
+//
+**********************************************************************************/
+
+#include "Lines.h"
+#include "Engine.h"
+
+// -------------------------------------------------------------------------------
+
+LineRenderer::LineRenderer(uint maxLines)
+{
+    maxVertices = maxLines * 2;
+    dropped = 0;
+    vertices.reserve(maxVertices);
+    ZeroMemory(&vertexBufferView, sizeof(D3D12_VERTEX_BUFFER_VIEW));
+
+    // cada quadro em voo escreve em sua prpria regio do buffer
+    Engine::graphics->Allocate(UPLOAD, maxVertices * sizeof(Vertex) * Graphics::FrameCount, &vertexUpload);
+
+    // as posies j esto no espao de recorte: a mesma identidade
+    // serve como matriz de mundo e como ViewProj, e a cor branca
+    // mantm a cor de cada segmento
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+    XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+
+    Engine::graphics->Allocate(CBUFFER, 256, &cbufferUpload);
+    memcpy(cbufferUpload.data, &identity, sizeof(XMFLOAT4X4));
+    memcpy(cbufferUpload.data + sizeof(XMFLOAT4X4), &white, sizeof(XMFLOAT4));
+
+    cbufferDescriptor = Engine::graphics->AllocateDescriptors(1);
+
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
+    cbvDesc.BufferLocation = cbufferUpload.Address();
+    cbvDesc.SizeInBytes = 256;
+    Engine::graphics->Device()->CreateConstantBufferView(&cbvDesc, Engine::graphics->CpuDescriptor(cbufferDescriptor));
+}
+
+// -------------------------------------------------------------------------------
+
+LineRenderer::~LineRenderer()
+{
+    Engine::graphics->Free(vertexUpload);
+    Engine::graphics->Free(cbufferUpload);
+    Engine::graphics->FreeDescriptors(cbufferDescriptor, 1);
+}
+
+// -------------------------------------------------------------------------------
+
+void LineRenderer::Line(const XMFLOAT3 & a, const XMFLOAT3 & b, const XMFLOAT4 & color)
+{
+    if (vertices.size() + 2 > maxVertices)
+    {
+        ++dropped;
+        return;
+    }
+
+    vertices.push_back({ a, color, XMFLOAT3(0, 0, 0) });
+    vertices.push_back({ b, color, XMFLOAT3(0, 0, 0) });
+}
+
+// -------------------------------------------------------------------------------
+
+void LineRenderer::Line(const XMFLOAT3 & a, const XMFLOAT3 & b, const XMFLOAT4 & color, FXMMATRIX transform)
+{
+    XMFLOAT3 ta, tb;
+    XMStoreFloat3(&ta, XMVector3TransformCoord(XMLoadFloat3(&a), transform));
+    XMStoreFloat3(&tb, XMVector3TransformCoord(XMLoadFloat3(&b), transform));
+    Line(ta, tb, color);
+}
+
+// -------------------------------------------------------------------------------
+
+void LineRenderer::Box(const XMFLOAT3 & c, const XMFLOAT3 & e, const XMFLOAT4 & color, FXMMATRIX transform)
+{
+    // oito cantos: o bit 0 escolhe x, o bit 1 escolhe y e o bit 2 escolhe z
+    XMFLOAT3 corners[8];
+    for (uint i = 0; i < 8; ++i)
+    {
+        corners[i].x = c.x + ((i & 1) ? e.x : -e.x);
+        corners[i].y = c.y + ((i & 2) ? e.y : -e.y);
+        corners[i].z = c.z + ((i & 4) ? e.z : -e.z);
+    }
+
+    // arestas ligam cantos que diferem em um nico bit
+    for (uint i = 0; i < 8; ++i)
+        for (uint bit = 1; bit < 8; bit <<= 1)
+            if (!(i & bit))
+                Line(corners[i], corners[i | bit], color, transform);
+}
+
+// -------------------------------------------------------------------------------
+
+void LineRenderer::Axes(FXMMATRIX transform, float size)
+{
+    XMFLOAT3 origin(0, 0, 0);
+    Line(origin, XMFLOAT3(size, 0, 0), XMFLOAT4(Colors::Red), transform);
+    Line(origin, XMFLOAT3(0, size, 0), XMFLOAT4(Colors::Lime), transform);
+    Line(origin, XMFLOAT3(0, 0, size), XMFLOAT4(Colors::Blue), transform);
+}
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX LineRenderer::ViewportTransform(const D3D12_VIEWPORT & view, float width, float height)
+{
+    // leva o intervalo [-1,1] da vista para o retngulo que ela ocupa na tela
+    float sx = view.Width / width;
+    float sy = view.Height / height;
+    float tx = (2.0f * view.TopLeftX + view.Width) / width - 1.0f;
+    float ty = 1.0f - (2.0f * view.TopLeftY + view.Height) / height;
+
+    return XMMatrixScaling(sx, sy, 1.0f) * XMMatrixTranslation(tx, ty, 0.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+void LineRenderer::Draw(ID3D12PipelineState * pso, ID3D12RootSignature * rootSignature, const D3D12_VIEWPORT & screen)
+{
+    if (vertices.empty())
+        return;
+
+    // copia os segmentos para a regio do quadro atual
+    uint frameOffset = Engine::graphics->FrameIndex() * maxVertices * sizeof(Vertex);
+    uint size = uint(vertices.size() * sizeof(Vertex));
+    memcpy(vertexUpload.data + frameOffset, vertices.data(), size);
+
+    vertexBufferView.BufferLocation = vertexUpload.Address() + frameOffset;
+    vertexBufferView.StrideInBytes = sizeof(Vertex);
+    vertexBufferView.SizeInBytes = size;
+
+    // todos os segmentos em uma nica chamada
+    ID3D12GraphicsCommandList * cmdList = Engine::graphics->CommandList();
+    cmdList->SetPipelineState(pso);
+    cmdList->SetGraphicsRootSignature(rootSignature);
+    cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+    cmdList->SetGraphicsRootDescriptorTable(0, Engine::graphics->GpuDescriptor(cbufferDescriptor));
+    cmdList->SetGraphicsRootConstantBufferView(1, cbufferUpload.Address());
+    cmdList->RSSetViewports(1, &screen);
+    cmdList->DrawInstanced(uint(vertices.size()), 1, 0, 0);
+
+    vertices.clear();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+/**********************************************************************************
+// Lines (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Desenho de linhas de depurao e de interface. Os segmentos so
+//              acumulados durante o quadro em um nico vertex buffer de upload,
+//              com uma regio para cada quadro em voo, e desenhados com uma s
+//              chamada LINELIST. As posies j chegam transformadas para o
+//              espao de recorte da tela inteira.
+//
+**********************************************************************************/
+
+#ifndef DXUT_LINES_H_
+#define DXUT_LINES_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Graphics.h"
+#include "Geometry.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+class LineRenderer
+{
+private:
+    Allocation vertexUpload;                                // vrtices de todos os quadros em voo
+    D3D12_VERTEX_BUFFER_VIEW vertexBufferView;              // descritor dos vrtices do quadro
+    vector<Vertex> vertices;                                // segmentos acumulados no quadro
+    uint maxVertices;                                       // capacidade de cada quadro
+    uint dropped;                                           // segmentos descartados por falta de espao
+
+    Allocation cbufferUpload;                               // constantes com a matriz identidade
+    uint cbufferDescriptor;                                 // descritor das constantes na heap global
+
+public:
+    LineRenderer(uint maxLines = 4096);                     // construtor
+    ~LineRenderer();                                        // destrutor
+
+    void Line(const XMFLOAT3 & a, const XMFLOAT3 & b,
+              const XMFLOAT4 & color);                      // segmento no espao de recorte
+    void Line(const XMFLOAT3 & a, const XMFLOAT3 & b,
+              const XMFLOAT4 & color, FXMMATRIX transform); // segmento transformado pela matriz
+    void Box(const XMFLOAT3 & center, const XMFLOAT3 & extents,
+             const XMFLOAT4 & color, FXMMATRIX transform);  // arestas de uma caixa alinhada
+    void Axes(FXMMATRIX transform, float size = 1.0f);      // eixos x, y e z
+
+    void Draw(ID3D12PipelineState * pso,
+              ID3D12RootSignature * rootSignature,
+              const D3D12_VIEWPORT & screen);               // desenha e esvazia os segmentos do quadro
+
+    uint Count() const;                                     // segmentos acumulados no quadro
+    uint Dropped() const;                                   // segmentos descartados
+
+    static XMMATRIX ViewportTransform(const D3D12_VIEWPORT & view,
+                                      float width, float height);   // recorte da vista para o da tela
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint LineRenderer::Count() const
+{ return uint(vertices.size() / 2); }
+
+inline uint LineRenderer::Dropped() const
+{ return dropped; }
+
+// -------------------------------------------------------------------------------
+
+#endif
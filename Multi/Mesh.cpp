@@ -16,40 +16,34 @@
 
 Mesh::Mesh()
 {
-    vertexBufferUpload = nullptr;
-    vertexBufferGPU = nullptr;
     ZeroMemory(&vertexBufferView, sizeof(D3D12_VERTEX_BUFFER_VIEW));
     vertexBufferSize = 0;
     vertexBufferStride = 0;
 
-    indexBufferUpload = nullptr;
-    indexBufferGPU = nullptr;
     ZeroMemory(&indexBufferView, sizeof(D3D12_INDEX_BUFFER_VIEW));
     indexBufferSize = 0;
     ZeroMemory(&indexFormat, sizeof(DXGI_FORMAT));
+    uploadFence = 0;
 
-    cbufferHeap = nullptr;
-    cbufferUpload = nullptr;
+    cbufferDescriptor = 0;
     cbufferData = nullptr;
-    cbufferDescriptorSize = 0;
+    cbufferCount = 0;
     cbufferElementSize = 0;
+    cbufferObjSize = 0;
+    cbufferObjects = 0;
 }
 
 // -------------------------------------------------------------------------------
 
 Mesh::~Mesh()
 {
-    if (vertexBufferUpload) vertexBufferUpload->Release();
-    if (vertexBufferGPU) vertexBufferGPU->Release();
-    if (indexBufferUpload) indexBufferUpload->Release();
-    if (indexBufferGPU) indexBufferGPU->Release();
+    // devolve os buffers aos pools de memria
+    Engine::graphics->Free(vertexBufferGPU);
+    Engine::graphics->Free(indexBufferGPU);
+    Engine::graphics->Free(cbufferUpload);
 
-    if (cbufferUpload)
-    {
-        cbufferUpload->Unmap(0, nullptr);
-        cbufferUpload->Release();
-        cbufferHeap->Release();
-    }
+    if (cbufferCount)
+        Engine::graphics->FreeDescriptors(cbufferDescriptor, cbufferCount);
 }
 
 // -------------------------------------------------------------------------------
@@ -61,11 +55,10 @@ void Mesh::VertexBuffer(const void* vb, uint vbSize, uint vbStride)
     vertexBufferStride = vbStride;
 
     // aloca recursos para o vertex buffer
-    Engine::graphics->Allocate(UPLOAD, vbSize, &vertexBufferUpload);
     Engine::graphics->Allocate(GPU, vbSize, &vertexBufferGPU);
 
-    // copia vrtices para o buffer da GPU usando o buffer de Upload
-    Engine::graphics->Copy(vb, vbSize, vertexBufferUpload, vertexBufferGPU);
+    // agenda cpia dos vrtices na fila de cpia usando o buffer circular de upload
+    uploadFence = Engine::graphics->Copy(vb, vbSize, vertexBufferGPU);
 }
 
 // -------------------------------------------------------------------------------
@@ -77,11 +70,10 @@ void Mesh::IndexBuffer(const void* ib, uint ibSize, DXGI_FORMAT ibFormat)
     indexFormat = ibFormat;
 
     // aloca recursos para o index buffer
-    Engine::graphics->Allocate(UPLOAD, ibSize, &indexBufferUpload);
     Engine::graphics->Allocate(GPU, ibSize, &indexBufferGPU);
 
-    // copia ndices para o buffer da GPU usando o buffer de Upload
-    Engine::graphics->Copy(ib, ibSize, indexBufferUpload, indexBufferGPU);
+    // agenda cpia dos ndices na fila de cpia usando o buffer circular de upload
+    uploadFence = Engine::graphics->Copy(ib, ibSize, indexBufferGPU);
 }
 
 // -------------------------------------------------------------------------------
@@ -95,43 +87,37 @@ void Mesh::ConstantBuffer(uint objSize, uint objCount)
     // o tamanho dos constant buffers precisam ser mltiplos 
     // do tamanho de alocao mnima do hardware (256 bytes)
     cbufferElementSize = (objSize + 255) & ~255;
+    cbufferObjSize = objSize;
+    cbufferObjects = objCount;
+    cbufferWritten.assign(objCount, 0);
 
-    // aloca recursos para o constant buffer
-    Engine::graphics->Allocate(CBUFFER, cbufferElementSize * objCount, &cbufferUpload);
-
-    // mapeia memria do upload buffer para um endereo acessvel pela CPU
-    cbufferUpload->Map(0, nullptr, reinterpret_cast<void**>(&cbufferData));
+    // cada quadro em voo tem sua prpria cpia das constantes para que
+    // a CPU possa atualiz-las enquanto a GPU l as dos quadros anteriores
+    uint total = objCount * Graphics::FrameCount;
 
-    // ----------------
-    // Descriptor Heaps 
-    // ----------------
+    // aloca recursos para o constant buffer
+    Engine::graphics->Allocate(CBUFFER, cbufferElementSize * total, &cbufferUpload);
 
-    // descritor do buffer constante
-    D3D12_DESCRIPTOR_HEAP_DESC cbHeapDesc = {};
-    cbHeapDesc.NumDescriptors = objCount;
-    cbHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    cbHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    // a heap de upload fica mapeada: basta guardar o endereo na CPU
+    cbufferData = cbufferUpload.data;
 
-    // cria heap de descritores para buffer constante
-    Engine::graphics->Device()->CreateDescriptorHeap(
-        &cbHeapDesc, 
-        IID_PPV_ARGS(&cbufferHeap));
+    // -----------
+    // Descritores 
+    // -----------
 
-    // tamanho de um descritor de constant buffer
-    cbufferDescriptorSize = 
-        Engine::graphics->Device()->GetDescriptorHandleIncrementSize(
-            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    // reserva um descritor para cada objeto em cada quadro na heap global
+    cbufferCount = total;
+    cbufferDescriptor = Engine::graphics->AllocateDescriptors(total);
 
     // precisa de um descritor para cada objeto
-    for (uint i = 0; i < objCount; ++i)
+    for (uint i = 0; i < total; ++i)
     {
         // desloca para o endereo do i-simo objeto no buffer constante
-        D3D12_GPU_VIRTUAL_ADDRESS cbAddress = cbufferUpload->GetGPUVirtualAddress();
+        D3D12_GPU_VIRTUAL_ADDRESS cbAddress = cbufferUpload.Address();
         cbAddress += i * cbufferElementSize;
 
-        // desloca para o endereo do i-simo objeto na heap de descritores
-        D3D12_CPU_DESCRIPTOR_HANDLE handle = cbufferHeap->GetCPUDescriptorHandleForHeapStart();
-        handle.ptr += i * cbufferDescriptorSize;
+        // descritor do i-simo objeto na heap global
+        D3D12_CPU_DESCRIPTOR_HANDLE handle = Engine::graphics->CpuDescriptor(cbufferDescriptor + i);
 
         // informaes do constant buffer
         D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
@@ -147,14 +133,29 @@ void Mesh::ConstantBuffer(uint objSize, uint objCount)
 
 void Mesh::CopyConstants(const void* cbData, uint cbIndex)
 {
-    memcpy(cbufferData + (cbIndex * cbufferElementSize), cbData, cbufferElementSize);
+    // a primeira cpia preenche todos os quadros, para objetos 
+    // cujas constantes no so atualizadas a cada quadro
+    if (!cbufferWritten[cbIndex])
+    {
+        for (uint f = 0; f < Graphics::FrameCount; ++f)
+            memcpy(cbufferData + ((f * cbufferObjects + cbIndex) * cbufferElementSize), cbData, cbufferObjSize);
+
+        cbufferWritten[cbIndex] = 1;
+        return;
+    }
+
+    uint slot = Engine::graphics->FrameIndex() * cbufferObjects + cbIndex;
+    memcpy(cbufferData + (slot * cbufferElementSize), cbData, cbufferObjSize);
 }
 
 // -------------------------------------------------------------------------------
 
 D3D12_VERTEX_BUFFER_VIEW* Mesh::VertexBufferView()
 {
-    vertexBufferView.BufferLocation = vertexBufferGPU->GetGPUVirtualAddress();
+    // o desenho s pode ler os vrtices depois da cpia
+    Engine::graphics->UseUpload(uploadFence);
+
+    vertexBufferView.BufferLocation = vertexBufferGPU.Address();
     vertexBufferView.StrideInBytes = vertexBufferStride;
     vertexBufferView.SizeInBytes = vertexBufferSize;
 
@@ -165,7 +166,10 @@ D3D12_VERTEX_BUFFER_VIEW* Mesh::VertexBufferView()
 
 D3D12_INDEX_BUFFER_VIEW * Mesh::IndexBufferView()
 {
-    indexBufferView.BufferLocation = indexBufferGPU->GetGPUVirtualAddress();
+    // o desenho s pode ler os ndices depois da cpia
+    Engine::graphics->UseUpload(uploadFence);
+
+    indexBufferView.BufferLocation = indexBufferGPU.Address();
     indexBufferView.Format = indexFormat;
     indexBufferView.SizeInBytes = indexBufferSize;
 
@@ -174,18 +178,16 @@ D3D12_INDEX_BUFFER_VIEW * Mesh::IndexBufferView()
 
 // -------------------------------------------------------------------------------
 
-ID3D12DescriptorHeap* Mesh::ConstantBufferHeap()
+uint Mesh::ConstantBufferDescriptor(uint cbIndex)
 {
-    return cbufferHeap;
+    return cbufferDescriptor + Engine::graphics->FrameIndex() * cbufferObjects + cbIndex;
 }
 
 // -------------------------------------------------------------------------------
 
 D3D12_GPU_DESCRIPTOR_HANDLE Mesh::ConstantBufferHandle(uint cbIndex)
 {
-    D3D12_GPU_DESCRIPTOR_HANDLE handle = cbufferHeap->GetGPUDescriptorHandleForHeapStart();
-    handle.ptr += cbIndex * cbufferDescriptorSize;
-    return handle;
+    return Engine::graphics->GpuDescriptor(ConstantBufferDescriptor(cbIndex));
 }
 
 // -------------------------------------------------------------------------------
@@ -18,7 +18,9 @@
 #include "Graphics.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
 using std::unordered_map;
+using std::vector;
 using std::string;
 
 // -------------------------------------------------------------------------------
@@ -35,23 +37,25 @@ struct SubMesh
 class Mesh
 {
 private:
-    ID3D12Resource* vertexBufferUpload;                                     // buffer de Upload CPU -> GPU
-    ID3D12Resource* vertexBufferGPU;                                        // buffer na GPU
+    Allocation vertexBufferGPU;                                             // buffer na GPU
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView;                              // descritor do buffer de vrtices
     uint vertexBufferSize;                                                  // tamanho do buffer de vrtices
     uint vertexBufferStride;                                                // tamanho de um vrtice
                                                                             
-    ID3D12Resource* indexBufferUpload;                                      // buffer de Upload CPU -> GPU
-    ID3D12Resource* indexBufferGPU;                                         // buffers na GPU
+    Allocation indexBufferGPU;                                              // buffers na GPU
     D3D12_INDEX_BUFFER_VIEW indexBufferView;                                // descritor do buffer de ndices
     uint indexBufferSize;                                                   // tamanho do buffer de ndices
     DXGI_FORMAT indexFormat;                                                // formato do buffer de ndices
+    ullong uploadFence;                                                     // cerca do lote de cpia dos buffers
                                                                             
-    ID3D12DescriptorHeap* cbufferHeap;                                      // heap de descritores do buffer constante
-    ID3D12Resource* cbufferUpload;                                          // buffer de Upload CPU -> GPU
+    uint cbufferDescriptor;                                                 // primeiro descritor na heap global
+    Allocation cbufferUpload;                                               // buffer de Upload CPU -> GPU
     byte* cbufferData;                                                      // buffer na CPU
-    uint cbufferDescriptorSize;                                             // tamanho do descritor 
+    uint cbufferCount;                                                      // nmero de descritores reservados
     uint cbufferElementSize;                                                // tamanho de um elemento no buffer 
+    uint cbufferObjSize;                                                    // tamanho dos dados de um objeto
+    uint cbufferObjects;                                                    // nmero de objetos por quadro
+    vector<byte> cbufferWritten;                                            // objetos j copiados em todos os quadros
                                                                             
 public:                                                                     
     unordered_map<string, SubMesh> SubMesh;                                 // uma malha pode armazenar mltiplas sub-malhas
@@ -66,7 +70,7 @@ public:
 
     D3D12_VERTEX_BUFFER_VIEW * VertexBufferView();                          // retorna descritor (view) do Vertex Buffer
     D3D12_INDEX_BUFFER_VIEW * IndexBufferView();                            // retorna descritor (view) do Index Buffer
-    ID3D12DescriptorHeap* ConstantBufferHeap();                             // retorna heap de descritores
+    uint ConstantBufferDescriptor(uint cbIndex = 0);                        // retorna ndice de um descritor na heap global
     D3D12_GPU_DESCRIPTOR_HANDLE ConstantBufferHandle(uint cbIndex = 0);     // retorna handle de um descritor
 };
 
@@ -16,59 +16,137 @@
 
 using namespace std;
 
-struct ObjData {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-};
-
 // ------------------------------------------------------------------------------
 struct ObjectConstants
 {
-    XMFLOAT4X4 WorldViewProj =
+    XMFLOAT4X4 World =
     { 1.0f, 0.0f, 0.0f, 0.0f,
       0.0f, 1.0f, 0.0f, 0.0f,
       0.0f, 0.0f, 1.0f, 0.0f,
       0.0f, 0.0f, 0.0f, 1.0f };
 
-    //XMFLOAT4 color;
+    XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+// constantes de uma vista, compartilhadas por todos os objetos
+struct ViewConstants
+{
+    XMFLOAT4X4 ViewProj;
+};
+
+// ------------------------------------------------------------------------------
+
+// dados de desenho de um objeto, lidos na atualizao: as views das malhas
+// registram no Graphics o uso dos uploads; a tabela de constantes depende
+// do quadro em gravao e  obtida da malha na renderizao
+struct DrawData
+{
+    D3D12_VERTEX_BUFFER_VIEW vertexView;
+    D3D12_INDEX_BUFFER_VIEW indexView;
+    Mesh* mesh;
+    SubMesh submesh;
+    XMFLOAT3 center;    // centro do volume no mundo (profundidade na fila)
+};
+
+// constantes alteradas de um objeto, copiadas pela renderizao
+struct ConstantsCopy
+{
+    Mesh* mesh;         // nullptr se o objeto no mudou
+    ObjectConstants constants;
+};
+
+// ------------------------------------------------------------------------------
+
+// layout dos vrtices usado por todos os pipelines
+const D3D12_INPUT_ELEMENT_DESC VertexLayout[2] =
+{
+    { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+};
+
+// ------------------------------------------------------------------------------
+
+// vistas na ordem de desenho do modo quadview
+enum Views { FRONT, TOP, RIGHT, PERSPECTIVE, VIEWS };
+
+// tudo o que a renderizao de um quadro l: a atualizao do quadro
+// seguinte escreve na outra cpia enquanto esta  desenhada
+struct FrameSnapshot
+{
+    vector<Camera> cameras;                       // cmeras, projees e viewports
+    uint firstView = PERSPECTIVE;                 // primeira vista desenhada
+    bool quadView = false;                        // desenha os separadores das vistas
+    bool pipelined = false;                       // desenhado em paralelo com a atualizao
+    ID3D12PipelineState* pipeline = nullptr;      // preenchido ou wireframe
+    vector<uint> drawLists[VIEWS];                // objetos visveis e no escondidos
+    vector<DrawData> drawData;                    // buffers dos objetos visveis
+    vector<ConstantsCopy> constants;              // constantes por objeto da cena
+    vector<Mesh*> meshes;                         // malhas removidas no quadro
+    vector<Tessellation*> tessellations;          // tesselaes removidas no quadro
 };
 
+// a partir deste nmero de objetos o descarte percorre a BVH
+const uint HierarchyObjects = 64;
+
+// objetos atualizados por tarefa no lao de constantes
+const uint ObjectGrain = 256;
+
+// objetos tesselados previstos: cada um reserva um descritor por
+// quadro em voo em cada variante, e a heap global  dimensionada por eles
+const uint MaxObjects = 50000;
+
+// bytes de um arquivo OBJ lidos por tarefa na importao
+const uint ObjChunkSize = 256 * 1024;
+
+// oclusores: objetos grandes no mundo com malhas baratas de rasterizar na CPU
+const float OccluderRadius = 0.75f;
+const uint MaxOccluderTriangles = 20000;
+
+// o objeto deve ser rasterizado no buffer de ocluso?
+bool IsOccluder(const Object& obj, const Bounds& world)
+{
+    return obj.pick && obj.pick->Triangles() <= MaxOccluderTriangles && world.radius >= OccluderRadius;
+}
+
 // ------------------------------------------------------------------------------
 
 class Multi : public App
 {
 private:
+    PipelineCache* pipelines = nullptr;           // dono das assinaturas e pipelines
     ID3D12RootSignature* rootSignature = nullptr;
     ID3D12PipelineState* pipelineState = nullptr;
-    vector<Object> scene;
-    vector<Object> sceneTopEsq;
-    vector<Object> sceneTopDir;
-    vector<Object> sceneBaixEsq;
-    vector<Object> lines;
-    vector<Object> lines2;
+    ID3D12PipelineState* linePipeline = nullptr;    // linhas sem profundidade
+    LineRenderer* overlay = nullptr;               // linhas desenhadas sobre as vistas
+    SlotMap<Object> scene;                        // objetos compartilhados por todas as vistas
+    FrustumCuller culler;                         // objetos visveis em cada vista
+    Bvh bvh;                                      // hierarquia de volumes da cena
+    SceneGraph graph;                             // transformaes locais e agrupamento dos objetos
+    vector<Handle> objectOf;                      // objeto de cada n da hierarquia
+    Handle previous;                              // selecionado antes do atual (pai ao agrupar)
+    OcclusionBuffer occlusion[VIEWS];             // profundidade dos oclusores em cada vista
+    FrameSnapshot snapshots[FrameHandoff::Slots]; // quadro em atualizao e quadro em desenho
+    RenderQueue renderQueues[VIEWS];              // desenhos de cada vista ordenados por estado
+    ParallelRecorder* recorder = nullptr;         // grava as vistas em paralelo
+    bool occlusionCulling = false;                // descarte por ocluso (s faz sentido sem wireframe)
+    Timer reportTimer;                            // intervalo entre relatrios de ocluso
+    Timer drawReportTimer;                        // intervalo entre relatrios de desenho e memria
+    Allocation viewConstants;                     // ViewProj de cada vista em cada quadro
+    vector<Camera> cameras;                       // vistas: cmera, projeo e viewport
+    uint firstView = PERSPECTIVE;                 // primeira vista desenhada no quadro
 
 
     Timer timer;
     bool quadViewMode = false; // controlar o modo Quadview
 
-    bool isObjectSelected = false; // Varivel para rastrear se um objeto est selecionado
-    bool increasingScale = true; // Indica se a escala est aumentando ou diminuindo na animao de pulsao
-
-    XMFLOAT4X4 Identity = {};
-    XMFLOAT4X4 View = {};
-    XMFLOAT4X4 Proj = {};
     XMFLOAT4 currentColor = XMFLOAT4(DirectX::Colors::DimGray);
+    XMFLOAT4 highlightColor = XMFLOAT4(DirectX::Colors::Orange);  // cor do objeto selecionado
+    Handle highlighted;                                             // objeto desenhado com destaque
 
-    D3D12_VIEWPORT viewFront, viewTop, viewRight, viewPerspective; // QuadView
-    D3D12_VIEWPORT lineVview, lineHview; // QuadView
-
-    Object lineV;
-    Object lineH;
+    D3D12_VIEWPORT viewPerspective; // QuadView
+    D3D12_VIEWPORT viewScreen; // tela inteira (linhas de separao)
 
-    Mesh* perspective = nullptr;
-    Mesh* ortographic = nullptr;
-    bool wireframeMode = true;
-    int wireframeModes = 0;
+    bool adaptiveTess = true;   // tesselao de esferas e cilindros pelo tamanho na tela
 
     float theta = 0;
     float phi = 0;
@@ -76,8 +154,8 @@ private:
     float lastMousePosX = 0;
     float lastMousePosY = 0;
 
-    // Varivel global para rastrear o ndice do objeto selecionado
-    int selectedIndex = 0;
+    // objeto selecionado: o handle fica obsoleto quando o objeto  removido
+    Handle selected;
 
 public:
     void Init();
@@ -86,31 +164,36 @@ public:
     void Finalize();
     Geometry LoadOBJ(const std::string& filename);
     void CalculateNormals(Geometry& objData);
+    void Tessellate(Object& obj);
+    void AddObject(Geometry& geo, FXMMATRIX world, const XMFLOAT4& color = XMFLOAT4(DirectX::Colors::DimGray));
+    void AddObject(const TessDesc& desc, FXMMATRIX world);
+    Object* Selected();
+    int Pick(float x, float y);
+    uint ViewSlot(uint view);
+    void RecordView(const FrameSnapshot& frame, uint view, CommandStream& commands);
+    void UploadTessellations();
     void BuildRootSignature();
     void BuildPipelineState();
-    void BuildPipelineStateFront();
-    void BuildPipelineStateNone();
+    void BuildLinePipeline();
 };
 
 // ------------------------------------------------------------------------------
 
-Geometry Multi::LoadOBJ(const std::string& filename) {
-    Geometry objData;
-    std::ifstream file(filename);
-
-    if (!file.is_open()) {
-        std::cerr << "Failed to open OBJ file: " << filename << std::endl;
-        return objData;
-    }
-
-    std::string line;
+// dados de um trecho do arquivo OBJ, lidos por uma tarefa
+struct ObjChunk
+{
     std::vector<XMFLOAT3> positions;
     std::vector<XMFLOAT3> normals;
     std::vector<XMFLOAT2> texCoords;  // Para armazenar coordenadas de textura, se houver
+    std::vector<uint> indices;
+};
 
-    bool hasNormals = false;
+// interpreta as linhas completas de um trecho do arquivo
+static void ParseOBJ(const char* begin, const char* end, ObjChunk& chunk) {
+    std::istringstream text(std::string(begin, end));
+    std::string line;
 
-    while (std::getline(file, line)) {
+    while (std::getline(text, line)) {
         std::istringstream iss(line);
         std::string prefix;
         iss >> prefix;
@@ -119,20 +202,19 @@ Geometry Multi::LoadOBJ(const std::string& filename) {
             // Vrtices (posies)
             XMFLOAT3 position;
             iss >> position.x >> position.y >> position.z;
-            positions.push_back(position);
+            chunk.positions.push_back(position);
         }
         else if (prefix == "vn") {
             // Normais
             XMFLOAT3 normal;
             iss >> normal.x >> normal.y >> normal.z;
-            normals.push_back(normal);
-            hasNormals = true;
+            chunk.normals.push_back(normal);
         }
         else if (prefix == "vt") {
             // Coordenadas de textura
             XMFLOAT2 texCoord;
             iss >> texCoord.x >> texCoord.y;
-            texCoords.push_back(texCoord);
+            chunk.texCoords.push_back(texCoord);
         }
         else if (prefix == "f") {
             // Faces (ndices de vrtices)
@@ -160,13 +242,56 @@ Geometry Multi::LoadOBJ(const std::string& filename) {
                 faceStream >> v[0] >> v[1] >> v[2];
             }
 
-            objData.indices.push_back(v[0] - 1);
-            objData.indices.push_back(v[1] - 1);
-            objData.indices.push_back(v[2] - 1);
+            chunk.indices.push_back(v[0] - 1);
+            chunk.indices.push_back(v[1] - 1);
+            chunk.indices.push_back(v[2] - 1);
         }
     }
+}
+
+Geometry Multi::LoadOBJ(const std::string& filename) {
+    Geometry objData;
+    std::ifstream file(filename);
+
+    if (!file.is_open()) {
+        std::cerr << "Failed to open OBJ file: " << filename << std::endl;
+        return objData;
+    }
+
+    // o arquivo inteiro  lido de uma vez e dividido em trechos
+    // terminados em fim de linha, interpretados em paralelo
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<size_t> bounds = { 0 };
+
+    while (bounds.back() < content.size()) {
+        size_t next = bounds.back() + ObjChunkSize;
+        next = (next < content.size()) ? content.find('\n', next) : std::string::npos;
+        bounds.push_back(next == std::string::npos ? content.size() : next + 1);
+    }
+
+    uint chunkCount = uint(bounds.size()) - 1;
+    std::vector<ObjChunk> chunks(chunkCount);
+
+    jobs->ParallelFor(chunkCount, 1, [&](uint begin, uint end) {
+        for (uint c = begin; c < end; ++c)
+            ParseOBJ(content.data() + bounds[c], content.data() + bounds[c + 1], chunks[c]);
+    });
+
+    // os ndices das faces so absolutos: os trechos so unidos na ordem do arquivo
+    std::vector<XMFLOAT3> positions;
+    std::vector<XMFLOAT3> normals;
+
+    for (auto& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        objData.indices.insert(objData.indices.end(), chunk.indices.begin(), chunk.indices.end());
+    }
+
+    bool hasNormals = !normals.empty();
 
     // Processa os vrtices e aplica normais se existirem
+    objData.vertices.reserve(positions.size());
+
     for (size_t i = 0; i < positions.size(); ++i) {
         Vertex vertex;
         vertex.pos = positions[i];
@@ -204,70 +329,45 @@ void Multi::Init()
     lastMousePosX = (float)input->MouseX();
     lastMousePosY = (float)input->MouseY();
 
-    // inicializa as matrizes Identity e View para a identidade
-    Identity = View = {
-        1.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 1.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 1.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f };
+    // uma cmera para cada vista
+    cameras.resize(VIEWS);
 
     // inicializa a matriz de projeo
-    XMStoreFloat4x4(&Proj, XMMatrixPerspectiveFovLH(
+    XMStoreFloat4x4(&cameras[PERSPECTIVE].proj, XMMatrixPerspectiveFovLH(
         XMConvertToRadians(45.0f),
         window->AspectRatio(),
         1.0f, 100.0f));
 
+    // vistas ortogrficas fixas
+    XMMATRIX projOrtho = XMMatrixOrthographicLH(10, 10, 1.0f, 100.0f);
+    XMVECTOR target = XMVectorZero();
+
+    XMStoreFloat4x4(&cameras[FRONT].view, XMMatrixLookAtLH(
+        XMVectorSet(0.0f, 0.0f, 2.0f, 1.0f), target, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+    XMStoreFloat4x4(&cameras[TOP].view, XMMatrixLookAtLH(
+        XMVectorSet(5.0f, 0.0f, 0.0f, 1.0f), target, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+    XMStoreFloat4x4(&cameras[RIGHT].view, XMMatrixLookAtLH(
+        XMVectorSet(0.0f, 4.0f, 0.0f, 1.0f), target, XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f)));
+
+    for (uint v = FRONT; v < PERSPECTIVE; ++v)
+    {
+        XMStoreFloat4x4(&cameras[v].proj, projOrtho);
+        XMStoreFloat4x4(&cameras[v].viewProj, XMLoadFloat4x4(&cameras[v].view) * projOrtho);
+    }
+
     // Criao da Geometria padro = grid
 
     Grid grid(3.0f, 3.0f, 20, 20);
 
-    for (auto& v : grid.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-
     // ---------------------------------------------------------------
     // Alocao e Cpia de Vertex, Index e Constant Buffers para a GPU
     // ---------------------------------------------------------------
 
-    // grid
-    Object gridObj;
-    gridObj.mesh = new Mesh();
-    gridObj.world = Identity;
-    gridObj.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObj.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-    gridObj.submesh.indexCount = grid.IndexCount();
-    scene.push_back(gridObj);
-
-    // grid top left
-    Object gridObj1;
-    gridObj1.mesh = new Mesh();
-    gridObj1.world = Identity;
-    gridObj1.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObj1.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObj1.mesh->ConstantBuffer(sizeof(ObjectConstants));
-    gridObj1.submesh.indexCount = grid.IndexCount();
-    sceneTopEsq.push_back(gridObj1);
-
-    // grid top righ
-    Object gridObj2;
-    gridObj2.mesh = new Mesh();
-    gridObj2.world = Identity;
-    gridObj2.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObj2.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-    gridObj2.submesh.indexCount = grid.IndexCount();
-    sceneTopDir.push_back(gridObj2);
-
-    // grid
-    Object gridObj3;
-    gridObj3.mesh = new Mesh();
-    gridObj3.world = Identity;
-    gridObj3.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObj3.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-    gridObj3.submesh.indexCount = grid.IndexCount();
-    sceneBaixEsq.push_back(gridObj3);
+    // grid compartilhado por todas as vistas
+    AddObject(grid, XMMatrixIdentity());
 
     // Configurao da viewport para a visualizao frontal => topo esquerda 
+    D3D12_VIEWPORT& viewFront = cameras[FRONT].viewport;
     viewFront.TopLeftX = 0.0f;
     viewFront.TopLeftY = 0.0f;
     viewFront.Width = float(window->Width() / 2);
@@ -276,6 +376,7 @@ void Multi::Init()
     viewFront.MaxDepth = 1.0f;
 
     // Configurao da viewport para a visualizao superior => esquerda abaixo
+    D3D12_VIEWPORT& viewTop = cameras[TOP].viewport;
     viewTop.TopLeftX = 0.0f;
     viewTop.TopLeftY = float(window->Height() / 2);
     viewTop.Width = float(window->Width() / 2);
@@ -284,6 +385,7 @@ void Multi::Init()
     viewTop.MaxDepth = 1.0f;
 
     // Configurao da viewport para a visualizao da direita => topo direita
+    D3D12_VIEWPORT& viewRight = cameras[RIGHT].viewport;
     viewRight.TopLeftX = float(window->Width() / 2);
     viewRight.TopLeftY = 0.0f;
     viewRight.Width = float(window->Width() / 2);
@@ -300,36 +402,43 @@ void Multi::Init()
     viewPerspective.MaxDepth = 1.0f;
 
 
-    lineVview.TopLeftX = float(window->Width() / 2); // Define a coordenada X no meio da tela
-    lineVview.TopLeftY = 0.0f; // Define a coordenada Y inicial (neste exemplo, 0)
-    lineVview.Width = 1.0f; // Define a largura como 1 (1 pixel de largura)
-    lineVview.Height = float(window->Height()); // Define a altura para cobrir a altura inteira da tela
-    lineVview.MinDepth = 0.0f; // Profundidade mnima
-    lineVview.MaxDepth = 1.0f; // Profundidade mxima
-
-    lineHview.TopLeftX = 0.0f; // Define a coordenada X inicial (neste exemplo, 0)
-    lineHview.TopLeftY = float(window->Height() / 2); // Define a coordenada Y no meio da tela
-    lineHview.Width = float(window->Width()); // Define a largura para cobrir a largura inteira da tela
-    lineHview.Height = 1.0f; // Define a altura como 1 (1 pixel de altura)
-    lineHview.MinDepth = 0.0f; // Profundidade mnima
-    lineHview.MaxDepth = 1.0f; // Profundidade mxima
+    // Viewport da tela inteira, usada pelas linhas de separao
+    viewScreen.TopLeftX = 0.0f;
+    viewScreen.TopLeftY = 0.0f;
+    viewScreen.Width = float(window->Width());
+    viewScreen.Height = float(window->Height());
+    viewScreen.MinDepth = 0.0f;
+    viewScreen.MaxDepth = 1.0f;
 
 
     // ---------------------------------------
 
+    pipelines = new PipelineCache(graphics->Device(), "Shaders/Pipelines.cache");
     BuildRootSignature();
     BuildPipelineState();
+    BuildLinePipeline();
+
+    overlay = new LineRenderer();
+    recorder = new ParallelRecorder(jobs);
+
+    // constantes das vistas: uma regio por quadro em voo
+    graphics->Allocate(CBUFFER, 256 * VIEWS * Graphics::FrameCount, &viewConstants);
 
     // ---------------------------------------
     graphics->SubmitCommands();
 
     timer.Start();
+    reportTimer.Start();
+    drawReportTimer.Start();
 }
 
 // ------------------------------------------------------------------------------
 
 void Multi::Update()
 {
+    // cpia livre: a renderizao pode estar lendo a outra
+    FrameSnapshot& frame = snapshots[handoff->UpdateSlot()];
+
     // sai com o pressionamento da tecla ESC
     if (input->KeyPress(VK_ESCAPE)) {
         window->Close();
@@ -348,415 +457,69 @@ void Multi::Update()
     }
     */
 
-    //Quad
+    // Quad
     if (input->KeyPress('Q'))
     {
-        graphics->ResetCommands();
         Quad quad(2.0f, 2.0f);
 
-        for (auto& v : quad.vertices) v.color = currentColor;
-        Object quadObj;
-
-        //posies do init
-        XMStoreFloat4x4(&quadObj.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        quadObj.mesh = new Mesh();
-        quadObj.mesh->VertexBuffer(quad.VertexData(), quad.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        quadObj.mesh->IndexBuffer(quad.IndexData(), quad.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        quadObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        quadObj.submesh.indexCount = quad.IndexCount();
-        scene.push_back(quadObj);
-
-        Object quadObj2;
-
-        //posies do init
-        XMStoreFloat4x4(&quadObj2.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        quadObj2.mesh = new Mesh();
-        quadObj2.mesh->VertexBuffer(quad.VertexData(), quad.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        quadObj2.mesh->IndexBuffer(quad.IndexData(), quad.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        quadObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        quadObj2.submesh.indexCount = quad.IndexCount();
-        sceneBaixEsq.push_back(quadObj2);
-
-        Object quadObj3;
-
-        //posies do init
-        XMStoreFloat4x4(&quadObj3.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        quadObj3.mesh = new Mesh();
-        quadObj3.mesh->VertexBuffer(quad.VertexData(), quad.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        quadObj3.mesh->IndexBuffer(quad.IndexData(), quad.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        quadObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        quadObj3.submesh.indexCount = quad.IndexCount();
-        sceneTopEsq.push_back(quadObj3);
-
-        Object quadObj4;
-
-        //posies do init
-        XMStoreFloat4x4(&quadObj4.world,
+        AddObject(quad,
             XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-        quadObj4.mesh = new Mesh();
-        quadObj4.mesh->VertexBuffer(quad.VertexData(), quad.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        quadObj4.mesh->IndexBuffer(quad.IndexData(), quad.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        quadObj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        quadObj4.submesh.indexCount = quad.IndexCount();
-        sceneTopDir.push_back(quadObj4);
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
-
+            XMMatrixTranslation(0.0f, 0.5f, 0.0f),
+            currentColor);
     }
 
     // Box
     if (input->KeyPress('B')) {
-        graphics->ResetCommands();
-
         Box box(2.0f, 2.0f, 2.0f);
-        for (auto& v : box.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-        Object boxObj;
-
-        //posies do init
-        //XMStoreFloat4x4(&boxObj.world,
-        //XMMatrixScaling(0.4f, 0.4f, 0.4f)*
-          //  XMMatrixTranslation(-1.0f, 0.41f, 1.0f));
-
-        XMStoreFloat4x4(&boxObj.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-
-        boxObj.mesh = new Mesh();
-        boxObj.mesh->VertexBuffer(box.VertexData(), box.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        boxObj.mesh->IndexBuffer(box.IndexData(), box.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        boxObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        boxObj.submesh.indexCount = box.IndexCount();
-        scene.push_back(boxObj);
-
-        Object boxObj2;
-        // colocar isso aqui vindo do mouse
-        XMStoreFloat4x4(&boxObj2.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        boxObj2.mesh = new Mesh();
-        boxObj2.mesh->VertexBuffer(box.VertexData(), box.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        boxObj2.mesh->IndexBuffer(box.IndexData(), box.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        boxObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        boxObj2.submesh.indexCount = box.IndexCount();
-        sceneBaixEsq.push_back(boxObj2);
 
-        Object boxObj3;
-        // colocar isso aqui vindo do mouse
-        XMStoreFloat4x4(&boxObj3.world,
+        AddObject(box,
             XMMatrixScaling(0.4f, 0.4f, 0.4f) *
             XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        boxObj3.mesh = new Mesh();
-        boxObj3.mesh->VertexBuffer(box.VertexData(), box.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        boxObj3.mesh->IndexBuffer(box.IndexData(), box.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        boxObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        boxObj3.submesh.indexCount = box.IndexCount();
-        sceneTopDir.push_back(boxObj3);
-
-        Object boxObj4;
-        // colocar isso aqui vindo do mouse
-        XMStoreFloat4x4(&boxObj4.world,
-            XMMatrixScaling(0.4f, 0.4f, 0.4f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        boxObj4.mesh = new Mesh();
-        boxObj4.mesh->VertexBuffer(box.VertexData(), box.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        boxObj4.mesh->IndexBuffer(box.IndexData(), box.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        boxObj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        boxObj4.submesh.indexCount = box.IndexCount();
-        sceneTopEsq.push_back(boxObj4);
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
     }
 
     // Cilindro
     if (input->KeyPress('C')) {
-        graphics->ResetCommands();
-
-        Cylinder cylinder(1.0f, 0.5f, 3.0f, 20, 20);
-        for (auto& v : cylinder.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-        Object cylinderObj;
-
-        // do init
-        //XMStoreFloat4x4(&cylinderObj.world,
-          //  XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            //XMMatrixTranslation(1.0f, 0.75f, -1.0f));
-
-        // cylinder
-        XMStoreFloat4x4(&cylinderObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) * // 0,5 , 0,5 , 0,5
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        cylinderObj.mesh = new Mesh();
-        cylinderObj.mesh->VertexBuffer(cylinder.VertexData(), cylinder.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        cylinderObj.mesh->IndexBuffer(cylinder.IndexData(), cylinder.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        cylinderObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        cylinderObj.submesh.indexCount = cylinder.IndexCount();
-        scene.push_back(cylinderObj);
-
-        Object cylinderObj2;
-
-        // cylinder
-        XMStoreFloat4x4(&cylinderObj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) * // 0,5 , 0,5 , 0,5
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        cylinderObj2.mesh = new Mesh();
-        cylinderObj2.mesh->VertexBuffer(cylinder.VertexData(), cylinder.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        cylinderObj2.mesh->IndexBuffer(cylinder.IndexData(), cylinder.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        cylinderObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        cylinderObj2.submesh.indexCount = cylinder.IndexCount();
-        sceneBaixEsq.push_back(cylinderObj2);
-
-        Object cylinderObj3;
-
-        // cylinder
-        XMStoreFloat4x4(&cylinderObj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) * // 0,5 , 0,5 , 0,5
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        cylinderObj3.mesh = new Mesh();
-        cylinderObj3.mesh->VertexBuffer(cylinder.VertexData(), cylinder.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        cylinderObj3.mesh->IndexBuffer(cylinder.IndexData(), cylinder.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        cylinderObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        cylinderObj3.submesh.indexCount = cylinder.IndexCount();
-        sceneTopEsq.push_back(cylinderObj3);
-
-        Object cylinderObj4;
-
-        // cylinder
-        XMStoreFloat4x4(&cylinderObj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) * // 0,5 , 0,5 , 0,5
+        // fatias e camadas so escolhidas a partir do tamanho na tela
+        TessDesc cylinder;
+        cylinder.shape = TESS_CYLINDER;
+        cylinder.radius = 1.0f;
+        cylinder.top = 0.5f;
+        cylinder.height = 3.0f;
+        cylinder.color = XMFLOAT4(DirectX::Colors::DimGray);
+
+        AddObject(cylinder,
+            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
             XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        cylinderObj4.mesh = new Mesh();
-        cylinderObj4.mesh->VertexBuffer(cylinder.VertexData(), cylinder.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        cylinderObj4.mesh->IndexBuffer(cylinder.IndexData(), cylinder.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        cylinderObj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        cylinderObj4.submesh.indexCount = cylinder.IndexCount();
-        sceneTopDir.push_back(cylinderObj4);
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
     }
 
     // Esfera
     if (input->KeyPress('S')) {
-        graphics->ResetCommands();
-
-        Sphere sphere(1.0f, 20, 20);
-        for (auto& v : sphere.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-        Object sphereObj;
-
-        //do init
-        /*XMStoreFloat4x4(&sphereObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));*/
-
-            // sphere
-        XMStoreFloat4x4(&sphereObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
+        // fatias e camadas so escolhidas a partir do tamanho na tela
+        TessDesc sphere;
+        sphere.shape = TESS_SPHERE;
+        sphere.radius = 1.0f;
+        sphere.color = XMFLOAT4(DirectX::Colors::DimGray);
 
-        sphereObj.mesh = new Mesh();
-        sphereObj.mesh->VertexBuffer(sphere.VertexData(), sphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        sphereObj.mesh->IndexBuffer(sphere.IndexData(), sphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        sphereObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        sphereObj.submesh.indexCount = sphere.IndexCount();
-        scene.push_back(sphereObj);
-
-        Object sphereObj2;
-        // sphere
-        XMStoreFloat4x4(&sphereObj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        sphereObj2.mesh = new Mesh();
-        sphereObj2.mesh->VertexBuffer(sphere.VertexData(), sphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        sphereObj2.mesh->IndexBuffer(sphere.IndexData(), sphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        sphereObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        sphereObj2.submesh.indexCount = sphere.IndexCount();
-        sceneBaixEsq.push_back(sphereObj2);
-
-        Object sphereObj3;
-        // sphere
-        XMStoreFloat4x4(&sphereObj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        sphereObj3.mesh = new Mesh();
-        sphereObj3.mesh->VertexBuffer(sphere.VertexData(), sphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        sphereObj3.mesh->IndexBuffer(sphere.IndexData(), sphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        sphereObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        sphereObj3.submesh.indexCount = sphere.IndexCount();
-        sceneTopEsq.push_back(sphereObj3);
-
-        Object sphereObj4;
-        // sphere
-        XMStoreFloat4x4(&sphereObj4.world,
+        AddObject(sphere,
             XMMatrixScaling(0.5f, 0.5f, 0.5f) *
             XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        sphereObj4.mesh = new Mesh();
-        sphereObj4.mesh->VertexBuffer(sphere.VertexData(), sphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        sphereObj4.mesh->IndexBuffer(sphere.IndexData(), sphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        sphereObj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        sphereObj4.submesh.indexCount = sphere.IndexCount();
-        sceneTopDir.push_back(sphereObj4);
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
     }
 
     // Globo
     if (input->KeyPress('G')) {
-        graphics->ResetCommands();
-
         GeoSphere geoSphere(1.0f, 2);
-        for (auto& v : geoSphere.vertices) v.color = XMFLOAT4(DirectX::Colors::White);
-        Object geoSphereObj;
-
-        // sphere
-        XMStoreFloat4x4(&geoSphereObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
 
-        geoSphereObj.mesh = new Mesh();
-        geoSphereObj.mesh->VertexBuffer(geoSphere.VertexData(), geoSphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        geoSphereObj.mesh->IndexBuffer(geoSphere.IndexData(), geoSphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        geoSphereObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        geoSphereObj.submesh.indexCount = geoSphere.IndexCount();
-        scene.push_back(geoSphereObj);
-
-        Object geoSphereObj2;
-
-        // sphere
-        XMStoreFloat4x4(&geoSphereObj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        geoSphereObj2.mesh = new Mesh();
-        geoSphereObj2.mesh->VertexBuffer(geoSphere.VertexData(), geoSphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        geoSphereObj2.mesh->IndexBuffer(geoSphere.IndexData(), geoSphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        geoSphereObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        geoSphereObj2.submesh.indexCount = geoSphere.IndexCount();
-        sceneBaixEsq.push_back(geoSphereObj2);
-
-
-        Object geoSphereObj3;
-
-        // sphere
-        XMStoreFloat4x4(&geoSphereObj3.world,
+        AddObject(geoSphere,
             XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        geoSphereObj3.mesh = new Mesh();
-        geoSphereObj3.mesh->VertexBuffer(geoSphere.VertexData(), geoSphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        geoSphereObj3.mesh->IndexBuffer(geoSphere.IndexData(), geoSphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        geoSphereObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        geoSphereObj3.submesh.indexCount = geoSphere.IndexCount();
-        sceneTopEsq.push_back(geoSphereObj3);
-
-
-        Object geoSphereObj4;
-
-        // sphere
-        XMStoreFloat4x4(&geoSphereObj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
-
-        geoSphereObj4.mesh = new Mesh();
-        geoSphereObj4.mesh->VertexBuffer(geoSphere.VertexData(), geoSphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        geoSphereObj4.mesh->IndexBuffer(geoSphere.IndexData(), geoSphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        geoSphereObj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        geoSphereObj4.submesh.indexCount = geoSphere.IndexCount();
-        sceneTopDir.push_back(geoSphereObj4);
-
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
+            XMMatrixTranslation(0.0f, 0.5f, 0.0f),
+            XMFLOAT4(DirectX::Colors::White));
     }
 
     // Plano
     if (input->KeyPress('P')) {
-        graphics->ResetCommands();
-
         Grid grid(5.0f, 3.0f, 20, 20);
 
-        for (auto& v : grid.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-        Object gridObj;
-
-        // grid
-        gridObj.mesh = new Mesh();
-        gridObj.world = Identity;
-        gridObj.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        gridObj.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        gridObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        gridObj.submesh.indexCount = grid.IndexCount();
-        scene.push_back(gridObj);
-
-        Object gridObj2;
-
-        // grid
-        gridObj2.mesh = new Mesh();
-        gridObj2.world = Identity;
-        gridObj2.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        gridObj2.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        gridObj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        gridObj2.submesh.indexCount = grid.IndexCount();
-        sceneBaixEsq.push_back(gridObj2);
-
-        Object gridObj3;
-
-        // grid
-        gridObj3.mesh = new Mesh();
-        gridObj3.world = Identity;
-        gridObj3.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        gridObj3.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        gridObj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        gridObj3.submesh.indexCount = grid.IndexCount();
-        sceneTopEsq.push_back(gridObj3);
-
-        Object gridOb4;
-
-        // grid
-        gridOb4.mesh = new Mesh();
-        gridOb4.world = Identity;
-        gridOb4.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        gridOb4.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        gridOb4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        gridOb4.submesh.indexCount = grid.IndexCount();
-        sceneTopDir.push_back(gridOb4);
-        sceneTopDir.push_back(gridOb4);
-
-        BuildRootSignature();
-        BuildPipelineState();
-
-        graphics->SubmitCommands();
+        AddObject(grid, XMMatrixIdentity());
     }
 
     else if (input->KeyPress('1')) {
@@ -764,1417 +527,844 @@ void Multi::Update()
 
         // Carregar o arquivo .obj
         Geometry ballData = LoadOBJ("ball.obj");
+        AddObject(ballData, XMMatrixScaling(0.5f, 0.5f, 0.5f));
+    }
+    else if (input->KeyPress('2')) {
+        OutputDebugString("Capsule\n");
 
-        graphics->ResetCommands();
+        // Carregar o arquivo .obj
+        Geometry capsuleData = LoadOBJ("capsule.obj");
+        AddObject(capsuleData, XMMatrixScaling(0.5f, 0.5f, 0.5f));
+    }
+    else if (input->KeyPress('3')) {
+        OutputDebugString("House\n");
 
-        Object obj; //Objeto
-        XMStoreFloat4x4(&obj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        // Carregar o arquivo .obj
+        Geometry houseData = LoadOBJ("house.obj");
+        AddObject(houseData, XMMatrixScaling(0.5f, 0.5f, 0.5f));
+    }
+    else if (input->KeyPress('4')) {
+        OutputDebugString("Monkey\n");
 
-        obj.mesh = new Mesh();
-        obj.mesh->VertexBuffer(ballData.VertexData(), ballData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj.mesh->IndexBuffer(ballData.IndexData(), ballData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj.submesh.indexCount = ballData.IndexCount();
-        scene.push_back(obj);
+        // Carregar o arquivo .obj
+        Geometry monkeyData = LoadOBJ("monkey.obj");
+        AddObject(monkeyData, XMMatrixScaling(0.5f, 0.5f, 0.5f));
+    }
+    else if (input->KeyPress('5')) {
+        OutputDebugString("Bleach\n");
 
-        Object obj2; //Objeto
-        XMStoreFloat4x4(&obj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        // Carregar o arquivo .obj
+        Geometry bleachData = LoadOBJ("HollofiedIchigo.obj");
+        AddObject(bleachData, XMMatrixScaling(0.5f, 0.5f, 0.5f));
+    }
 
-        obj2.mesh = new Mesh();
-        obj2.mesh->VertexBuffer(ballData.VertexData(), ballData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj2.mesh->IndexBuffer(ballData.IndexData(), ballData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj2.submesh.indexCount = ballData.IndexCount();
-        sceneBaixEsq.push_back(obj2);
 
-        Object obj3; //Objeto
-        XMStoreFloat4x4(&obj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+    if (input->KeyPress(VK_TAB) && scene.Size() > 0)
+    {
+        // prximo objeto na ordem densa, voltando ao incio
+        uint index = scene.Index(selected);
 
-        obj3.mesh = new Mesh();
-        obj3.mesh->VertexBuffer(ballData.VertexData(), ballData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj3.mesh->IndexBuffer(ballData.IndexData(), ballData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj3.submesh.indexCount = ballData.IndexCount();
-        sceneTopEsq.push_back(obj3);
+        if (index == SlotMap<Object>::None || index + 1 >= scene.Size())
+            index = 0;
+        else
+            ++index;
 
-        Object obj4; //Objeto
-        XMStoreFloat4x4(&obj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        selected = scene.At(index);
+    }
 
-        obj4.mesh = new Mesh();
-        obj4.mesh->VertexBuffer(ballData.VertexData(), ballData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj4.mesh->IndexBuffer(ballData.IndexData(), ballData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj4.submesh.indexCount = ballData.IndexCount();
-        sceneTopDir.push_back(obj4);
+    // clique seleciona o objeto sob o cursor; no vazio a seleo no muda
+    if (input->KeyPress(VK_LBUTTON))
+    {
+        int picked = Pick(float(input->MouseX()), float(input->MouseY()));
 
-        graphics->SubmitCommands();
+        if (picked >= 0)
+            selected = scene.At(picked);
+    }
 
+    // No caso de excluso (por exemplo, quando a tecla Delete  pressionada)
+    if (input->KeyPress(VK_DELETE))
+    {
+        if (Object* selectedObject = Selected())
+        {
+            // o quadro anterior ainda pode estar sendo desenhado com a malha:
+            // a renderizao a destri depois deste quadro, e a liberao
+            // dos buffers ainda espera a GPU terminar os quadros em voo
+            if (selectedObject->tess)
+                frame.tessellations.push_back(selectedObject->tess);
+            else
+                frame.meshes.push_back(selectedObject->mesh);
+            delete selectedObject->pick;
+
+            // os filhos do n removido passam ao av sem sair do lugar
+            graph.Remove(selectedObject->node);
+
+            // remoo em O(1): o ltimo objeto ocupa a posio do removido
+            // na cena e nos vetores paralelos; o handle selecionado fica obsoleto
+            uint index = scene.Index(selected);
+            scene.Remove(selected);
+            culler.Remove(index);
+            bvh.Remove(index);
+        }
+    }
 
+    // agrupa o objeto selecionado sob o selecionado antes dele
+    if (input->KeyPress('A'))
+    {
+        Object* selectedObject = Selected();
+        Object* parent = scene.Get(previous);
 
+        if (selectedObject && parent && parent != selectedObject)
+            graph.SetParent(selectedObject->node, parent->node);
     }
-    else if (input->KeyPress('2')) {
-        OutputDebugString("Capsule\n");
-
-        // Carregar o arquivo .obj
-        Geometry capsuleData = LoadOBJ("capsule.obj");
 
-        graphics->ResetCommands();
+    // desfaz o agrupamento: o objeto volta a ser uma raiz
+    if (input->KeyPress('U'))
+    {
+        if (Object* selectedObject = Selected())
+            graph.SetParent(selectedObject->node, SceneGraph::None);
+    }
 
-        Object obj; //Objeto
-        XMStoreFloat4x4(&obj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+    // Verifique se a tecla V foi pressionada para alternar o modo QuadView
+    if (input->KeyPress('V'))
+    {
+        quadViewMode = !quadViewMode;
+    }
 
-        obj.mesh = new Mesh();
-        obj.mesh->VertexBuffer(capsuleData.VertexData(), capsuleData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj.mesh->IndexBuffer(capsuleData.IndexData(), capsuleData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj.submesh.indexCount = capsuleData.IndexCount();
-        scene.push_back(obj);
+    // liga/desliga a tesselao adaptativa de esferas e cilindros
+    if (input->KeyPress('T'))
+    {
+        adaptiveTess = !adaptiveTess;
+    }
 
-        Object obj2; //Objeto
+    // liga/desliga o descarte por ocluso
+    if (input->KeyPress('O'))
+    {
+        occlusionCulling = !occlusionCulling;
+    }
 
-        XMStoreFloat4x4(&obj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+    // liga/desliga o desenho em paralelo com a atualizao do prximo quadro
+    if (input->KeyPress('R'))
+    {
+        pipelined = !pipelined;
+    }
 
-        obj2.mesh = new Mesh();
-        obj2.mesh->VertexBuffer(capsuleData.VertexData(), capsuleData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj2.mesh->IndexBuffer(capsuleData.IndexData(), capsuleData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj2.submesh.indexCount = capsuleData.IndexCount();
-        sceneBaixEsq.push_back(obj2);
+    // a mesma instncia do objeto aparece em todas as vistas
+    if (Object* selectedObject = Selected())
+    {
+        const Trs before = graph.Local(selectedObject->node);
+        Trs local = before;
 
-        Object obj3; //Objeto
+        // mover para baixo e para cima (direo y)
+        if (input->KeyPress(VK_DOWN))
+            local.translation[1] -= 0.2f;
 
-        XMStoreFloat4x4(&obj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        if (input->KeyPress(VK_UP))
+            local.translation[1] += 0.2f;
 
-        obj3.mesh = new Mesh();
-        obj3.mesh->VertexBuffer(capsuleData.VertexData(), capsuleData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj3.mesh->IndexBuffer(capsuleData.IndexData(), capsuleData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj3.submesh.indexCount = capsuleData.IndexCount();
-        sceneTopEsq.push_back(obj3);
+        // mover para direita e para esquerda (direo x)
+        if (input->KeyPress(VK_RIGHT))
+            local.translation[0] += 0.2f;
 
-        Object obj4; //Objeto
+        if (input->KeyPress(VK_LEFT))
+            local.translation[0] -= 0.2f;
 
-        XMStoreFloat4x4(&obj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        // giros no espao local do objeto, antes da rotao atual
+        const float axisX[3] = { 1.0f, 0.0f, 0.0f };
+        const float axisY[3] = { 0.0f, 1.0f, 0.0f };
 
-        obj4.mesh = new Mesh();
-        obj4.mesh->VertexBuffer(capsuleData.VertexData(), capsuleData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj4.mesh->IndexBuffer(capsuleData.IndexData(), capsuleData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj4.submesh.indexCount = capsuleData.IndexCount();
-        sceneTopDir.push_back(obj4);
+        // girar em torno de y, 5 graus por quadro
+        if (input->KeyDown('J'))
+            local.Rotate(axisY, XMConvertToRadians(-5.0f));
 
-        graphics->SubmitCommands();
-    }
-    else if (input->KeyPress('3')) {
-        OutputDebugString("House\n");
+        if (input->KeyDown('L'))
+            local.Rotate(axisY, XMConvertToRadians(5.0f));
 
-        // Carregar o arquivo .obj
-        Geometry houseData = LoadOBJ("house.obj");
+        // girar em torno de x, 5 graus por quadro
+        if (input->KeyDown('I'))
+            local.Rotate(axisX, XMConvertToRadians(5.0f));
 
-        graphics->ResetCommands();
+        if (input->KeyDown('K'))
+            local.Rotate(axisX, XMConvertToRadians(-5.0f));
 
-        Object obj; //Objeto
-        XMStoreFloat4x4(&obj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        // aumenta e diminui a escala em 25%
+        float factor = 1.0f;
 
-        obj.mesh = new Mesh();
-        obj.mesh->VertexBuffer(houseData.VertexData(), houseData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj.mesh->IndexBuffer(houseData.IndexData(), houseData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj.submesh.indexCount = houseData.IndexCount();
-        scene.push_back(obj);
+        if (input->KeyDown('Y'))
+            factor *= 1.25f;
 
-        Object obj2; //Objeto
-        XMStoreFloat4x4(&obj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        if (input->KeyDown('H'))
+            factor *= 0.75f;
 
-        obj2.mesh = new Mesh();
-        obj2.mesh->VertexBuffer(houseData.VertexData(), houseData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj2.mesh->IndexBuffer(houseData.IndexData(), houseData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj2.submesh.indexCount = houseData.IndexCount();
-        sceneBaixEsq.push_back(obj2);
+        for (uint k = 0; k < 3; ++k)
+            local.scale[k] *= factor;
 
-        Object obj3; //Objeto
-        XMStoreFloat4x4(&obj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+        // o n s fica sujo se a transformao local mudou
+        if (memcmp(&before, &local, sizeof(Trs)))
+            graph.SetLocal(selectedObject->node, local);
+    }
 
-        obj3.mesh = new Mesh();
-        obj3.mesh->VertexBuffer(houseData.VertexData(), houseData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj3.mesh->IndexBuffer(houseData.IndexData(), houseData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj3.submesh.indexCount = houseData.IndexCount();
-        sceneTopEsq.push_back(obj3);
+    // apenas as subrvores alteradas recebem novas matrizes de mundo:
+    // mover um grupo move todos os seus descendentes
+    if (graph.Update())
+    {
+        for (uint node : graph.Changed())
+        {
+            uint i = scene.Index(objectOf[node]);
+            Object& obj = scene[i];
 
-        Object obj4; //Objeto
-        XMStoreFloat4x4(&obj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
+            // um n recalculado pode terminar com a mesma matriz
+            if (!memcmp(&obj.world, graph.World(node), sizeof(XMFLOAT4X4)))
+                continue;
 
-        obj4.mesh = new Mesh();
-        obj4.mesh->VertexBuffer(houseData.VertexData(), houseData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj4.mesh->IndexBuffer(houseData.IndexData(), houseData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj4.submesh.indexCount = houseData.IndexCount();
-        sceneTopDir.push_back(obj4);
+            memcpy(&obj.world, graph.World(node), sizeof(XMFLOAT4X4));
+            obj.dirty = Graphics::FrameCount;
 
-        graphics->SubmitCommands();
-    }
-    else if (input->KeyPress('4')) {
-        OutputDebugString("Monkey\n");
-
-        // Carregar o arquivo .obj
-        Geometry monkeyData = LoadOBJ("monkey.obj");
-
-        graphics->ResetCommands();
-
-        Object obj; //Objeto
-        XMStoreFloat4x4(&obj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj.mesh = new Mesh();
-        obj.mesh->VertexBuffer(monkeyData.VertexData(), monkeyData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj.mesh->IndexBuffer(monkeyData.IndexData(), monkeyData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj.submesh.indexCount = monkeyData.IndexCount();
-        scene.push_back(obj);
-
-        Object obj2; //Objeto
-
-        XMStoreFloat4x4(&obj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj2.mesh = new Mesh();
-        obj2.mesh->VertexBuffer(monkeyData.VertexData(), monkeyData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj2.mesh->IndexBuffer(monkeyData.IndexData(), monkeyData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj2.submesh.indexCount = monkeyData.IndexCount();
-        sceneBaixEsq.push_back(obj2);
-
-        Object obj3; //Objeto
-
-        XMStoreFloat4x4(&obj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj3.mesh = new Mesh();
-        obj3.mesh->VertexBuffer(monkeyData.VertexData(), monkeyData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj3.mesh->IndexBuffer(monkeyData.IndexData(), monkeyData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj3.submesh.indexCount = monkeyData.IndexCount();
-        sceneTopEsq.push_back(obj3);
-
-        Object obj4; //Objeto
-
-        XMStoreFloat4x4(&obj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj4.mesh = new Mesh();
-        obj4.mesh->VertexBuffer(monkeyData.VertexData(), monkeyData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj4.mesh->IndexBuffer(monkeyData.IndexData(), monkeyData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj4.submesh.indexCount = monkeyData.IndexCount();
-        sceneTopDir.push_back(obj4);
-
-        graphics->SubmitCommands();
-    }
-    else if (input->KeyPress('5')) {
-        OutputDebugString("Bleach\n");
-
-        // Carregar o arquivo .obj
-        Geometry bleachData = LoadOBJ("HollofiedIchigo.obj");
-
-        graphics->ResetCommands();
-
-        Object obj; //Objeto
-        XMStoreFloat4x4(&obj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj.mesh = new Mesh();
-        obj.mesh->VertexBuffer(bleachData.VertexData(), bleachData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj.mesh->IndexBuffer(bleachData.IndexData(), bleachData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj.submesh.indexCount = bleachData.IndexCount();
-        scene.push_back(obj);
-
-        Object obj2; //Objeto
-
-        XMStoreFloat4x4(&obj2.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj2.mesh = new Mesh();
-
-        obj2.mesh->VertexBuffer(bleachData.VertexData(), bleachData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj2.mesh->IndexBuffer(bleachData.IndexData(), bleachData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj2.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj2.submesh.indexCount = bleachData.IndexCount();
-        sceneBaixEsq.push_back(obj2);
-
-        Object obj3; //Objeto
-
-        XMStoreFloat4x4(&obj3.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj3.mesh = new Mesh();
-        obj3.mesh->VertexBuffer(bleachData.VertexData(), bleachData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj3.mesh->IndexBuffer(bleachData.IndexData(), bleachData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj3.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj3.submesh.indexCount = bleachData.IndexCount();
-        sceneTopEsq.push_back(obj3);
-
-        Object obj4; //Objeto
-
-        XMStoreFloat4x4(&obj4.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.0f, 0.0f));
-
-        obj4.mesh = new Mesh();
-        obj4.mesh->VertexBuffer(bleachData.VertexData(), bleachData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        obj4.mesh->IndexBuffer(bleachData.IndexData(), bleachData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        obj4.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        obj4.submesh.indexCount = bleachData.IndexCount();
-        sceneTopDir.push_back(obj4);
-
-        graphics->SubmitCommands();
+            // volume no mundo do objeto movido
+            Bounds bounds = obj.bounds.Transform(&obj.world._11);
+            culler.Set(i, bounds);
+            bvh.Set(i, bounds);
+            obj.occluder = IsOccluder(obj, bounds);
+        }
     }
 
+    // mouse positions
+    float mousePosX = (float)input->MouseX();
+    float mousePosY = (float)input->MouseY();
 
-    if (input->KeyPress(VK_TAB))
+    if (input->KeyDown(VK_LBUTTON) && quadViewMode == false)
     {
-        // Incrementar o ndice com base na direo desejada (neste exemplo,  para a direita)
-        selectedIndex++;
+        // cada pixel corresponde a 1/4 de grau
+        float dx = XMConvertToRadians(0.25f * (mousePosX - lastMousePosX));
+        float dy = XMConvertToRadians(0.25f * (mousePosY - lastMousePosY));
 
-        // Certifique-se de que o ndice esteja dentro dos limites do vetor
-        if (selectedIndex >= scene.size())
-        {
-            selectedIndex = 0; // Volte para o incio
-            
-        }
+        // atualiza ngulos com base no deslocamento do mouse
+        // para orbitar a cmera ao redor da caixa
+        theta += dx;
+        phi += dy;
 
+        // restringe o ngulo de phi ]0-180[ graus
+        phi = phi < 0.1f ? 0.1f : (phi > (XM_PI - 0.1f) ? XM_PI - 0.1f : phi);
     }
-
-    // No caso de excluso (por exemplo, quando a tecla Delete  pressionada)
-    if (input->KeyPress(VK_DELETE))
+    else if (input->KeyDown(VK_RBUTTON) && quadViewMode == false)
     {
-        if (!scene.empty())
-        {
-            // Verifique se o ndice ainda est dentro dos limites antes de excluir
-            if (selectedIndex >= 0 && selectedIndex < scene.size())
-            {
-                // Deletar o objeto selecionado
-                scene.erase(scene.begin() + selectedIndex);
-            }
-        }
-
-        if (!sceneBaixEsq.empty())
-        {
-            // Verifique se o ndice ainda est dentro dos limites antes de excluir
-            if (selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-            {
-                // Deletar o objeto selecionado
-                sceneBaixEsq.erase(sceneBaixEsq.begin() + selectedIndex);
-            }
-        }
+        // cada pixel corresponde a 0.05 unidades
+        float dx = 0.05f * (mousePosX - lastMousePosX);
+        float dy = 0.05f * (mousePosY - lastMousePosY);
 
-        if (!sceneTopEsq.empty())
-        {
-            // Verifique se o ndice ainda est dentro dos limites antes de excluir
-            if (selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
-            {
-                // Deletar o objeto selecionado
-                sceneTopEsq.erase(sceneTopEsq.begin() + selectedIndex);
-            }
-        }
+        // atualiza o raio da cmera com base no deslocamento do mouse 
+        radius += dx - dy;
 
-        if (!sceneTopDir.empty())
-        {
-            // Verifique se o ndice ainda est dentro dos limites antes de excluir
-            if (selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-            {
-                // Deletar o objeto selecionado
-                sceneTopDir.erase(sceneTopDir.begin() + selectedIndex);
-            }
-        }
+        // restringe o raio (3 a 15 unidades)
+        radius = radius < 3.0f ? 3.0f : (radius > 15.0f ? 15.0f : radius);
     }
 
-    // Verifique se a tecla V foi pressionada para alternar o modo QuadView
-    if (input->KeyPress('V'))
-    {
-        quadViewMode = !quadViewMode;
-    }
+    lastMousePosX = mousePosX;
+    lastMousePosY = mousePosY;
 
-    // mover para baixo
-    if (input->KeyPress(VK_DOWN))
-    {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
-        {
-            Object& selectedObject = scene[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
+    // converte coordenadas esfricas para cartesianas
+    float x = radius * sinf(phi) * cosf(theta);
+    float z = radius * sinf(phi) * sinf(theta);
+    float y = radius * cosf(phi);
 
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 -= 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
+    // constri a matriz da cmera (view matrix)
+    XMVECTOR pos = XMVectorSet(x, y, z, 1.0f);
+    XMVECTOR target = XMVectorZero();
+    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    XMMATRIX view = XMMatrixLookAtLH(pos, target, up);
 
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
+    Camera& persp = cameras[PERSPECTIVE];
+    XMStoreFloat4x4(&persp.view, view);
+    XMStoreFloat4x4(&persp.viewProj, view * XMLoadFloat4x4(&persp.proj));
 
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 -= 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
+    // quadview desenha as quatro vistas, seno s a perspectiva na tela inteira
+    firstView = quadViewMode ? FRONT : PERSPECTIVE;
+    persp.viewport = quadViewMode ? viewPerspective : viewScreen;
 
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
-        {
-            Object& selectedObject = sceneTopEsq[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
+    // variantes de tesselao prontas passam a ser usadas neste quadro
+    UploadTessellations();
 
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 -= 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
+    // vistas ativas no descarte
+    uint viewMask = 0;
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
-
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 -= 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
-    }
-
-    // mover para cima
-    if (input->KeyPress(VK_UP))
+    for (uint v = firstView; v < cameras.size(); ++v)
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
-        {
-            Object& selectedObject = scene[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
+        culler.View(v, &cameras[v].viewProj._11);
+        viewMask |= 1u << v;
+    }
 
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 += 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
+    // inseres e remoes reconstroem a hierarquia, assim como
+    // reajustes que degradaram demais a qualidade da rvore
+    bvh.Update();
 
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
+    // todas as vistas ativas so testadas em uma nica passada
+    if (scene.Size() >= HierarchyObjects)
+        culler.Cull(viewMask, bvh);
+    else
+        culler.Cull(viewMask);
 
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 += 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
+    // objetos grandes rasterizados na CPU escondem os que esto atrs deles
+    for (uint v = firstView; v < cameras.size(); ++v)
+    {
+        const vector<uint>& visible = culler.Visible(v);
+        vector<uint>& drawList = frame.drawLists[v];
 
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
+        if (!occlusionCulling)
         {
-            Object& selectedObject = sceneTopEsq[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
-
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 += 0.2f;  // Reduza a posio y (vertical) em 0.2
+            drawList = visible;
+            continue;
         }
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];  // Observe o uso de uma referncia (&) aqui.
-
-            // Mova o objeto para baixo (negativo na direo y)
-            selectedObject.world._42 += 0.2f;  // Reduza a posio y (vertical) em 0.2
-        }
-    }
+        OcclusionBuffer& buffer = occlusion[v];
+        buffer.Begin(&cameras[v].viewProj._11);
 
-    // mover para direita
-    if (input->KeyPress(VK_RIGHT))
-    {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
+        for (uint i : visible)
         {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Mova o objeto para a direita (positivo na direo x)
-            selectedObject.world._41 += 0.2f;  // Aumente a posio x (horizontal) em 0.25f
+            if (scene[i].occluder)
+                buffer.Rasterize(*scene[i].pick, &scene[i].world._11);
         }
 
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
+        buffer.Finish();
+        drawList.clear();
 
-            // Mova o objeto para a direita (positivo na direo x)
-            selectedObject.world._41 += 0.2f;  // Aumente a posio x (horizontal) em 0.2f
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
+        // oclusores so sempre desenhados
+        for (uint i : visible)
         {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // Mova o objeto para a direita (positivo na direo x)
-            selectedObject.world._41 += 0.2f;  // Aumente a posio x (horizontal) em 0.2f
+            if (scene[i].occluder || !buffer.Occluded(culler.Get(i)))
+                drawList.push_back(i);
         }
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // Mova o objeto para a direita (positivo na direo x)
-            selectedObject.world._41 += 0.2f;  // Aumente a posio x (horizontal) em 0.2f
-        }
+        buffer.End();
     }
 
-    // mover para esquerda
-    if (input->KeyPress(VK_LEFT))
+    // contagens da ocluso uma vez por segundo
+    if (reportTimer.Elapsed(1.0))
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
-        {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Mova o objeto para a esquerda (negativo na direo x)
-            selectedObject.world._41 -= 0.2f; // Reduza a posio x (horizontal) em 0.2f;
-        }
-
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
+        if (occlusionCulling)
         {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // Mova o objeto para a esquerda (negativo na direo x)
-            selectedObject.world._41 -= 0.2f; // Reduza a posio x (horizontal) em 0.2f;
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
-        {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // Mova o objeto para a esquerda (negativo na direo x)
-            selectedObject.world._41 -= 0.2f; // Reduza a posio x (horizontal) em 0.2f;
+            for (uint v = firstView; v < cameras.size(); ++v)
+            {
+                OcclusionStats stats = occlusion[v].Stats();
+                std::stringstream text;
+                text << "Oclusao vista " << v << ": " << stats.occluders << " oclusores ("
+                     << stats.triangles << " triangulos), " << stats.occluded << " de "
+                     << stats.occludees << " objetos escondidos, " << stats.time << " ms\n";
+                OutputDebugString(text.str().c_str());
+            }
         }
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // Mova o objeto para a esquerda (negativo na direo x)
-            selectedObject.world._41 -= 0.2f; // Reduza a posio x (horizontal) em 0.2f;
-        }
+        reportTimer.Reset();
     }
 
-    // Rotacionar girando esquerda para direira
-    if (input->KeyDown('J'))
+    // o destaque da seleo  s uma troca de cor nas constantes
+    if (highlighted != selected)
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
+        if (Object* highlightedObject = scene.Get(highlighted))
         {
-            Object& selectedObject = scene[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(-5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            highlightedObject->dirty = Graphics::FrameCount;
+            previous = highlighted;
         }
 
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(-5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
-        {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(-5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+        if (Object* selectedObject = Selected())
+            selectedObject->dirty = Graphics::FrameCount;
 
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
+        highlighted = selected;
+    }
 
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+    Object* selectedObject = Selected();
+    frame.constants.resize(scene.Size());
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
+    // cada objeto s altera sua tesselao e suas constantes:
+    // blocos de objetos so atualizados em paralelo
+    jobs->ParallelFor(scene.Size(), ObjectGrain, [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i)
         {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(-5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
+            Object& obj = scene[i];
 
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+            // escolhe a tesselao pelo tamanho nas vistas ativas
+            if (obj.tess)
+                Tessellate(obj);
 
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
+            // as constantes s so copiadas para os quadros em voo que ainda
+            // no as tm: objetos parados no geram trfego de constantes;
+            // a cpia em si  feita pela renderizao, na regio do seu quadro
+            ConstantsCopy& copy = frame.constants[i];
+            copy.mesh = nullptr;
 
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            if (obj.dirty)
+            {
+                XMStoreFloat4x4(&copy.constants.World, XMMatrixTranspose(XMLoadFloat4x4(&obj.world)));
+                copy.constants.color = (&obj == selectedObject) ? highlightColor : obj.color;
+                copy.mesh = obj.mesh;
+                --obj.dirty;
+            }
         }
+    });
 
-    }
+    // buffers dos objetos visveis em alguma vista
+    frame.drawData.resize(scene.Size());
 
-    // Rotacionar girando direita para esquerda
-    if (input->KeyDown('L'))
+    for (uint v = firstView; v < cameras.size(); ++v)
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
-        {
-            Object& selectedObject = scene[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
+        for (uint i : frame.drawLists[v])
         {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            Object& obj = scene[i];
+            DrawData& data = frame.drawData[i];
+            data.vertexView = *obj.mesh->VertexBufferView();
+            data.indexView = *obj.mesh->IndexBufferView();
+            data.mesh = obj.mesh;
+            data.submesh = obj.submesh;
+            memcpy(&data.center, culler.Get(i).center, sizeof(XMFLOAT3));
         }
+    }
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // ngulo de rotao desejado em radianos
-            float angleInRadians = XMConvertToRadians(5.0f); // 5 graus
-
-            XMMATRIX rotationMatrix = XMMatrixRotationY(angleInRadians);
-
-            // Carregando a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+    // estado das vistas entregue junto com o quadro
+    frame.cameras = cameras;
+    frame.firstView = firstView;
+    frame.quadView = quadViewMode;
+    frame.pipelined = pipelined;
+    frame.pipeline = pipelineState;
+}
 
-            // Multiplicando a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
+// ------------------------------------------------------------------------------
 
-            // Armazenando a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+void Multi::Draw()
+{
+    // quadro entregue pela atualizao; o seguinte pode estar sendo atualizado.
+    // Clear e Present travam o dispositivo s nas alocaes e cpias
+    FrameSnapshot& frame = snapshots[handoff->RenderSlot()];
 
+    // constantes alteradas vo para a regio do quadro em gravao
+    for (const ConstantsCopy& copy : frame.constants)
+    {
+        if (copy.mesh)
+            copy.mesh->CopyConstants(&copy.constants);
     }
 
-    // girando cima para baixo
-    if (input->KeyDown('I'))
+    // a matriz ViewProj  enviada uma vez por vista
+    for (uint v = frame.firstView; v < VIEWS; ++v)
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
-        {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
-        {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
-        {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
+        ViewConstants constants;
+        XMStoreFloat4x4(&constants.ViewProj, XMMatrixTranspose(XMLoadFloat4x4(&frame.cameras[v].viewProj)));
+        memcpy(viewConstants.data + ViewSlot(v), &constants, sizeof(ViewConstants));
+    }
 
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+    // cada vista  gravada em seu prprio segmento por uma thread
+    uint views = VIEWS - frame.firstView;
+    recorder->Record(views, [this, &frame](uint segment, CommandStream& commands) {
+        RecordView(frame, frame.firstView + segment, commands);
+    });
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];
+    graphics->Clear(frame.pipeline);
 
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(5.0f); // Por exemplo, 5 graus no sentido horrio
+    // os segmentos so traduzidos para a lista de comandos na ordem das vistas
+    recorder->Submit(graphics->Commands());
 
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
+    if (frame.quadView) {
+        // separadores das vistas no espao de recorte da tela
+        overlay->Line(XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT4(DirectX::Colors::Blue));
+        overlay->Line(XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT4(DirectX::Colors::HotPink));
+    }
 
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+    // separadores e demais linhas em uma nica chamada
+    overlay->Draw(linePipeline, rootSignature, viewScreen);
 
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
+    // apresenta o backbuffer na tela
+    graphics->Present();
 
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+    // nenhum quadro anterior usa mais as malhas removidas
+    {
+        std::lock_guard<std::mutex> lock(graphics->Mutex());
+        for (Tessellation* tess : frame.tessellations) delete tess;
+        for (Mesh* mesh : frame.meshes) delete mesh;
     }
+    frame.tessellations.clear();
+    frame.meshes.clear();
 
-    // girando baixo para cima
-    if (input->KeyDown('K'))
+    // contagens de desenho, tarefas, memria e quadros uma vez por segundo
+    if (drawReportTimer.Elapsed(1.0))
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size())
+        // desenhos e comandos de estado do ltimo quadro, somando as vistas
+        RenderStats render;
+        for (uint v = frame.firstView; v < VIEWS; ++v)
         {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(-5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            RenderStats stats = renderQueues[v].Stats();
+            render.draws += stats.draws;
+            render.changes += stats.changes;
+            render.avoided += stats.avoided;
+            render.sortTime += stats.sortTime;
         }
 
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size())
+        RecordStats record = recorder->Stats();
+        std::stringstream draws;
+        draws << "Fila de desenho: " << render.draws << " desenhos, " << render.changes
+              << " mudancas de estado, " << render.avoided << " evitadas, ordenacao em "
+              << render.sortTime << " ms, " << record.commands << " comandos gravados em "
+              << record.time << " ms por " << record.threads << " threads\n";
+        OutputDebugString(draws.str().c_str());
+
+        // ocupao e roubos de cada fila no ltimo segundo (a ltima  a da renderizao)
+        std::stringstream workers;
+        workers << "Tarefas:";
+        for (uint t = 0; t < jobs->Queues(); ++t)
         {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(-5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            JobStats stats = jobs->Stats(t);
+            workers << " [" << t << "] " << stats.jobs << " tarefas, " << stats.steals << " roubos, "
+                    << int(stats.utilization * 100) << "%";
         }
+        workers << "\n";
+        OutputDebugString(workers.str().c_str());
+        jobs->ResetStats();
 
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size())
+        // buffers vivos devem ficar estveis ao criar e excluir objetos
+        ReleaseStats releases;
         {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(-5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size())
-        {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // Defina o ngulo de rotao desejado em radianos (sentido horrio)
-            float angleInRadians = XMConvertToRadians(-5.0f); // Por exemplo, 5 graus no sentido horrio
-
-            // Crie uma matriz de rotao em torno do eixo X
-            XMMATRIX rotationMatrix = XMMatrixRotationX(angleInRadians);
-
-            // Carregue a matriz de transformao atual em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de rotao pela matriz de transformao atual
-            XMMATRIX newTransform = rotationMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
+            std::lock_guard<std::mutex> lock(graphics->Mutex());
+            releases = graphics->Releases();
         }
+        std::stringstream text;
+        text << "Memoria: " << releases.liveBuffers << " buffers vivos (" << releases.liveBytes
+             << " bytes), " << releases.liveDescriptors << " descritores, " << releases.pending
+             << " liberacoes pendentes (" << releases.pendingBytes << " bytes)\n";
+        OutputDebugString(text.str().c_str());
+
+        // tempo de cada lado e latncia: em paralelo o intervalo entre quadros
+        // se aproxima do maior dos dois tempos, com um quadro a mais de latncia
+        HandoffStats pipe = handoff->Stats();
+        std::stringstream frames;
+        frames << "Quadros (" << (frame.pipelined ? "em paralelo" : "em serie") << "): atualizacao "
+               << pipe.update << " ms, desenho " << pipe.render << " ms, intervalo "
+               << pipe.interval << " ms, latencia " << pipe.latency << " ms, esperas "
+               << pipe.updateWait << "/" << pipe.renderWait << " ms\n";
+        OutputDebugString(frames.str().c_str());
+        handoff->ResetStats();
+
+        // pipelines criados uma vez e depois s encontrados no cache
+        PipelineStats pipelineStats = pipelines->Stats();
+        std::stringstream pipes;
+        pipes << "Pipelines: " << pipelineStats.hits << " acertos, " << pipelineStats.loads
+              << " lidos do disco, " << pipelineStats.misses << " compilados, "
+              << pipelineStats.rootSignatures << " assinaturas raiz\n";
+        OutputDebugString(pipes.str().c_str());
+
+        // cada arquivo de shader deve ser lido uma nica vez
+        ShaderStats shaderStats = pipelines->Shaders().Stats();
+        std::stringstream shaders;
+        shaders << "Shaders: " << shaderStats.requests << " pedidos, " << shaderStats.loads
+                << " arquivos lidos (" << shaderStats.bytes << " bytes), " << shaderStats.duplicates
+                << " com conteudo repetido\n";
+        OutputDebugString(shaders.str().c_str());
+
+        drawReportTimer.Reset();
     }
+}
 
-    // aumenta escala
-    if (input->KeyDown('Y'))
-    {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size()) {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f + 0.25f;
-            float scaleY = 1.0f + 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f + +0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size()) {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f + 0.25f;
-            float scaleY = 1.0f + 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f + +0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size()) {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f + 0.25f;
-            float scaleY = 1.0f + 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f + +0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size()) {
-            Object& selectedObject = sceneTopDir[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f + 0.25f;
-            float scaleY = 1.0f + 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f + +0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+// ------------------------------------------------------------------------------
 
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
+void Multi::RecordView(const FrameSnapshot& frame, uint v, CommandStream& commands)
+{
+    // apenas os objetos que passaram nos testes da vista entram na fila;
+    // cada objeto tem sua malha, ento a malha  identificada pela posio na cena
+    RenderQueue& queue = renderQueues[v];
+    queue.Clear();
 
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-    }
+    XMMATRIX viewProj = XMLoadFloat4x4(&frame.cameras[v].viewProj);
 
-    // diminui escala
-    if (input->KeyDown('H'))
+    for (uint i : frame.drawLists[v])
     {
-        if (!scene.empty() && selectedIndex >= 0 && selectedIndex < scene.size()) {
-            Object& selectedObject = scene[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f - 0.25f;
-            float scaleY = 1.0f - 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f - 0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
-
-        if (!sceneBaixEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneBaixEsq.size()) {
-            Object& selectedObject = sceneBaixEsq[selectedIndex];
-
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f - 0.25f;
-            float scaleY = 1.0f - 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f - 0.25f;
-
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
-
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
-
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
-
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+        // profundidade do centro do volume, de 0 (perto) a 1 (longe)
+        XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&frame.drawData[i].center), viewProj);
+        queue.Push(RenderQueue::Key(v, 0, i, XMVectorGetZ(center)), i);
+    }
 
-        if (!sceneTopEsq.empty() && selectedIndex >= 0 && selectedIndex < sceneTopEsq.size()) {
-            Object& selectedObject = sceneTopEsq[selectedIndex];
+    queue.Sort();
 
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f - 0.25f;
-            float scaleY = 1.0f - 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f - 0.25f;
+    // Clear define o pipeline e a heap de descritores
+    queue.Set(STATE_PIPELINE, ullong(frame.pipeline));
+    queue.Set(STATE_HEAPS, ullong(graphics->DescriptorHeap()));
 
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
+    // o segmento no conhece os estados deixados pela vista anterior:
+    // comandos de estado s quando o valor muda dentro da prpria vista
+    const D3D12_VIEWPORT& vp = frame.cameras[v].viewport;
+    D3D12_GPU_VIRTUAL_ADDRESS viewAddress = viewConstants.Address() + ViewSlot(v);
 
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+    for (const DrawItem& item : queue.Items())
+    {
+        const DrawData& data = frame.drawData[item.index];
+        D3D12_GPU_DESCRIPTOR_HANDLE table = data.mesh->ConstantBufferHandle();
 
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
+        if (queue.Change(STATE_ROOTSIGNATURE, ullong(rootSignature)))
+            commands.RootSignature(ullong(rootSignature));
 
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+        if (queue.Change(STATE_TOPOLOGY, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST))
+            commands.Topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-        if (!sceneTopDir.empty() && selectedIndex >= 0 && selectedIndex < sceneTopDir.size()) {
-            Object& selectedObject = sceneTopDir[selectedIndex];
+        if (queue.Change(STATE_VIEWPORT, v))
+            commands.Viewport(vp.TopLeftX, vp.TopLeftY, vp.Width, vp.Height, vp.MinDepth, vp.MaxDepth);
 
-            // Defina os fatores de escala (aumentar a escala em 20% no eixo Y)
-            float scaleX = 1.0f - 0.25f;
-            float scaleY = 1.0f - 0.25f;  // Aumentar a escala em scaleFactor no eixo Y
-            float scaleZ = 1.0f - 0.25f;
+        // cada vista desenha a mesma cena com suas prprias constantes
+        if (queue.Change(STATE_VIEWCONSTANTS, viewAddress))
+            commands.Constants(1, viewAddress);
 
-            // Crie uma matriz de escala
-            XMMATRIX scaleMatrix = XMMatrixScaling(scaleX, scaleY, scaleZ);
+        if (queue.Change(STATE_VERTEXBUFFER, data.vertexView.BufferLocation))
+            commands.VertexBuffer(data.vertexView.BufferLocation, data.vertexView.SizeInBytes, data.vertexView.StrideInBytes);
 
-            // Carregue a matriz de transformao atual do objeto em uma XMMATRIX
-            XMMATRIX currentTransform = XMLoadFloat4x4(&selectedObject.world);
+        if (queue.Change(STATE_INDEXBUFFER, data.indexView.BufferLocation))
+            commands.IndexBuffer(data.indexView.BufferLocation, data.indexView.SizeInBytes, data.indexView.Format == DXGI_FORMAT_R16_UINT ? 2 : 4);
 
-            // Multiplique a matriz de escala pela matriz de transformao atual
-            XMMATRIX newTransform = scaleMatrix * currentTransform;
+        // ajusta o buffer constante associado ao vertex shader
+        if (queue.Change(STATE_OBJECTCONSTANTS, table.ptr))
+            commands.Table(0, table.ptr);
 
-            // Armazene a nova matriz de transformao no objeto
-            XMStoreFloat4x4(&selectedObject.world, newTransform);
-        }
+        // desenha objeto
+        commands.Draw(data.submesh.indexCount, data.submesh.startIndex, int(data.submesh.baseVertex));
     }
+}
 
-    // mouse positions
-    float mousePosX = (float)input->MouseX();
-    float mousePosY = (float)input->MouseY();
+// ------------------------------------------------------------------------------
 
-    if (input->KeyDown(VK_LBUTTON) && quadViewMode == false)
-    {
-        // cada pixel corresponde a 1/4 de grau
-        float dx = XMConvertToRadians(0.25f * (mousePosX - lastMousePosX));
-        float dy = XMConvertToRadians(0.25f * (mousePosY - lastMousePosY));
+void Multi::Finalize()
+{
+    delete overlay;
+    delete recorder;
+    graphics->Free(viewConstants);
 
-        // atualiza ngulos com base no deslocamento do mouse
-        // para orbitar a cmera ao redor da caixa
-        theta += dx;
-        phi += dy;
+    // assinatura raiz e pipelines pertencem ao cache
+    delete pipelines;
 
-        // restringe o ngulo de phi ]0-180[ graus
-        phi = phi < 0.1f ? 0.1f : (phi > (XM_PI - 0.1f) ? XM_PI - 0.1f : phi);
-    }
-    else if (input->KeyDown(VK_RBUTTON) && quadViewMode == false)
+    // objetos com tesselao so donos de suas malhas
+    for (auto& obj : scene)
     {
-        // cada pixel corresponde a 0.05 unidades
-        float dx = 0.05f * (mousePosX - lastMousePosX);
-        float dy = 0.05f * (mousePosY - lastMousePosY);
-
-        // atualiza o raio da cmera com base no deslocamento do mouse 
-        radius += dx - dy;
-
-        // restringe o raio (3 a 15 unidades)
-        radius = radius < 3.0f ? 3.0f : (radius > 15.0f ? 15.0f : radius);
+        if (obj.tess) delete obj.tess; else delete obj.mesh;
+        delete obj.pick;
     }
+}
 
-    lastMousePosX = mousePosX;
-    lastMousePosY = mousePosY;
-
-    // converte coordenadas esfricas para cartesianas
-    float x = radius * sinf(phi) * cosf(theta);
-    float z = radius * sinf(phi) * sinf(theta);
-    float y = radius * cosf(phi);
-
-    // constri a matriz da cmera (view matrix)
-    XMVECTOR pos = XMVectorSet(x, y, z, 1.0f);
-    XMVECTOR target = XMVectorZero();
-    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMMATRIX view = XMMatrixLookAtLH(pos, target, up);
-    XMStoreFloat4x4(&View, view);
-
-    // carrega matriz de projeo em uma XMMATRIX
-    XMMATRIX proj = XMLoadFloat4x4(&Proj);
+// ------------------------------------------------------------------------------
 
-    XMMATRIX projOrtho = XMMatrixOrthographicLH(10, 10, 1.0f, 100.0f);
+void Multi::Tessellate(Object& obj)
+{
+    uint bucket = Tessellation::Default;
 
-    // ajusta o buffer constante de cada objeto
-    // cena original
-    for (auto& obj : scene)
+    if (adaptiveTess)
     {
-        // carrega matriz de mundo em uma XMMATRIX
         XMMATRIX world = XMLoadFloat4x4(&obj.world);
 
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view * proj;
+        // maior fator de escala da matriz de mundo
+        float scale = XMVectorGetX(XMVector3Length(world.r[0]));
+        scale = max(scale, XMVectorGetX(XMVector3Length(world.r[1])));
+        scale = max(scale, XMVectorGetX(XMVector3Length(world.r[2])));
 
-        // atualiza o buffer constante com a matriz combinada
-        ObjectConstants constants;
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-        obj.mesh->CopyConstants(&constants);
-    }
+        // a malha  compartilhada: a vista em que o objeto
+        // aparece maior define o nvel de detalhe
+        bucket = 0;
 
-    // constri a matriz da cmera (view matrix)
-    XMVECTOR pos1 = XMVectorSet(0, 0, 2.0f, 1.0f);
-    XMVECTOR target1 = XMVectorZero();
-    XMVECTOR up1 = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMMATRIX view1 = XMMatrixLookAtLH(pos1, target1, up1);
-    for (auto& obj : sceneTopEsq)
-    {
-        // carrega matriz de mundo em uma XMMATRIX
-        XMMATRIX world = XMLoadFloat4x4(&obj.world);
+        for (uint v = firstView; v < cameras.size(); ++v)
+        {
+            XMMATRIX proj = XMLoadFloat4x4(&cameras[v].proj);
 
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view1 * projOrtho;
+            // o componente w do centro no espao de recorte  a profundidade
+            // na perspectiva e vale 1 na projeo ortogrfica
+            XMVECTOR center = XMVector4Transform(world.r[3], XMLoadFloat4x4(&cameras[v].viewProj));
+            float w = max(XMVectorGetW(center), 0.1f);
 
-        // atualiza o buffer constante com a matriz combinada
-        ObjectConstants constants;
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-        obj.mesh->CopyConstants(&constants);
+            // raio projetado em pixels na viewport
+            float pixels = obj.tess->Radius() * scale * XMVectorGetY(proj.r[1]) * 0.5f * cameras[v].viewport.Height / w;
+            bucket = max(bucket, Tessellation::Bucket(pixels));
+        }
     }
 
-    XMVECTOR pos2 = XMVectorSet(5.0f, 0, 0.0f, 1.0f);
-    XMVECTOR target2 = XMVectorZero();
-    XMVECTOR up2 = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMMATRIX view2 = XMMatrixLookAtLH(pos2, target2, up2);
-    for (auto& obj : sceneBaixEsq)
-    {
-        // carrega matriz de mundo em uma XMMATRIX
-        XMMATRIX world = XMLoadFloat4x4(&obj.world);
+    // continua usando a variante atual at que a desejada esteja na GPU
+    Mesh* previous = obj.mesh;
+    obj.tess->Request(bucket);
+    obj.mesh = obj.tess->Current();
 
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view2 * projOrtho;
-
-        // atualiza o buffer constante com a matriz combinada
-        ObjectConstants constants;
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-        obj.mesh->CopyConstants(&constants);
-    }
+    // a nova variante tem seu prprio buffer com a matriz de mundo
+    if (obj.mesh != previous)
+        obj.dirty = Graphics::FrameCount;
+    obj.submesh.indexCount = obj.tess->IndexCount();
+}
 
-    XMVECTOR pos3 = XMVectorSet(0.0f, 4.0f, 0.0f, 1.0f);
-    XMVECTOR target3 = XMVectorZero();
-    XMVECTOR up3 = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
-    XMMATRIX view3 = XMMatrixLookAtLH(pos3, target3, up3);
-    for (auto& obj : sceneTopDir)
-    {
-        // carrega matriz de mundo em uma XMMATRIX
-        XMMATRIX world = XMLoadFloat4x4(&obj.world);
+// ------------------------------------------------------------------------------
 
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view3 * projOrtho;
+void Multi::UploadTessellations()
+{
+    bool ready = false;
 
-        // atualiza o buffer constante com a matriz combinada
-        ObjectConstants constants;
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-        obj.mesh->CopyConstants(&constants);
-    }
+    for (auto& obj : scene) if (obj.tess) ready |= obj.tess->Poll();
 
-    // linhas
-    for (auto& obj : lines)
+    // as variantes prontas entram no lote de cpia do quadro
+    if (ready)
     {
-        // lines vertical ok
-        XMVECTOR pos5 = XMVectorSet(0.0f, 0.0f, 1.0f, 1.0f);
-        XMMATRIX view5 = XMMatrixLookAtLH(pos5, target3, up3);
-        // carrega matriz de mundo em uma XMMATRIX
-        XMMATRIX world = XMLoadFloat4x4(&obj.world);
-        XMMATRIX x = XMMatrixOrthographicLH(10, 10, 1.0f, 100.0f);
-
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view5 * x;
-
-        // atualiza o buffer constante com a matriz combinada
-        ObjectConstants constants;
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-        lineH.mesh->CopyConstants(&constants);
-        lineV.mesh->CopyConstants(&constants);
+        std::lock_guard<std::mutex> lock(graphics->Mutex());
+        for (auto& obj : scene) if (obj.tess) obj.tess->Upload();
     }
+}
 
-    if (quadViewMode) {
-
-        graphics->ResetCommands();
-
-        // horizontal
-        Box box2(0.01f, 1000.0f, 0.0f);
-
-        for (auto& v : box2.vertices) v.color = XMFLOAT4(DirectX::Colors::Blue);
-
-        XMStoreFloat4x4(&lineV.world,
-            XMMatrixScaling(0.01f, 1.0f, 0.4f) *
-            XMMatrixTranslation(0.0, 0.0f, -0.1f));
-
-        lineV.mesh = new Mesh();
-        lineV.mesh->VertexBuffer(box2.VertexData(), box2.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        lineV.mesh->IndexBuffer(box2.IndexData(), box2.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        lineV.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        lineV.submesh.indexCount = box2.IndexCount();
-        lines.push_back(lineV);
-
-        Box box1(150.0f, 0.11f, 0.0f);
-        for (auto& v : box1.vertices) v.color = XMFLOAT4(DirectX::Colors::HotPink);
-
-        XMStoreFloat4x4(&lineH.world,
-            XMMatrixScaling(1.0f, 0.01f, 0.4f) *
-            XMMatrixTranslation(0.0, 0.0f, 0.0f));
-
-        lineH.mesh = new Mesh();
-        lineH.mesh->VertexBuffer(box1.VertexData(), box1.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        lineH.mesh->IndexBuffer(box1.IndexData(), box1.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        lineH.mesh->ConstantBuffer(sizeof(ObjectConstants));
-        lineH.submesh.indexCount = box1.IndexCount();
-        lines.push_back(lineH);
+// ------------------------------------------------------------------------------
 
+void Multi::AddObject(Geometry& geo, FXMMATRIX world, const XMFLOAT4& color)
+{
+    Object obj;
+    XMStoreFloat4x4(&obj.world, world);
+
+    // buffers e descritores so criados com o dispositivo livre
+    std::lock_guard<std::mutex> lock(graphics->Mutex());
+
+    // a cor fica nas constantes: os vrtices so brancos
+    obj.color = color;
+    for (auto& v : geo.vertices) v.color = XMFLOAT4(DirectX::Colors::White);
+
+    // a matriz de mundo  a mesma em todas as vistas
+    obj.mesh = new Mesh();
+    obj.mesh->VertexBuffer(geo.VertexData(), geo.VertexCount() * sizeof(Vertex), sizeof(Vertex));
+    obj.mesh->IndexBuffer(geo.IndexData(), geo.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
+    obj.mesh->ConstantBuffer(sizeof(ObjectConstants));
+    obj.submesh.indexCount = geo.IndexCount();
+    obj.bounds = Bounds::FromPoints(geo.VertexData(), geo.VertexCount(), sizeof(Vertex));
+    obj.pick = new PickMesh(geo.VertexData(), sizeof(Vertex), geo.IndexData(), geo.IndexCount());
+
+    // n raiz na hierarquia, com a matriz de mundo decomposta
+    obj.node = graph.Add(Trs::FromMatrix(&obj.world._11));
+
+    // volume no espao do mundo para o descarte
+    Bounds bounds = obj.bounds.Transform(&obj.world._11);
+    obj.occluder = IsOccluder(obj, bounds);
+    Handle handle = scene.Insert(obj);
+    culler.Add(bounds);
+    bvh.Add(bounds);
+
+    if (obj.node >= objectOf.size()) objectOf.resize(obj.node + 1);
+    objectOf[obj.node] = handle;
+
+    // sem seleo, o novo objeto passa a ser o selecionado
+    if (!Selected())
+        selected = handle;
+}
 
-        BuildRootSignature();
-        BuildPipelineState();
+// ------------------------------------------------------------------------------
 
-        graphics->SubmitCommands();
-    }
+void Multi::AddObject(const TessDesc& desc, FXMMATRIX world)
+{
+    Object obj;
+    XMStoreFloat4x4(&obj.world, world);
+
+    // buffers e descritores so criados com o dispositivo livre
+    std::lock_guard<std::mutex> lock(graphics->Mutex());
+
+    // a cor fica nas constantes: as variantes tm vrtices brancos
+    TessDesc white = desc;
+    white.color = XMFLOAT4(DirectX::Colors::White);
+    obj.color = desc.color;
+
+    // cada variante de tesselao tem seu buffer constante
+    obj.tess = new Tessellation(white, sizeof(ObjectConstants));
+    obj.mesh = obj.tess->Current();
+    obj.submesh.indexCount = obj.tess->IndexCount();
+
+    // o volume no depende da variante: vale para a forma exata
+    float r = obj.tess->Radius();
+    bool cylinder = (desc.shape == TESS_CYLINDER);
+    obj.bounds.extents[0] = obj.bounds.extents[2] = r;
+    obj.bounds.extents[1] = cylinder ? desc.height * 0.5f : r;
+    obj.bounds.radius = cylinder ? sqrtf(r * r + obj.bounds.extents[1] * obj.bounds.extents[1]) : r;
+
+    // a seleo usa a variante mais detalhada, prxima da forma exata
+    Geometry finest = Tessellation::Generate(desc, Tessellation::Buckets - 1);
+    obj.pick = new PickMesh(finest.VertexData(), sizeof(Vertex), finest.IndexData(), finest.IndexCount());
+
+    // n raiz na hierarquia, com a matriz de mundo decomposta
+    obj.node = graph.Add(Trs::FromMatrix(&obj.world._11));
+
+    // volume no espao do mundo para o descarte
+    Bounds bounds = obj.bounds.Transform(&obj.world._11);
+    obj.occluder = IsOccluder(obj, bounds);
+    Handle handle = scene.Insert(obj);
+    culler.Add(bounds);
+    bvh.Add(bounds);
+
+    if (obj.node >= objectOf.size()) objectOf.resize(obj.node + 1);
+    objectOf[obj.node] = handle;
+
+    // sem seleo, o novo objeto passa a ser o selecionado
+    if (!Selected())
+        selected = handle;
 }
 
 // ------------------------------------------------------------------------------
 
-void Multi::Draw()
+Object* Multi::Selected()
 {
-    graphics->Clear(pipelineState);
+    // nullptr se nada foi selecionado ou o objeto foi removido
+    return scene.Get(selected);
+}
 
-    if (quadViewMode) {
+// ------------------------------------------------------------------------------
 
-        for (auto& obj : lines)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-
-            // ajusta o buffer constante
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
-        }
+int Multi::Pick(float x, float y)
+{
+    for (uint v = firstView; v < cameras.size(); ++v)
+    {
+        // vista sob o cursor
+        const D3D12_VIEWPORT& vp = cameras[v].viewport;
 
-        for (auto& lineV : lines)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { lineV.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, lineV.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(lineV.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-
-            // Ajusta o buffer constante
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, lineV.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->RSSetViewports(1, &lineVview); // Use a viewport adequada para lineV
-            // Renderiza a linha vertical
-            graphics->CommandList()->DrawIndexedInstanced(
-                lineV.submesh.indexCount, 1,
-                lineV.submesh.startIndex,
-                lineV.submesh.baseVertex,
-                0);
-        }
+        if (x < vp.TopLeftX || x >= vp.TopLeftX + vp.Width || y < vp.TopLeftY || y >= vp.TopLeftY + vp.Height)
+            continue;
 
-        for (auto& lineH : lines)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { lineH.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, lineH.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(lineH.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-
-            // ajusta o buffer constante
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, lineH.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->RSSetViewports(1, &lineHview);
-            // Primeira viewport (Front)
-            graphics->CommandList()->DrawIndexedInstanced(
-                lineH.submesh.indexCount, 1,
-                lineH.submesh.startIndex,
-                lineH.submesh.baseVertex,
-                0);
-        }
+        // cursor no espao de recorte, nos planos prximo e distante
+        float nx = (x - vp.TopLeftX) / vp.Width * 2.0f - 1.0f;
+        float ny = 1.0f - (y - vp.TopLeftY) / vp.Height * 2.0f;
 
-        // cima esquerda
-        for (auto& obj : sceneTopEsq)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-            // ajusta o buffer constante
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->RSSetViewports(1, &viewFront);
-            // Primeira viewport (Front)
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
-        }
+        XMMATRIX invViewProj = XMMatrixInverse(nullptr, XMLoadFloat4x4(&cameras[v].viewProj));
+        XMVECTOR nearPoint = XMVector3TransformCoord(XMVectorSet(nx, ny, 0.0f, 1.0f), invViewProj);
+        XMVECTOR farPoint = XMVector3TransformCoord(XMVectorSet(nx, ny, 1.0f, 1.0f), invViewProj);
 
-        // baixo esquerda
-        for (auto& obj : sceneBaixEsq)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->RSSetViewports(1, &viewTop); // Altere para viewTop
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
-        }
+        // raio no mundo com t = 0 no plano prximo e t = 1 no distante
+        XMFLOAT3 origin, direction;
+        XMStoreFloat3(&origin, nearPoint);
+        XMStoreFloat3(&direction, farPoint - nearPoint);
 
-        // topo dir
-        for (auto& obj : sceneTopDir)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            graphics->CommandList()->RSSetViewports(1, &viewRight); // Altere para viewRight
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
-        }
+        bvh.Update();
+        int picked = -1;
 
-        for (auto& obj : scene)
-        {
-            // Comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-
-            // Quarta viewport (Perspective)
-            graphics->CommandList()->RSSetViewports(1, &viewPerspective); // Altere para viewPerspective
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
-        }
-        // apresenta o backbuffer na tela
-        graphics->Present();
-    }
-    else {
-        // desenha objetos da cena
-        graphics->Clear(pipelineState);
-        for (auto& obj : scene)
-        {
-            // comandos de configurao do pipeline
-            ID3D12DescriptorHeap* descriptorHeaps[] = { obj.mesh->ConstantBufferHeap() };
-            graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
-            graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
-            graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-            // ajusta o buffer constante associado ao vertex shader
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            // desenha objeto
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
+        // a BVH entrega os objetos cruzados; cada um testa seus tringulos
+        bvh.Raycast(&origin.x, &direction.x, 1.0f,
+            [&](uint i, float closest)
+            {
+                Object& obj = scene[i];
 
-        }
+                if (!obj.pick)
+                    return closest;
 
-        // trocar pra line list a linha
-        // apresenta o backbuffer na tela
-        graphics->Present();
-    }
+                // raio no espao do objeto: t continua o mesmo
+                XMMATRIX invWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&obj.world));
+                Ray ray;
+                XMStoreFloat3((XMFLOAT3*)ray.origin, XMVector3TransformCoord(nearPoint, invWorld));
+                XMStoreFloat3((XMFLOAT3*)ray.direction, XMVector3TransformNormal(farPoint - nearPoint, invWorld));
 
-    //graphics->Present();
+                float t;
+                uint triangle;
 
-}
+                if (!obj.pick->Intersect(ray, t, triangle, closest))
+                    return closest;
 
-void Multi::Finalize()
-{
-    rootSignature->Release();
-    pipelineState->Release();
+                picked = int(i);
+                return t;
+            });
 
-    for (auto& obj : scene)
-        delete obj.mesh;
+        return picked;
+    }
 
-    for (auto& obj : sceneBaixEsq)
-        delete obj.mesh;
+    return -1;
+}
 
-    for (auto& obj : sceneTopDir)
-        delete obj.mesh;
+// ------------------------------------------------------------------------------
 
-    for (auto& obj : sceneTopEsq)
-        delete obj.mesh;
+uint Multi::ViewSlot(uint view)
+{
+    // regies do quadro atual, uma por vista
+    return (graphics->FrameIndex() * VIEWS + view) * 256;
 }
 
-
-// ------------------------------------------------------------------------------
-//                                     D3D                                      
 // ------------------------------------------------------------------------------
 
 void Multi::BuildRootSignature()
@@ -2187,344 +1377,60 @@ void Multi::BuildRootSignature()
     cbvTable.RegisterSpace = 0;
     cbvTable.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-    // define parmetro raiz com uma tabela
-    D3D12_ROOT_PARAMETER rootParameters[1];
+    // tabela com as constantes do objeto e CBV raiz com as da vista
+    D3D12_ROOT_PARAMETER rootParameters[2];
     rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
     rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
     rootParameters[0].DescriptorTable.NumDescriptorRanges = 1;
     rootParameters[0].DescriptorTable.pDescriptorRanges = &cbvTable;
 
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+    rootParameters[1].Descriptor.ShaderRegister = 1;
+    rootParameters[1].Descriptor.RegisterSpace = 0;
+
     // uma assinatura raiz  um vetor de parmetros raiz
     D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-    rootSigDesc.NumParameters = 1;
+    rootSigDesc.NumParameters = 2;
     rootSigDesc.pParameters = rootParameters;
     rootSigDesc.NumStaticSamplers = 0;
     rootSigDesc.pStaticSamplers = nullptr;
     rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
-    // serializa assinatura raiz
-    ID3DBlob* serializedRootSig = nullptr;
-    ID3DBlob* error = nullptr;
-
-    ThrowIfFailed(D3D12SerializeRootSignature(
-        &rootSigDesc,
-        D3D_ROOT_SIGNATURE_VERSION_1,
-        &serializedRootSig,
-        &error));
-
-    if (error != nullptr)
-    {
-        OutputDebugString((char*)error->GetBufferPointer());
-    }
-
-    // cria uma assinatura raiz com um nico slot que aponta para  
-    // uma faixa de descritores consistindo de um nico buffer constante
-    ThrowIfFailed(graphics->Device()->CreateRootSignature(
-        0,
-        serializedRootSig->GetBufferPointer(),
-        serializedRootSig->GetBufferSize(),
-        IID_PPV_ARGS(&rootSignature)));
+    // serializao e criao s ocorrem na primeira vez
+    rootSignature = pipelines->RootSignature(rootSigDesc);
 }
 
 // ------------------------------------------------------------------------------
 
 void Multi::BuildPipelineState()
 {
-    // --------------------
-    // --- Input Layout ---
-    // --------------------
-
-    D3D12_INPUT_ELEMENT_DESC inputLayout[2] =
-    {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
-
-    // --------------------
-    // ----- Shaders ------
-    // --------------------
-
-    ID3DBlob* vertexShader;
-    ID3DBlob* pixelShader;
-
-    D3DReadFileToBlob(L"Shaders/Vertex.cso", &vertexShader);
-    D3DReadFileToBlob(L"Shaders/Pixel.cso", &pixelShader);
-
-    // --------------------
-    // ---- Rasterizer ----
-    // --------------------
-
-    D3D12_RASTERIZER_DESC rasterizer = {};
-    //rasterizer.FillMode = D3D12_FILL_MODE_SOLID;
-    rasterizer.FillMode = D3D12_FILL_MODE_WIREFRAME;
-    rasterizer.CullMode = D3D12_CULL_MODE_BACK;
-    rasterizer.FrontCounterClockwise = FALSE;
-    rasterizer.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
-    rasterizer.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
-    rasterizer.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
-    rasterizer.DepthClipEnable = TRUE;
-    rasterizer.MultisampleEnable = FALSE;
-    rasterizer.AntialiasedLineEnable = FALSE;
-    rasterizer.ForcedSampleCount = 0;
-    rasterizer.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
-
-    // ---------------------
-    // --- Color Blender ---
-    // ---------------------
-
-    D3D12_BLEND_DESC blender = {};
-    blender.AlphaToCoverageEnable = FALSE;
-    blender.IndependentBlendEnable = FALSE;
-    const D3D12_RENDER_TARGET_BLEND_DESC defaultRenderTargetBlendDesc =
-    {
-        FALSE,FALSE,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_LOGIC_OP_NOOP,
-        D3D12_COLOR_WRITE_ENABLE_ALL,
-    };
-    for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
-        blender.RenderTarget[i] = defaultRenderTargetBlendDesc;
-
-    // ---------------------
-    // --- Depth Stencil ---
-    // ---------------------
-
-    D3D12_DEPTH_STENCIL_DESC depthStencil = {};
-    depthStencil.DepthEnable = TRUE;
-    depthStencil.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
-    depthStencil.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
-    depthStencil.StencilEnable = FALSE;
-    depthStencil.StencilReadMask = D3D12_DEFAULT_STENCIL_READ_MASK;
-    depthStencil.StencilWriteMask = D3D12_DEFAULT_STENCIL_WRITE_MASK;
-    const D3D12_DEPTH_STENCILOP_DESC defaultStencilOp =
-    { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
-    depthStencil.FrontFace = defaultStencilOp;
-    depthStencil.BackFace = defaultStencilOp;
-
-    // -----------------------------------
-    // --- Pipeline State Object (PSO) ---
-    // -----------------------------------
-
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC pso = {};
-    pso.pRootSignature = rootSignature;
-    pso.VS = { reinterpret_cast<BYTE*>(vertexShader->GetBufferPointer()), vertexShader->GetBufferSize() };
-    pso.PS = { reinterpret_cast<BYTE*>(pixelShader->GetBufferPointer()), pixelShader->GetBufferSize() };
-    pso.BlendState = blender;
-    pso.SampleMask = UINT_MAX;
-    pso.RasterizerState = rasterizer;
-    pso.DepthStencilState = depthStencil;
-    pso.InputLayout = { inputLayout, 2 };
-    pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-    pso.NumRenderTargets = 1;
-    pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-    pso.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    pso.SampleDesc.Count = graphics->Antialiasing();
-    pso.SampleDesc.Quality = graphics->Quality();
-    graphics->Device()->CreateGraphicsPipelineState(&pso, IID_PPV_ARGS(&pipelineState));
-
-    vertexShader->Release();
-    pixelShader->Release();
+    // descarta faces de trs
+    PipelineDesc desc;
+    desc.cull = D3D12_CULL_MODE_BACK;
+    desc.inputLayout = VertexLayout;
+    desc.inputCount = _countof(VertexLayout);
+    desc.rootSignature = rootSignature;
+
+    // compilado apenas na primeira vez em que a descrio aparece
+    pipelineState = pipelines->Pipeline(desc, graphics->Antialiasing(), graphics->Quality());
 }
 
+// ------------------------------------------------------------------------------
 
-
-void Multi::BuildPipelineStateFront()
-{
-    // --------------------
-    // --- Input Layout ---
-    // --------------------
-
-    D3D12_INPUT_ELEMENT_DESC inputLayout[2] =
-    {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
-
-    // --------------------
-    // ----- Shaders ------
-    // --------------------
-
-    ID3DBlob* vertexShader;
-    ID3DBlob* pixelShader;
-
-    D3DReadFileToBlob(L"Shaders/Vertex.cso", &vertexShader);
-    D3DReadFileToBlob(L"Shaders/Pixel.cso", &pixelShader);
-
-    // --------------------
-    // ---- Rasterizer ----
-    // --------------------
-
-    D3D12_RASTERIZER_DESC rasterizer = {};
-    //rasterizer.FillMode = D3D12_FILL_MODE_SOLID;
-    rasterizer.FillMode = D3D12_FILL_MODE_WIREFRAME;
-    rasterizer.CullMode = D3D12_CULL_MODE_FRONT;
-    rasterizer.FrontCounterClockwise = FALSE;
-    rasterizer.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
-    rasterizer.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
-    rasterizer.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
-    rasterizer.DepthClipEnable = TRUE;
-    rasterizer.MultisampleEnable = FALSE;
-    rasterizer.AntialiasedLineEnable = FALSE;
-    rasterizer.ForcedSampleCount = 0;
-    rasterizer.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
-
-    // ---------------------
-    // --- Color Blender ---
-    // ---------------------
-
-    D3D12_BLEND_DESC blender = {};
-    blender.AlphaToCoverageEnable = FALSE;
-    blender.IndependentBlendEnable = FALSE;
-    const D3D12_RENDER_TARGET_BLEND_DESC defaultRenderTargetBlendDesc =
-    {
-        FALSE,FALSE,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_LOGIC_OP_NOOP,
-        D3D12_COLOR_WRITE_ENABLE_ALL,
-    };
-    for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
-        blender.RenderTarget[i] = defaultRenderTargetBlendDesc;
-
-    // ---------------------
-    // --- Depth Stencil ---
-    // ---------------------
-
-    D3D12_DEPTH_STENCIL_DESC depthStencil = {};
-    depthStencil.DepthEnable = TRUE;
-    depthStencil.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
-    depthStencil.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
-    depthStencil.StencilEnable = FALSE;
-    depthStencil.StencilReadMask = D3D12_DEFAULT_STENCIL_READ_MASK;
-    depthStencil.StencilWriteMask = D3D12_DEFAULT_STENCIL_WRITE_MASK;
-    const D3D12_DEPTH_STENCILOP_DESC defaultStencilOp =
-    { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
-    depthStencil.FrontFace = defaultStencilOp;
-    depthStencil.BackFace = defaultStencilOp;
-
-    // -----------------------------------
-    // --- Pipeline State Object (PSO) ---
-    // -----------------------------------
-
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC pso = {};
-    pso.pRootSignature = rootSignature;
-    pso.VS = { reinterpret_cast<BYTE*>(vertexShader->GetBufferPointer()), vertexShader->GetBufferSize() };
-    pso.PS = { reinterpret_cast<BYTE*>(pixelShader->GetBufferPointer()), pixelShader->GetBufferSize() };
-    pso.BlendState = blender;
-    pso.SampleMask = UINT_MAX;
-    pso.RasterizerState = rasterizer;
-    pso.DepthStencilState = depthStencil;
-    pso.InputLayout = { inputLayout, 2 };
-    pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-    pso.NumRenderTargets = 1;
-    pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-    pso.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    pso.SampleDesc.Count = graphics->Antialiasing();
-    pso.SampleDesc.Quality = graphics->Quality();
-    graphics->Device()->CreateGraphicsPipelineState(&pso, IID_PPV_ARGS(&pipelineState));
-
-    vertexShader->Release();
-    pixelShader->Release();
-}
-
-void Multi::BuildPipelineStateNone()
+void Multi::BuildLinePipeline()
 {
-    // --------------------
-    // --- Input Layout ---
-    // --------------------
-
-    D3D12_INPUT_ELEMENT_DESC inputLayout[2] =
-    {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
-
-    // --------------------
-    // ----- Shaders ------
-    // --------------------
-
-    ID3DBlob* vertexShader;
-    ID3DBlob* pixelShader;
-
-    D3DReadFileToBlob(L"Shaders/Vertex.cso", &vertexShader);
-    D3DReadFileToBlob(L"Shaders/Pixel.cso", &pixelShader);
-
-    // --------------------
-    // ---- Rasterizer ----
-    // --------------------
-
-    D3D12_RASTERIZER_DESC rasterizer = {};
-    //rasterizer.FillMode = D3D12_FILL_MODE_SOLID;
-    rasterizer.FillMode = D3D12_FILL_MODE_WIREFRAME;
-    rasterizer.CullMode = D3D12_CULL_MODE_NONE;
-    rasterizer.FrontCounterClockwise = FALSE;
-    rasterizer.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
-    rasterizer.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
-    rasterizer.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
-    rasterizer.DepthClipEnable = TRUE;
-    rasterizer.MultisampleEnable = FALSE;
-    rasterizer.AntialiasedLineEnable = FALSE;
-    rasterizer.ForcedSampleCount = 0;
-    rasterizer.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
-
-    // ---------------------
-    // --- Color Blender ---
-    // ---------------------
-
-    D3D12_BLEND_DESC blender = {};
-    blender.AlphaToCoverageEnable = FALSE;
-    blender.IndependentBlendEnable = FALSE;
-    const D3D12_RENDER_TARGET_BLEND_DESC defaultRenderTargetBlendDesc =
-    {
-        FALSE,FALSE,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
-        D3D12_LOGIC_OP_NOOP,
-        D3D12_COLOR_WRITE_ENABLE_ALL,
-    };
-    for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
-        blender.RenderTarget[i] = defaultRenderTargetBlendDesc;
-
-    // ---------------------
-    // --- Depth Stencil ---
-    // ---------------------
-
-    D3D12_DEPTH_STENCIL_DESC depthStencil = {};
-    depthStencil.DepthEnable = TRUE;
-    depthStencil.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
-    depthStencil.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
-    depthStencil.StencilEnable = FALSE;
-    depthStencil.StencilReadMask = D3D12_DEFAULT_STENCIL_READ_MASK;
-    depthStencil.StencilWriteMask = D3D12_DEFAULT_STENCIL_WRITE_MASK;
-    const D3D12_DEPTH_STENCILOP_DESC defaultStencilOp =
-    { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
-    depthStencil.FrontFace = defaultStencilOp;
-    depthStencil.BackFace = defaultStencilOp;
-
-    // -----------------------------------
-    // --- Pipeline State Object (PSO) ---
-    // -----------------------------------
-
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC pso = {};
-    pso.pRootSignature = rootSignature;
-    pso.VS = { reinterpret_cast<BYTE*>(vertexShader->GetBufferPointer()), vertexShader->GetBufferSize() };
-    pso.PS = { reinterpret_cast<BYTE*>(pixelShader->GetBufferPointer()), pixelShader->GetBufferSize() };
-    pso.BlendState = blender;
-    pso.SampleMask = UINT_MAX;
-    pso.RasterizerState = rasterizer;
-    pso.DepthStencilState = depthStencil;
-    pso.InputLayout = { inputLayout, 2 };
-    pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-    pso.NumRenderTargets = 1;
-    pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-    pso.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    pso.SampleDesc.Count = graphics->Antialiasing();
-    pso.SampleDesc.Quality = graphics->Quality();
-    graphics->Device()->CreateGraphicsPipelineState(&pso, IID_PPV_ARGS(&pipelineState));
-
-    vertexShader->Release();
-    pixelShader->Release();
+    // linhas slidas desenhadas por cima de tudo
+    PipelineDesc desc;
+    desc.fill = D3D12_FILL_MODE_SOLID;
+    desc.cull = D3D12_CULL_MODE_NONE;
+    desc.topology = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+    desc.depthEnable = false;
+    desc.inputLayout = VertexLayout;
+    desc.inputCount = _countof(VertexLayout);
+    desc.rootSignature = rootSignature;
+
+    linePipeline = pipelines->Pipeline(desc, graphics->Antialiasing(), graphics->Quality());
 }
 
 // ------------------------------------------------------------------------------
@@ -2549,6 +1455,12 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance,
         engine->window->LostFocus(Engine::Pause);
         engine->window->InFocus(Engine::Resume);
 
+        // heap de descritores para todas as variantes de MaxObjects objetos
+        engine->graphics->Descriptors(MaxObjects * Tessellation::Buckets * Graphics::FrameCount);
+
+        // desenha o quadro N enquanto o quadro N+1  atualizado
+        engine->pipelined = true;
+
         // cria e executa a aplicao
         engine->Start(new Multi());
 
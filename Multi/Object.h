@@ -14,8 +14,14 @@
 
 #include "Types.h"
 #include "Mesh.h"
+#include "Culling.h"
+#include "Picking.h"
+#include "SceneGraph.h"
 #include <DirectXMath.h>
 using DirectX::XMFLOAT4X4;
+using DirectX::XMFLOAT4;
+
+class Tessellation;
 
 struct Object
 {
@@ -25,9 +31,16 @@ struct Object
 		0.0f, 0.0f, 1.0f, 0.0f,
 		0.0f, 0.0f, 0.0f, 1.0f };
 
-	uint cbIndex = -1;			    // ndice para o constant buffer
+	XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };	// cor do objeto (tinge os vrtices)
+	Bounds bounds;					// volume envolvente no espao do objeto
+
+	uint dirty = Graphics::FrameCount;	// quadros que ainda precisam das constantes atuais
 	Mesh * mesh = nullptr;			// malha de vrtices
 	SubMesh submesh {};	            // informaes da sub-malha
+	Tessellation * tess = nullptr;	// variantes de tesselao (esferas e cilindros)
+	PickMesh * pick = nullptr;		// tringulos na CPU para a seleo por raio
+	bool occluder = false;			// rasterizado na CPU para esconder outros objetos
+	uint node = SceneGraph::None;	// n na hierarquia da cena
 };
 
 #endif
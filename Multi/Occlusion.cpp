@@ -0,0 +1,330 @@
+/**********************************************************************************
+// Occlusion (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Descarte por ocluso feito na CPU. Os tringulos dos oclusores
+//              so rasterizados com SSE, 4 pixels por vez, em um buffer de
+//              profundidade de baixa resoluo. Cada pixel coberto recebe a
+//              maior profundidade do tringulo sobre ele e o retngulo dos
+//              objetos testados  alargado em um pixel, o que torna o teste
+//              conservador apesar da amostragem no centro. O buffer  resumido
+//              em blocos de 8x8 pixels com a profundidade mais distante de cada
+//              bloco, e a caixa projetada de um objeto  comparada apenas com
+//              esses blocos. A profundidade vai de 0 a 1.
+//
+**********************************************************************************/
+
+#include "Occlusion.h"
+#include "Culling.h"
+#include "Picking.h"
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+// -------------------------------------------------------------------------------
+
+// menor w aceito: tringulos e caixas que cruzam o plano da cmera no so projetados
+static const float MinW = 1e-5f;
+
+// ponto vezes matriz (vetor linha)
+static void Project(const float * p, const float * m, float * clip)
+{
+    for (uint c = 0; c < 4; ++c)
+        clip[c] = p[0] * m[c] + p[1] * m[4 + c] + p[2] * m[8 + c] + m[12 + c];
+}
+
+// -------------------------------------------------------------------------------
+
+OcclusionBuffer::OcclusionBuffer(uint w, uint h)
+{
+    // dimenses arredondadas para blocos inteiros
+    tilesX = std::max(1u, (w + Tile - 1) / Tile);
+    tilesY = std::max(1u, (h + Tile - 1) / Tile);
+    width = tilesX * Tile;
+    height = tilesY * Tile;
+
+    depth.assign(size_t(width) * height, 1.0f);
+    tiles.assign(size_t(tilesX) * tilesY, 1.0f);
+
+    for (uint i = 0; i < 16; ++i)
+        viewProj[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+}
+
+// -------------------------------------------------------------------------------
+
+void OcclusionBuffer::Begin(const float * m)
+{
+    start = std::chrono::steady_clock::now();
+
+    std::copy(m, m + 16, viewProj);
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    std::fill(tiles.begin(), tiles.end(), 1.0f);
+
+    stats = OcclusionStats {};
+}
+
+// -------------------------------------------------------------------------------
+
+void OcclusionBuffer::Rasterize(const PickMesh & mesh, const float * world)
+{
+    // mundo e vista combinados: um produto por vrtice
+    float m[16];
+
+    for (uint r = 0; r < 4; ++r)
+        for (uint c = 0; c < 4; ++c)
+            m[r * 4 + c] = world[r * 4] * viewProj[c] + world[r * 4 + 1] * viewProj[4 + c]
+                         + world[r * 4 + 2] * viewProj[8 + c] + world[r * 4 + 3] * viewProj[12 + c];
+
+    __m128 col[4][4];
+
+    for (uint r = 0; r < 4; ++r)
+        for (uint c = 0; c < 4; ++c)
+            col[r][c] = _mm_set1_ps(m[r * 4 + c]);
+
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 minW = _mm_set1_ps(MinW);
+    __m128 w = _mm_set1_ps(float(width));
+    __m128 h = _mm_set1_ps(float(height));
+    alignas(16) float sx[3][4], sy[3][4], sz[3][4];
+
+    // os blocos j esto em estrutura de vetores: a projeo dos vrtices
+    //  feita para 4 tringulos de uma vez
+    for (const PickMesh::Block & block : mesh.Blocks())
+    {
+        for (uint base = 0; base < PickMesh::Width; base += 4)
+        {
+            __m128 v[3][3], reject = zero;
+
+            for (uint k = 0; k < 3; ++k)
+            {
+                v[0][k] = _mm_loadu_ps(block.v0[k] + base);
+                v[1][k] = _mm_add_ps(v[0][k], _mm_loadu_ps(block.e1[k] + base));
+                v[2][k] = _mm_add_ps(v[0][k], _mm_loadu_ps(block.e2[k] + base));
+            }
+
+            for (uint i = 0; i < 3; ++i)
+            {
+                __m128 clip[4];
+
+                for (uint c = 0; c < 4; ++c)
+                    clip[c] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v[i][0], col[0][c]), _mm_mul_ps(v[i][1], col[1][c])),
+                                         _mm_add_ps(_mm_mul_ps(v[i][2], col[2][c]), col[3][c]));
+
+                // vrtices atrs da cmera ou antes do plano prximo descartam o tringulo
+                reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(clip[3], minW), _mm_cmplt_ps(clip[2], zero)));
+
+                __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), clip[3]);
+                _mm_store_ps(sx[i], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(clip[0], inv), half), half), w));
+                _mm_store_ps(sy[i], _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(clip[1], inv), half)), h));
+                _mm_store_ps(sz[i], _mm_mul_ps(clip[2], inv));
+            }
+
+            int lanes = ~_mm_movemask_ps(reject) & 0xF;
+
+            for (uint l = 0; l < 4; ++l)
+            {
+                if (lanes & (1 << l))
+                {
+                    float x[3] = { sx[0][l], sx[1][l], sx[2][l] };
+                    float y[3] = { sy[0][l], sy[1][l], sy[2][l] };
+                    float z[3] = { sz[0][l], sz[1][l], sz[2][l] };
+                    Triangle(x, y, z);
+                }
+            }
+        }
+    }
+
+    ++stats.occluders;
+    stats.triangles += mesh.Triangles();
+}
+
+// -------------------------------------------------------------------------------
+
+void OcclusionBuffer::Triangle(float * x, float * y, float * z)
+{
+    // orientao positiva para que o interior tenha as trs funes de aresta >= 0
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+
+    if (fabsf(area) < 1e-6f)
+        return;
+
+    if (area < 0)
+    {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    // pixels com o centro dentro da caixa do tringulo; tringulos menores
+    // que um pixel costumam no ter nenhum e saem aqui
+    int x0 = std::max(0, int(ceilf(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+    int x1 = std::min(int(width) - 1, int(floorf(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+    int y0 = std::max(0, int(ceilf(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+    int y1 = std::min(int(height) - 1, int(floorf(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    // aresta oposta ao vrtice i: E(p) = A x + B y + C, com E / area igual
+    //  coordenada baricntrica do vrtice i; o pixel  coberto se E >= 0
+    // no centro para as trs arestas
+    float A[3], B[3], C[3];
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        uint j = (i + 1) % 3, k = (i + 2) % 3;
+        A[i] = y[j] - y[k];
+        B[i] = x[k] - x[j];
+        C[i] = -(A[i] * x[j] + B[i] * y[j]);
+    }
+
+    // plano da profundidade, avaliado no canto mais distante de cada pixel
+    float zA = (A[0] * z[0] + A[1] * z[1] + A[2] * z[2]) / area;
+    float zB = (B[0] * z[0] + B[1] * z[1] + B[2] * z[2]) / area;
+    float zC = (C[0] * z[0] + C[1] * z[1] + C[2] * z[2]) / area + 0.5f * (fabsf(zA) + fabsf(zB));
+    float zMax = std::max({ z[0], z[1], z[2] });
+
+    // 4 pixels por vez a partir de uma coluna alinhada (a largura  mltipla de 4)
+    int xs = x0 & ~3;
+    __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 step[3], stepZ = _mm_set1_ps(4.0f * zA), vMax = _mm_set1_ps(zMax);
+
+    for (uint i = 0; i < 3; ++i)
+        step[i] = _mm_set1_ps(4.0f * A[i]);
+
+    for (int py = y0; py <= y1; ++py)
+    {
+        float cy = py + 0.5f;
+        __m128 px = _mm_add_ps(_mm_set1_ps(float(xs)), offsets);
+        __m128 e[3];
+
+        for (uint i = 0; i < 3; ++i)
+            e[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[i]), px), _mm_set1_ps(B[i] * cy + C[i]));
+
+        __m128 pz = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(zA), px), _mm_set1_ps(zB * cy + zC));
+        float * row = depth.data() + size_t(py) * width;
+
+        for (int px4 = xs; px4 <= x1; px4 += 4)
+        {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e[0], zero), _mm_cmpge_ps(e[1], zero)),
+                                       _mm_cmpge_ps(e[2], zero));
+
+            if (_mm_movemask_ps(inside))
+            {
+                __m128 old = _mm_loadu_ps(row + px4);
+                __m128 d = _mm_min_ps(old, _mm_min_ps(pz, vMax));
+                _mm_storeu_ps(row + px4, _mm_or_ps(_mm_and_ps(inside, d), _mm_andnot_ps(inside, old)));
+            }
+
+            for (uint i = 0; i < 3; ++i)
+                e[i] = _mm_add_ps(e[i], step[i]);
+
+            pz = _mm_add_ps(pz, stepZ);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void OcclusionBuffer::Finish()
+{
+    // cada bloco guarda a profundidade mais distante de seus pixels
+    for (uint ty = 0; ty < tilesY; ++ty)
+    {
+        for (uint tx = 0; tx < tilesX; ++tx)
+        {
+            __m128 m = _mm_setzero_ps();
+
+            for (uint r = 0; r < Tile; ++r)
+            {
+                const float * p = depth.data() + size_t(ty * Tile + r) * width + tx * Tile;
+
+                for (uint c = 0; c < Tile; c += 4)
+                    m = _mm_max_ps(m, _mm_loadu_ps(p + c));
+            }
+
+            m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+            tiles[ty * tilesX + tx] = _mm_cvtss_f32(m);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool OcclusionBuffer::Occluded(const Bounds & bounds)
+{
+    ++stats.occludees;
+
+    // retngulo na tela e profundidade mais prxima dos 8 cantos da caixa
+    float xMin = 3.4e38f, yMin = 3.4e38f, xMax = -3.4e38f, yMax = -3.4e38f, zMin = 3.4e38f;
+    bool projected = true;
+
+    for (uint i = 0; i < 8; ++i)
+    {
+        float p[3], clip[4];
+
+        for (uint k = 0; k < 3; ++k)
+            p[k] = bounds.center[k] + ((i >> k) & 1 ? bounds.extents[k] : -bounds.extents[k]);
+
+        Project(p, viewProj, clip);
+
+        // caixas que cruzam o plano prximo so tratadas como visveis
+        if (clip[3] < MinW || clip[2] < 0.0f)
+        {
+            projected = false;
+            break;
+        }
+
+        float inv = 1.0f / clip[3];
+        float sx = (clip[0] * inv * 0.5f + 0.5f) * width;
+        float sy = (0.5f - clip[1] * inv * 0.5f) * height;
+
+        xMin = std::min(xMin, sx); xMax = std::max(xMax, sx);
+        yMin = std::min(yMin, sy); yMax = std::max(yMax, sy);
+        zMin = std::min(zMin, clip[2] * inv);
+    }
+
+    bool hidden = false;
+
+    if (projected)
+    {
+        // um pixel a mais em cada lado alcana a vizinhana de pixels
+        // cobertos s em parte pelos oclusores
+        int x0 = std::max(0, int(floorf(xMin)) - 1);
+        int x1 = std::min(int(width) - 1, int(floorf(xMax)) + 1);
+        int y0 = std::max(0, int(floorf(yMin)) - 1);
+        int y1 = std::min(int(height) - 1, int(floorf(yMax)) + 1);
+
+        // escondido apenas se todos os blocos sob o retngulo esto mais prximos
+        if (x0 <= x1 && y0 <= y1)
+        {
+            hidden = true;
+
+            for (uint ty = y0 / Tile; hidden && ty <= y1 / Tile; ++ty)
+                for (uint tx = x0 / Tile; hidden && tx <= x1 / Tile; ++tx)
+                    hidden = tiles[ty * tilesX + tx] < zMin;
+        }
+    }
+
+    if (hidden)
+        ++stats.occluded;
+
+    return hidden;
+}
+
+// -------------------------------------------------------------------------------
+
+void OcclusionBuffer::End()
+{
+    // um nico par de leituras do relgio cobre a vista inteira
+    stats.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+/**********************************************************************************
+// Occlusion (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Descarte por ocluso feito na CPU. Os tringulos dos oclusores
+//              so rasterizados com SSE, 4 pixels por vez, em um buffer de
+//              profundidade de baixa resoluo. Cada pixel coberto recebe a
+//              maior profundidade do tringulo sobre ele e o retngulo dos
+//              objetos testados  alargado em um pixel, o que torna o teste
+//              conservador apesar da amostragem no centro. O buffer  resumido
+//              em blocos de 8x8 pixels com a profundidade mais distante de cada
+//              bloco, e a caixa projetada de um objeto  comparada apenas com
+//              esses blocos. A profundidade vai de 0 a 1.
+//
+**********************************************************************************/
+
+#ifndef DXUT_OCCLUSION_H_
+#define DXUT_OCCLUSION_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <chrono>
+#include <vector>
+using std::vector;
+
+struct Bounds;
+class PickMesh;
+
+// -------------------------------------------------------------------------------
+
+struct OcclusionStats
+{
+    uint   occluders = 0;                   // malhas rasterizadas
+    uint   triangles = 0;                   // tringulos dos oclusores
+    uint   occludees = 0;                   // objetos testados contra o buffer
+    uint   occluded = 0;                    // objetos escondidos pelos oclusores
+    double time = 0;                        // milissegundos gastos no quadro
+};
+
+// -------------------------------------------------------------------------------
+
+class OcclusionBuffer
+{
+public:
+    static const uint Tile = 8;             // lado dos blocos da hierarquia em pixels
+
+private:
+    uint width;                             // largura do buffer (mltiplo de Tile)
+    uint height;                            // altura do buffer (mltiplo de Tile)
+    uint tilesX;                            // blocos por linha
+    uint tilesY;                            // linhas de blocos
+    vector<float> depth;                    // profundidade mais prxima de cada pixel
+    vector<float> tiles;                    // profundidade mais distante de cada bloco
+    float viewProj[16];                     // matriz da vista
+    OcclusionStats stats;                   // contagens e tempo do quadro
+    std::chrono::steady_clock::time_point start;    // incio do trabalho da vista
+
+    void Triangle(float * x, float * y, float * z);  // rasteriza um tringulo j na tela
+
+public:
+    OcclusionBuffer(uint width = 256, uint height = 128);
+
+    void Begin(const float * viewProj);                     // limpa o buffer para uma vista
+    void Rasterize(const PickMesh & mesh, const float * world);  // desenha um oclusor
+    void Finish();                                          // resume os pixels nos blocos
+    bool Occluded(const Bounds & bounds);                   // caixa no mundo escondida?
+    void End();                                             // encerra a medida de tempo da vista
+
+    OcclusionStats Stats() const;           // contagens e tempo entre Begin e End
+    uint Width() const;                     // largura do buffer
+    uint Height() const;                    // altura do buffer
+    const float * Depth() const;            // pixels para depurao
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline OcclusionStats OcclusionBuffer::Stats() const
+{ return stats; }
+
+inline uint OcclusionBuffer::Width() const
+{ return width; }
+
+inline uint OcclusionBuffer::Height() const
+{ return height; }
+
+inline const float * OcclusionBuffer::Depth() const
+{ return depth.data(); }
+
+// -------------------------------------------------------------------------------
+
+#endif
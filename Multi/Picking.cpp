@@ -0,0 +1,248 @@
+/**********************************************************************************
+// Picking (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Seleo de objetos por raio. Os tringulos de uma malha ficam na
+//              CPU em blocos de 8, ordenados pela curva de Morton dos centros,
+//              com as arestas j calculadas para o teste de Mller-Trumbore
+//              vetorizado (AVX, ou SSE em duas metades). Uma BVH sobre os
+//              blocos descarta os que o raio no atravessa.
+//
+**********************************************************************************/
+
+#include "Picking.h"
+#include "Culling.h"
+#include <algorithm>
+#include <cfloat>
+#include <immintrin.h>
+
+// -------------------------------------------------------------------------------
+
+// espalha os 10 bits menos significativos de v a cada 3 bits
+static uint Spread(uint v)
+{
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// -------------------------------------------------------------------------------
+
+PickMesh::PickMesh(const void * positions, uint stride, const uint * indices, uint indexCount)
+{
+    const byte * src = (const byte *) positions;
+    auto vertex = [&](uint i) { return (const float *) (src + ullong(i) * stride); };
+
+    count = indexCount / 3;
+
+    // caixa dos centros para quantizar as posies em 10 bits por eixo
+    vector<float> centers(size_t(count) * 3);
+    float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (uint t = 0; t < count; ++t)
+    {
+        const float * a = vertex(indices[t * 3]);
+        const float * b = vertex(indices[t * 3 + 1]);
+        const float * c = vertex(indices[t * 3 + 2]);
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            float m = (a[k] + b[k] + c[k]) / 3.0f;
+            centers[size_t(t) * 3 + k] = m;
+            lo[k] = std::min(lo[k], m);
+            hi[k] = std::max(hi[k], m);
+        }
+    }
+
+    // ordem de Morton: tringulos vizinhos no espao ficam no mesmo bloco
+    vector<ullong> keys(count);
+
+    for (uint t = 0; t < count; ++t)
+    {
+        uint code = 0;
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            float extent = hi[k] - lo[k];
+            float q = extent > 0 ? (centers[size_t(t) * 3 + k] - lo[k]) / extent : 0;
+            code |= Spread(std::min(1023u, uint(q * 1023.0f))) << k;
+        }
+
+        keys[t] = ullong(code) << 32 | t;
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    // blocos de Width tringulos; canais vazios tm arestas nulas e nunca acertam
+    uint blockCount = (count + Width - 1) / Width;
+    blocks.assign(blockCount, Block {});
+    triangles.assign(size_t(blockCount) * Width, ~0u);
+
+    for (uint b = 0; b < blockCount; ++b)
+    {
+        Block & block = blocks[b];
+        Bounds box;
+        float bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        for (uint l = 0; l < Width && b * Width + l < count; ++l)
+        {
+            uint t = uint(keys[b * Width + l]);
+            triangles[b * Width + l] = t;
+
+            const float * v[3] = { vertex(indices[t * 3]), vertex(indices[t * 3 + 1]), vertex(indices[t * 3 + 2]) };
+
+            for (uint k = 0; k < 3; ++k)
+            {
+                block.v0[k][l] = v[0][k];
+                block.e1[k][l] = v[1][k] - v[0][k];
+                block.e2[k][l] = v[2][k] - v[0][k];
+
+                for (uint i = 0; i < 3; ++i)
+                {
+                    bmin[k] = std::min(bmin[k], v[i][k]);
+                    bmax[k] = std::max(bmax[k], v[i][k]);
+                }
+            }
+        }
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            box.center[k] = (bmin[k] + bmax[k]) * 0.5f;
+            box.extents[k] = (bmax[k] - bmin[k]) * 0.5f;
+        }
+
+        bvh.Add(box);
+    }
+
+    bvh.Build();
+}
+
+// -------------------------------------------------------------------------------
+
+uint PickMesh::IntersectBlock(const Block & block, const Ray & ray, float maxT, float & t) const
+{
+    alignas(32) float dist[Width];
+    int mask = 0;
+
+#ifdef __AVX__
+    const uint Lanes = 8;
+#else
+    const uint Lanes = 4;
+#endif
+
+    // Mller-Trumbore em Lanes tringulos por vez, sem descartar faces de trs
+    for (uint base = 0; base < Width; base += Lanes)
+    {
+#ifdef __AVX__
+        typedef __m256 vec;
+        auto load = [](const float * p) { return _mm256_loadu_ps(p); };
+        auto set = [](float f) { return _mm256_set1_ps(f); };
+        auto add = [](vec a, vec b) { return _mm256_add_ps(a, b); };
+        auto sub = [](vec a, vec b) { return _mm256_sub_ps(a, b); };
+        auto mul = [](vec a, vec b) { return _mm256_mul_ps(a, b); };
+        auto div = [](vec a, vec b) { return _mm256_div_ps(a, b); };
+        auto band = [](vec a, vec b) { return _mm256_and_ps(a, b); };
+        auto ge = [](vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); };
+        auto gt = [](vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); };
+        auto lt = [](vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); };
+        auto bits = [](vec a) { return _mm256_movemask_ps(a); };
+        auto store = [](float * p, vec a) { _mm256_storeu_ps(p, a); };
+#else
+        typedef __m128 vec;
+        auto load = [](const float * p) { return _mm_loadu_ps(p); };
+        auto set = [](float f) { return _mm_set1_ps(f); };
+        auto add = [](vec a, vec b) { return _mm_add_ps(a, b); };
+        auto sub = [](vec a, vec b) { return _mm_sub_ps(a, b); };
+        auto mul = [](vec a, vec b) { return _mm_mul_ps(a, b); };
+        auto div = [](vec a, vec b) { return _mm_div_ps(a, b); };
+        auto band = [](vec a, vec b) { return _mm_and_ps(a, b); };
+        auto ge = [](vec a, vec b) { return _mm_cmpge_ps(a, b); };
+        auto gt = [](vec a, vec b) { return _mm_cmpgt_ps(a, b); };
+        auto lt = [](vec a, vec b) { return _mm_cmplt_ps(a, b); };
+        auto bits = [](vec a) { return _mm_movemask_ps(a); };
+        auto store = [](float * p, vec a) { _mm_storeu_ps(p, a); };
+#endif
+        vec dx = set(ray.direction[0]), dy = set(ray.direction[1]), dz = set(ray.direction[2]);
+        vec e1x = load(block.e1[0] + base), e1y = load(block.e1[1] + base), e1z = load(block.e1[2] + base);
+        vec e2x = load(block.e2[0] + base), e2y = load(block.e2[1] + base), e2z = load(block.e2[2] + base);
+
+        // p = d x e2, det = e1 . p
+        vec px = sub(mul(dy, e2z), mul(dz, e2y));
+        vec py = sub(mul(dz, e2x), mul(dx, e2z));
+        vec pz = sub(mul(dx, e2y), mul(dy, e2x));
+        vec det = add(add(mul(e1x, px), mul(e1y, py)), mul(e1z, pz));
+
+        // s = o - v0, u = (s . p) / det
+        vec sx = sub(set(ray.origin[0]), load(block.v0[0] + base));
+        vec sy = sub(set(ray.origin[1]), load(block.v0[1] + base));
+        vec sz = sub(set(ray.origin[2]), load(block.v0[2] + base));
+        vec inv = div(set(1.0f), det);
+        vec u = mul(add(add(mul(sx, px), mul(sy, py)), mul(sz, pz)), inv);
+
+        // q = s x e1, v = (d . q) / det, t = (e2 . q) / det
+        vec qx = sub(mul(sy, e1z), mul(sz, e1y));
+        vec qy = sub(mul(sz, e1x), mul(sx, e1z));
+        vec qz = sub(mul(sx, e1y), mul(sy, e1x));
+        vec v = mul(add(add(mul(dx, qx), mul(dy, qy)), mul(dz, qz)), inv);
+        vec d = mul(add(add(mul(e2x, qx), mul(e2y, qy)), mul(e2z, qz)), inv);
+
+        // det nulo (canais vazios e raios paralelos) gera inf ou NaN e  rejeitado
+        vec zero = set(0.0f);
+        vec hit = band(gt(mul(det, det), set(1e-20f)), ge(u, zero));
+        hit = band(hit, ge(v, zero));
+        hit = band(hit, ge(set(1.0f), add(u, v)));
+        hit = band(hit, ge(d, zero));
+        hit = band(hit, lt(d, set(maxT)));
+
+        mask |= bits(hit) << base;
+        store(dist + base, d);
+    }
+
+    // acerto mais prximo entre os canais
+    uint best = Width;
+
+    for (uint l = 0; l < Width; ++l)
+    {
+        if ((mask & (1 << l)) && (best == Width || dist[l] < dist[best]))
+            best = l;
+    }
+
+    if (best != Width)
+        t = dist[best];
+
+    return best;
+}
+
+// -------------------------------------------------------------------------------
+
+bool PickMesh::Intersect(const Ray & ray, float & t, uint & triangle, float maxT) const
+{
+    bool found = false;
+
+    // a BVH entrega os blocos em ordem aproximada de distncia
+    bvh.Raycast(ray.origin, ray.direction, maxT,
+        [&](uint b, float closest)
+        {
+            float d;
+            uint lane = IntersectBlock(blocks[b], ray, closest, d);
+
+            if (lane == Width)
+                return closest;
+
+            t = d;
+            triangle = triangles[b * Width + lane];
+            found = true;
+            return d;
+        });
+
+    return found;
+}
+
+// -------------------------------------------------------------------------------
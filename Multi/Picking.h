@@ -0,0 +1,78 @@
+/**********************************************************************************
+// Picking (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Seleo de objetos por raio. Os tringulos de uma malha ficam na
+//              CPU em blocos de 8, ordenados pela curva de Morton dos centros,
+//              com as arestas j calculadas para o teste de Mller-Trumbore
+//              vetorizado (AVX, ou SSE em duas metades). Uma BVH sobre os
+//              blocos descarta os que o raio no atravessa.
+//
+**********************************************************************************/
+
+#ifndef DXUT_PICKING_H_
+#define DXUT_PICKING_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Bvh.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct Ray
+{
+    float origin[3];                        // ponto de partida
+    float direction[3];                     // direo (no precisa ser unitria)
+};
+
+// -------------------------------------------------------------------------------
+
+class PickMesh
+{
+public:
+    static const uint Width = 8;            // tringulos testados juntos
+
+    struct Block
+    {
+        float v0[3][Width];                 // primeiro vrtice de cada tringulo
+        float e1[3][Width];                 // aresta v1 - v0 (nula nos canais vazios)
+        float e2[3][Width];                 // aresta v2 - v0 (nula nos canais vazios)
+    };
+
+private:
+    vector<Block> blocks;                   // tringulos agrupados por proximidade
+    vector<uint> triangles;                 // tringulo original de cada canal dos blocos
+    Bvh bvh;                                // hierarquia sobre as caixas dos blocos
+    uint count;                             // nmero de tringulos
+
+    // tringulo mais prximo do bloco antes de maxT (Width se no houver)
+    uint IntersectBlock(const Block & block, const Ray & ray, float maxT, float & t) const;
+
+public:
+    PickMesh(const void * positions, uint stride, const uint * indices, uint indexCount);
+
+    // interseo mais prxima com t em [0, maxT): ponto = origem + t * direo
+    bool Intersect(const Ray & ray, float & t, uint & triangle, float maxT = 3.4e38f) const;
+
+    uint Triangles() const;                 // nmero de tringulos
+    const vector<Block> & Blocks() const;   // tringulos em blocos para outros testes vetorizados
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint PickMesh::Triangles() const
+{ return count; }
+
+inline const vector<PickMesh::Block> & PickMesh::Blocks() const
+{ return blocks; }
+
+// -------------------------------------------------------------------------------
+
+#endif
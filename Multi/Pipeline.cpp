@@ -0,0 +1,274 @@
+/**********************************************************************************
+// Pipeline (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Cache de assinaturas raiz e de pipelines (PSOs). Cada pipeline 
+//              identificado por um hash de sua descrio completa (shaders,
+//              preenchimento, recorte, topologia e profundidade) e s  criado
+//              uma vez. Os pipelines compilados so guardados em uma
+//              ID3D12PipelineLibrary gravada em disco e reaproveitada na
+//              prxima execuo.
+//
+**********************************************************************************/
+
+#include "Pipeline.h"
+#include "Error.h"
+#include "Hash.h"
+#include <fstream>
+
+// -------------------------------------------------------------------------------
+
+// continua o hash com os bytes de um valor
+template<class T>
+static ullong HashValue(const T & value, ullong hash)
+{
+    return Fnv1a(&value, sizeof(T), hash);
+}
+
+// -------------------------------------------------------------------------------
+
+PipelineCache::PipelineCache(ID3D12Device9 * dev, const string & file)
+    : device(dev), library(nullptr), fileName(file), modified(false)
+{
+    CreateLibrary();
+}
+
+// -------------------------------------------------------------------------------
+
+PipelineCache::~PipelineCache()
+{
+    Save();
+
+    for (auto & p : pipelines)
+        p.second->Release();
+
+    for (auto & r : rootSignatures)
+        r.second->Release();
+
+    if (library)
+        library->Release();
+}
+
+// -------------------------------------------------------------------------------
+
+void PipelineCache::CreateLibrary()
+{
+    // contedo gravado na execuo anterior
+    std::ifstream fin(fileName, std::ios::binary | std::ios::ate);
+    if (fin)
+    {
+        libraryData.resize(uint(fin.tellg()));
+        fin.seekg(0);
+        fin.read((char *) libraryData.data(), libraryData.size());
+    }
+
+    // a biblioteca referencia os dados lidos enquanto existir
+    if (!libraryData.empty() &&
+        SUCCEEDED(device->CreatePipelineLibrary(libraryData.data(), libraryData.size(), IID_PPV_ARGS(&library))))
+        return;
+
+    // arquivo ausente, corrompido ou de outro driver: comea vazia
+    libraryData.clear();
+    if (FAILED(device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library))))
+        library = nullptr;
+}
+
+// -------------------------------------------------------------------------------
+
+void PipelineCache::Save()
+{
+    if (!library || !modified)
+        return;
+
+    vector<byte> data(uint(library->GetSerializedSize()));
+    if (FAILED(library->Serialize(data.data(), data.size())))
+        return;
+
+    std::ofstream fout(fileName, std::ios::binary | std::ios::trunc);
+    fout.write((const char *) data.data(), data.size());
+    modified = false;
+}
+
+// -------------------------------------------------------------------------------
+
+ID3D12RootSignature * PipelineCache::RootSignature(const D3D12_ROOT_SIGNATURE_DESC & desc)
+{
+    // a forma serializada identifica a assinatura
+    ID3DBlob* serializedRootSig = nullptr;
+    ID3DBlob* error = nullptr;
+
+    ThrowIfFailed(D3D12SerializeRootSignature(
+        &desc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        &serializedRootSig,
+        &error));
+
+    if (error != nullptr)
+    {
+        OutputDebugString((char*)error->GetBufferPointer());
+        error->Release();
+    }
+
+    ullong hash = Fnv1a(serializedRootSig->GetBufferPointer(), serializedRootSig->GetBufferSize());
+
+    ID3D12RootSignature * rootSignature = nullptr;
+    auto it = rootSignatures.find(hash);
+
+    if (it != rootSignatures.end())
+    {
+        rootSignature = it->second;
+    }
+    else
+    {
+        ThrowIfFailed(device->CreateRootSignature(
+            0,
+            serializedRootSig->GetBufferPointer(),
+            serializedRootSig->GetBufferSize(),
+            IID_PPV_ARGS(&rootSignature)));
+
+        rootSignatures[hash] = rootSignature;
+        rootHashes[rootSignature] = hash;
+        ++stats.rootSignatures;
+    }
+
+    serializedRootSig->Release();
+    return rootSignature;
+}
+
+// -------------------------------------------------------------------------------
+
+ID3D12PipelineState * PipelineCache::Pipeline(const PipelineDesc & desc, uint samples, uint quality)
+{
+    // bytecode compartilhado, lido do disco uma nica vez
+    const ShaderCode & vs = shaders.Load(desc.vertexShader);
+    const ShaderCode & ps = shaders.Load(desc.pixelShader);
+
+    // a assinatura raiz entra no hash pelo hash de sua descrio: uma
+    // assinatura que no veio de RootSignature no tem como ser identificada
+    auto root = rootHashes.find(desc.rootSignature);
+    if (root == rootHashes.end())
+        ThrowIfFailed(E_INVALIDARG);
+
+    // --------------------
+    // ------- Hash -------
+    // --------------------
+
+    ullong hash = HashValue(vs.hash, Fnv1aBasis);
+    hash = HashValue(ps.hash, hash);
+    hash = HashValue(desc.fill, hash);
+    hash = HashValue(desc.cull, hash);
+    hash = HashValue(desc.topology, hash);
+    hash = HashValue(desc.depthEnable, hash);
+    hash = HashValue(desc.depthFunc, hash);
+    hash = HashValue(root->second, hash);
+    hash = HashValue(samples, hash);
+    hash = HashValue(quality, hash);
+
+    for (uint i = 0; i < desc.inputCount; ++i)
+    {
+        const D3D12_INPUT_ELEMENT_DESC & e = desc.inputLayout[i];
+        hash = Fnv1a(e.SemanticName, strlen(e.SemanticName), hash);
+        hash = HashValue(e.SemanticIndex, hash);
+        hash = HashValue(e.Format, hash);
+        hash = HashValue(e.InputSlot, hash);
+        hash = HashValue(e.AlignedByteOffset, hash);
+        hash = HashValue(e.InputSlotClass, hash);
+    }
+
+    auto it = pipelines.find(hash);
+    if (it != pipelines.end())
+    {
+        ++stats.hits;
+        return it->second;
+    }
+
+    // ---------------------
+    // --- Descrio PSO ---
+    // ---------------------
+
+    D3D12_RASTERIZER_DESC rasterizer = {};
+    rasterizer.FillMode = desc.fill;
+    rasterizer.CullMode = desc.cull;
+    rasterizer.FrontCounterClockwise = FALSE;
+    rasterizer.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
+    rasterizer.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
+    rasterizer.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
+    rasterizer.DepthClipEnable = TRUE;
+    rasterizer.MultisampleEnable = FALSE;
+    rasterizer.AntialiasedLineEnable = FALSE;
+    rasterizer.ForcedSampleCount = 0;
+    rasterizer.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+
+    D3D12_BLEND_DESC blender = {};
+    blender.AlphaToCoverageEnable = FALSE;
+    blender.IndependentBlendEnable = FALSE;
+    const D3D12_RENDER_TARGET_BLEND_DESC defaultRenderTargetBlendDesc =
+    {
+        FALSE,FALSE,
+        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
+        D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
+        D3D12_LOGIC_OP_NOOP,
+        D3D12_COLOR_WRITE_ENABLE_ALL,
+    };
+    for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
+        blender.RenderTarget[i] = defaultRenderTargetBlendDesc;
+
+    D3D12_DEPTH_STENCIL_DESC depthStencil = {};
+    depthStencil.DepthEnable = desc.depthEnable;
+    depthStencil.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+    depthStencil.DepthFunc = desc.depthFunc;
+    depthStencil.StencilEnable = FALSE;
+    depthStencil.StencilReadMask = D3D12_DEFAULT_STENCIL_READ_MASK;
+    depthStencil.StencilWriteMask = D3D12_DEFAULT_STENCIL_WRITE_MASK;
+    const D3D12_DEPTH_STENCILOP_DESC defaultStencilOp =
+    { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
+    depthStencil.FrontFace = defaultStencilOp;
+    depthStencil.BackFace = defaultStencilOp;
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pso = {};
+    pso.pRootSignature = desc.rootSignature;
+    pso.VS = { vs.data, SIZE_T(vs.size) };
+    pso.PS = { ps.data, SIZE_T(ps.size) };
+    pso.BlendState = blender;
+    pso.SampleMask = UINT_MAX;
+    pso.RasterizerState = rasterizer;
+    pso.DepthStencilState = depthStencil;
+    pso.InputLayout = { desc.inputLayout, desc.inputCount };
+    pso.PrimitiveTopologyType = desc.topology;
+    pso.NumRenderTargets = 1;
+    pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+    pso.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    pso.SampleDesc.Count = samples;
+    pso.SampleDesc.Quality = quality;
+
+    // ---------------------
+    // --- Criao PSO -----
+    // ---------------------
+
+    wchar_t name[32];
+    swprintf_s(name, L"PSO_%016llx", hash);
+
+    ID3D12PipelineState * pipelineState = nullptr;
+
+    // pipeline compilado em uma execuo anterior
+    if (library && SUCCEEDED(library->LoadGraphicsPipeline(name, &pso, IID_PPV_ARGS(&pipelineState))))
+    {
+        ++stats.loads;
+    }
+    else
+    {
+        ThrowIfFailed(device->CreateGraphicsPipelineState(&pso, IID_PPV_ARGS(&pipelineState)));
+        ++stats.misses;
+
+        if (library && SUCCEEDED(library->StorePipeline(name, pipelineState)))
+            modified = true;
+    }
+
+    pipelines[hash] = pipelineState;
+    return pipelineState;
+}
+
+// -------------------------------------------------------------------------------
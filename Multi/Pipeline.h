@@ -0,0 +1,99 @@
+/**********************************************************************************
+// Pipeline (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Cache de assinaturas raiz e de pipelines (PSOs). Cada pipeline 
+//              identificado por um hash de sua descrio completa (shaders,
+//              preenchimento, recorte, topologia e profundidade) e s  criado
+//              uma vez. Os pipelines compilados so guardados em uma
+//              ID3D12PipelineLibrary gravada em disco e reaproveitada na
+//              prxima execuo.
+//
+**********************************************************************************/
+
+#ifndef DXUT_PIPELINE_H_
+#define DXUT_PIPELINE_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Graphics.h"
+#include "Shaders.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using std::unordered_map;
+using std::vector;
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+struct PipelineDesc
+{
+    const wchar_t * vertexShader = L"Shaders/Vertex.cso";                   // arquivo do vertex shader
+    const wchar_t * pixelShader = L"Shaders/Pixel.cso";                     // arquivo do pixel shader
+    D3D12_FILL_MODE fill = D3D12_FILL_MODE_WIREFRAME;                       // modo de preenchimento
+    D3D12_CULL_MODE cull = D3D12_CULL_MODE_BACK;                            // modo de recorte
+    D3D12_PRIMITIVE_TOPOLOGY_TYPE topology = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    bool depthEnable = true;                                                // teste de profundidade
+    D3D12_COMPARISON_FUNC depthFunc = D3D12_COMPARISON_FUNC_LESS;           // comparao de profundidade
+    const D3D12_INPUT_ELEMENT_DESC * inputLayout = nullptr;                 // layout dos vrtices
+    uint inputCount = 0;                                                    // elementos do layout
+    ID3D12RootSignature * rootSignature = nullptr;                          // assinatura raiz (do cache)
+};
+
+// -------------------------------------------------------------------------------
+
+struct PipelineStats
+{
+    uint hits = 0;                          // pedidos atendidos pelo cache em memria
+    uint loads = 0;                         // pipelines carregados da biblioteca em disco
+    uint misses = 0;                        // pipelines compilados pelo driver
+    uint rootSignatures = 0;                // assinaturas raiz criadas
+};
+
+// -------------------------------------------------------------------------------
+
+class PipelineCache
+{
+private:
+    ID3D12Device9 * device;                                         // dispositivo grfico
+    ID3D12PipelineLibrary * library;                                // pipelines persistentes
+    vector<byte> libraryData;                                       // contedo lido do disco
+    string fileName;                                                // arquivo da biblioteca
+    bool modified;                                                  // biblioteca com novos pipelines
+    ShaderLibrary shaders;                                          // bytecode dos shaders
+    unordered_map<ullong, ID3D12PipelineState*> pipelines;          // pipelines por hash
+    unordered_map<ullong, ID3D12RootSignature*> rootSignatures;     // assinaturas por hash
+    unordered_map<ID3D12RootSignature*, ullong> rootHashes;         // hash de cada assinatura
+    PipelineStats stats;                                            // estatsticas do cache
+
+    void CreateLibrary();                                           // abre ou cria a biblioteca
+
+public:
+    PipelineCache(ID3D12Device9 * dev, const string & file);
+    ~PipelineCache();
+
+    ID3D12RootSignature * RootSignature(const D3D12_ROOT_SIGNATURE_DESC & desc);
+    ID3D12PipelineState * Pipeline(const PipelineDesc & desc, uint samples, uint quality);
+    void Save();                                                    // grava a biblioteca em disco
+
+    ShaderLibrary & Shaders();                                      // biblioteca de shaders
+    PipelineStats Stats() const;                                    // estatsticas do cache
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline ShaderLibrary & PipelineCache::Shaders()
+{ return shaders; }
+
+inline PipelineStats PipelineCache::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
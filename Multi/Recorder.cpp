@@ -0,0 +1,81 @@
+/**********************************************************************************
+// Recorder (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Gravao paralela de fluxos de comandos. Cada segmento (por
+//              exemplo, uma vista do modo quadview)  gravado em seu prprio
+//              CommandStream por uma tarefa do sistema de tarefas; a thread
+//              que pediu a gravao tambm grava enquanto espera. Terminada
+//              a gravao, os segmentos so submetidos na ordem dos ndices,
+//              independentemente de qual thread os gravou.
+//
+**********************************************************************************/
+
+#include "Recorder.h"
+#include <chrono>
+
+// -------------------------------------------------------------------------------
+
+ParallelRecorder::ParallelRecorder(JobSystem * jobSystem)
+    : jobs(jobSystem)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+void ParallelRecorder::Record(uint count, const Task & record)
+{
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    if (segments.size() < count)
+    {
+        segments.resize(count);
+        times.resize(count);
+        owners.resize(count);
+    }
+
+    // um segmento por tarefa: a thread que chamou grava o primeiro
+    // e ajuda com os demais at todos terminarem
+    jobs->ParallelFor(count, 1, [&](uint begin, uint end) {
+        for (uint i = begin; i < end; ++i)
+        {
+            auto segmentStart = Clock::now();
+            segments[i].Clear();
+            record(i, segments[i]);
+            times[i] = std::chrono::duration<double, std::milli>(Clock::now() - segmentStart).count();
+            owners[i] = jobs->ThreadIndex();
+        }
+    });
+
+    // estatsticas da gravao
+    stats = RecordStats();
+    stats.segments = count;
+
+    uint used = 0;
+    for (uint i = 0; i < count; ++i)
+    {
+        stats.commands += segments[i].Size();
+        stats.longest = times[i] > stats.longest ? times[i] : stats.longest;
+        used |= 1u << (owners[i] < 31 ? owners[i] : 31);
+    }
+
+    for (; used; used &= used - 1)
+        ++stats.threads;
+
+    stats.time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// -------------------------------------------------------------------------------
+
+void ParallelRecorder::Submit(CommandBackend & backend) const
+{
+    // a ordem de submisso  a ordem dos segmentos, no a de concluso
+    for (uint i = 0; i < stats.segments; ++i)
+        backend.Execute(segments[i]);
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+/**********************************************************************************
+// Recorder (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Gravao paralela de fluxos de comandos. Cada segmento (por
+//              exemplo, uma vista do modo quadview)  gravado em seu prprio
+//              CommandStream por uma tarefa do sistema de tarefas; a thread
+//              que pediu a gravao tambm grava enquanto espera. Terminada
+//              a gravao, os segmentos so submetidos na ordem dos ndices,
+//              independentemente de qual thread os gravou.
+//
+**********************************************************************************/
+
+#ifndef DXUT_RECORDER_H_
+#define DXUT_RECORDER_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "CommandStream.h"
+#include "Jobs.h"
+#include <functional>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct RecordStats
+{
+    uint   segments = 0;                    // segmentos gravados no quadro
+    uint   threads = 0;                     // threads que gravaram segmentos
+    uint   commands = 0;                    // comandos em todos os segmentos
+    double time = 0;                        // milissegundos da gravao completa
+    double longest = 0;                     // milissegundos do segmento mais demorado
+};
+
+// -------------------------------------------------------------------------------
+
+class ParallelRecorder
+{
+public:
+    using Task = std::function<void(uint segment, CommandStream & stream)>;
+
+private:
+    JobSystem * jobs;                       // threads que gravam os segmentos
+    vector<CommandStream> segments;         // fluxo de cada segmento
+    vector<double> times;                   // milissegundos de cada segmento
+    vector<uint> owners;                    // thread que gravou cada segmento
+    RecordStats stats;                      // estatsticas da ltima gravao
+
+public:
+    ParallelRecorder(JobSystem * jobSystem);
+
+    void Record(uint count, const Task & record);       // grava count segmentos em paralelo
+    void Submit(CommandBackend & backend) const;        // executa os segmentos em ordem
+
+    const CommandStream & Segment(uint index) const;    // fluxo de um segmento
+    uint Segments() const;                              // segmentos da ltima gravao
+    uint Threads() const;                               // threads que podem gravar
+    RecordStats Stats() const;                          // estatsticas da ltima gravao
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline const CommandStream & ParallelRecorder::Segment(uint index) const
+{ return segments[index]; }
+
+inline uint ParallelRecorder::Segments() const
+{ return stats.segments; }
+
+inline uint ParallelRecorder::Threads() const
+{ return jobs->Threads(); }
+
+inline RecordStats ParallelRecorder::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,113 @@
+/**********************************************************************************
+// RenderQueue (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Fila de desenhos ordenada por chaves de 64 bits. Cada desenho
+//              guarda em sua chave a vista, o pipeline, a malha e a
+//              profundidade, nessa ordem de importncia, e a fila  ordenada a
+//              cada quadro por radix sort de 8 bits por passada (passadas em
+//              que todas as chaves tm o mesmo byte so puladas). Na submisso,
+//              a fila lembra o ltimo valor de cada estado do pipeline e s
+//              autoriza o comando quando o valor muda.
+//
+**********************************************************************************/
+
+#include "RenderQueue.h"
+#include <utility>
+
+// -------------------------------------------------------------------------------
+
+RenderQueue::RenderQueue()
+{
+    Clear();
+}
+
+// -------------------------------------------------------------------------------
+
+ullong RenderQueue::Key(uint view, uint pipeline, uint mesh, float depth)
+{
+    // profundidade fora do intervalo fica nos extremos
+    if (!(depth > 0.0f)) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+
+    const ullong maxDepth = (1ull << DepthBits) - 1;
+    ullong z = ullong(depth * float(maxDepth));
+
+    return (ullong(view & ((1u << ViewBits) - 1)) << (PipelineBits + MeshBits + DepthBits))
+         | (ullong(pipeline & ((1u << PipelineBits) - 1)) << (MeshBits + DepthBits))
+         | (ullong(mesh & ((1u << MeshBits) - 1)) << DepthBits)
+         | z;
+}
+
+// -------------------------------------------------------------------------------
+
+void RenderQueue::Clear()
+{
+    items.clear();
+    stats = RenderStats();
+
+    // uma nova lista de comandos no herda estados
+    for (uint i = 0; i < STATE_COUNT; ++i)
+    {
+        values[i] = 0;
+        known[i] = false;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void RenderQueue::Sort()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    uint count = uint(items.size());
+    stats.draws = count;
+    stats.passes = 0;
+
+    // histogramas dos 8 bytes da chave em uma nica leitura
+    uint counts[8][256] = {};
+
+    for (const DrawItem & item : items)
+        for (uint b = 0; b < 8; ++b)
+            ++counts[b][(item.key >> (b * 8)) & 0xFF];
+
+    scratch.resize(count);
+    DrawItem * source = items.data();
+    DrawItem * target = scratch.data();
+
+    // radix sort do byte menos significativo para o mais significativo:
+    // cada passada  estvel e preserva a ordem dos bytes anteriores
+    for (uint b = 0; b < 8 && count > 1; ++b)
+    {
+        uint * histogram = counts[b];
+
+        // todas as chaves tm o mesmo byte: a passada no muda nada
+        if (histogram[(source[0].key >> (b * 8)) & 0xFF] == count)
+            continue;
+
+        uint offset = 0;
+        for (uint d = 0; d < 256; ++d)
+        {
+            uint n = histogram[d];
+            histogram[d] = offset;
+            offset += n;
+        }
+
+        for (uint i = 0; i < count; ++i)
+            target[histogram[(source[i].key >> (b * 8)) & 0xFF]++] = source[i];
+
+        std::swap(source, target);
+        ++stats.passes;
+    }
+
+    // nmero mpar de passadas deixa o resultado no vetor auxiliar
+    if (source != items.data())
+        items.swap(scratch);
+
+    stats.sortTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+/**********************************************************************************
+// RenderQueue (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Fila de desenhos ordenada por chaves de 64 bits. Cada desenho
+//              guarda em sua chave a vista, o pipeline, a malha e a
+//              profundidade, nessa ordem de importncia, e a fila  ordenada a
+//              cada quadro por radix sort de 8 bits por passada (passadas em
+//              que todas as chaves tm o mesmo byte so puladas). Na submisso,
+//              a fila lembra o ltimo valor de cada estado do pipeline e s
+//              autoriza o comando quando o valor muda.
+//
+**********************************************************************************/
+
+#ifndef DXUT_RENDERQUEUE_H_
+#define DXUT_RENDERQUEUE_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <chrono>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// estados do pipeline acompanhados na submisso
+enum RenderState
+{
+    STATE_PIPELINE,
+    STATE_ROOTSIGNATURE,
+    STATE_HEAPS,
+    STATE_TOPOLOGY,
+    STATE_VIEWPORT,
+    STATE_VIEWCONSTANTS,
+    STATE_VERTEXBUFFER,
+    STATE_INDEXBUFFER,
+    STATE_OBJECTCONSTANTS,
+    STATE_COUNT
+};
+
+// -------------------------------------------------------------------------------
+
+struct RenderStats
+{
+    uint   draws = 0;                       // desenhos na fila
+    uint   changes = 0;                     // comandos de estado emitidos
+    uint   avoided = 0;                     // comandos de estado repetidos evitados
+    uint   passes = 0;                      // passadas do radix sort
+    double sortTime = 0;                    // milissegundos gastos na ordenao
+};
+
+// -------------------------------------------------------------------------------
+
+struct DrawItem
+{
+    ullong key;                             // chave de ordenao
+    uint   index;                           // objeto a desenhar
+};
+
+// -------------------------------------------------------------------------------
+
+class RenderQueue
+{
+public:
+    static const uint ViewBits = 4;         // bits mais significativos: vista
+    static const uint PipelineBits = 12;    // pipeline dentro da vista
+    static const uint MeshBits = 24;        // malha dentro do pipeline
+    static const uint DepthBits = 24;       // profundidade dentro da malha
+
+private:
+    vector<DrawItem> items;                 // desenhos do quadro
+    vector<DrawItem> scratch;               // destino das passadas do radix sort
+    ullong values[STATE_COUNT];             // ltimo valor de cada estado
+    bool   known[STATE_COUNT];              // estado j definido na lista?
+    RenderStats stats;                      // contagens e tempo do quadro
+
+public:
+    RenderQueue();
+
+    // chave de um desenho (profundidade normalizada entre 0 e 1)
+    static ullong Key(uint view, uint pipeline, uint mesh, float depth);
+    static uint View(ullong key);           // vista guardada na chave
+    static uint Pipeline(ullong key);       // pipeline guardado na chave
+    static uint Mesh(ullong key);           // malha guardada na chave
+
+    void Clear();                                           // esvazia a fila e esquece os estados
+    void Push(ullong key, uint index);                      // adiciona um desenho
+    void Sort();                                            // ordena os desenhos pelas chaves
+
+    void Set(uint state, ullong value);                     // estado definido fora da fila
+    bool Change(uint state, ullong value);                  // o comando do estado deve ser emitido?
+
+    const vector<DrawItem> & Items() const;                 // desenhos na ordem de submisso
+    RenderStats Stats() const;                              // contagens e tempo do quadro
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint RenderQueue::View(ullong key)
+{ return uint(key >> (PipelineBits + MeshBits + DepthBits)); }
+
+inline uint RenderQueue::Pipeline(ullong key)
+{ return uint(key >> (MeshBits + DepthBits)) & ((1u << PipelineBits) - 1); }
+
+inline uint RenderQueue::Mesh(ullong key)
+{ return uint(key >> DepthBits) & ((1u << MeshBits) - 1); }
+
+inline void RenderQueue::Push(ullong key, uint index)
+{ items.push_back(DrawItem { key, index }); }
+
+inline void RenderQueue::Set(uint state, ullong value)
+{ values[state] = value; known[state] = true; }
+
+// comandos repetidos so evitados: a lista j est nesse estado
+inline bool RenderQueue::Change(uint state, ullong value)
+{
+    if (known[state] && values[state] == value)
+    {
+        ++stats.avoided;
+        return false;
+    }
+
+    Set(state, value);
+    ++stats.changes;
+    return true;
+}
+
+inline const vector<DrawItem> & RenderQueue::Items() const
+{ return items; }
+
+inline RenderStats RenderQueue::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,112 @@
+/**********************************************************************************
+// Ring (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Controle de um buffer circular de upload. Cada trecho alocado 
+//              associado ao valor da cerca (fence) que a GPU sinaliza ao
+//              terminar de us-lo e  reciclado quando a cerca  atingida.
+//
+**********************************************************************************/
+
+#include "Ring.h"
+
+// -------------------------------------------------------------------------------
+
+float RingStats::Occupancy() const
+{
+    if (capacity == 0)
+        return 0.0f;
+
+    return float(used) / float(capacity);
+}
+
+// -------------------------------------------------------------------------------
+
+UploadRing::UploadRing(ullong size)
+{
+    capacity = size;
+    head = 0;
+    tail = 0;
+    openBytes = 0;
+    stats.capacity = size;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong UploadRing::Allocate(ullong size, ullong alignment)
+{
+    if (size == 0 || size > capacity)
+        return Invalid;
+
+    // buffer vazio: recomea do incio
+    if (stats.used == 0)
+        head = tail = 0;
+
+    ullong start = (head + alignment - 1) & ~(alignment - 1);
+    ullong padding = 0;
+
+    if (head >= tail && stats.used < capacity)
+    {
+        // regio livre vai de head at o fim e do incio at tail
+        if (start + size <= capacity)
+        {
+            padding = start - head;
+        }
+        else if (size <= tail)
+        {
+            // descarta o final do buffer e continua do incio
+            padding = capacity - head;
+            start = 0;
+        }
+        else
+        {
+            return Invalid;
+        }
+    }
+    else
+    {
+        // regio livre vai de head at tail
+        if (start + size > tail || stats.used == capacity)
+            return Invalid;
+
+        padding = start - head;
+    }
+
+    head = start + size;
+    openBytes += padding + size;
+    stats.used += padding + size;
+    ++stats.allocations;
+
+    if (stats.used > stats.peak)
+        stats.peak = stats.used;
+
+    return start;
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadRing::Close(ullong fenceValue)
+{
+    if (openBytes == 0)
+        return;
+
+    spans.push_back({ fenceValue, head, openBytes });
+    openBytes = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadRing::Retire(ullong completedFence)
+{
+    while (!spans.empty() && spans.front().fence <= completedFence)
+    {
+        tail = spans.front().end;
+        stats.used -= spans.front().bytes;
+        spans.pop_front();
+    }
+}
+
+// -------------------------------------------------------------------------------
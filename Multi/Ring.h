@@ -0,0 +1,93 @@
+/**********************************************************************************
+// Ring (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Controle de um buffer circular de upload. Cada trecho alocado 
+//              associado ao valor da cerca (fence) que a GPU sinaliza ao
+//              terminar de us-lo e  reciclado quando a cerca  atingida.
+//
+**********************************************************************************/
+
+#ifndef DXUT_RING_H_
+#define DXUT_RING_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <deque>
+using std::deque;
+
+// -------------------------------------------------------------------------------
+
+struct RingStats
+{
+    ullong capacity = 0;                    // tamanho do buffer circular
+    ullong used = 0;                        // bytes ocupados (inclui preenchimento)
+    ullong peak = 0;                        // maior ocupao registrada
+    uint   allocations = 0;                 // total de alocaes atendidas
+    uint   stalls = 0;                      // esperas pela GPU para liberar espao
+    uint   overflows = 0;                   // pedidos que no couberam no buffer
+
+    float Occupancy() const;                // frao ocupada do buffer
+};
+
+// -------------------------------------------------------------------------------
+
+class UploadRing
+{
+public:
+    static const ullong Invalid = ~0ULL;    // falha na alocao
+
+private:
+    struct Span
+    {
+        ullong fence;                       // cerca que libera o trecho
+        ullong end;                         // posio final do trecho no buffer
+        ullong bytes;                       // bytes ocupados pelo trecho
+    };
+
+    ullong capacity;                        // tamanho do buffer
+    ullong head;                            // prxima posio livre
+    ullong tail;                            // incio do trecho mais antigo em uso
+    ullong openBytes;                       // bytes alocados desde o ltimo Close
+    deque<Span> spans;                      // trechos aguardando a GPU
+    RingStats stats;                        // estatsticas de uso
+
+public:
+    UploadRing(ullong size);
+
+    ullong Allocate(ullong size, ullong alignment = 4);     // retorna deslocamento ou Invalid
+    void Close(ullong fenceValue);                          // associa alocaes abertas a uma cerca
+    void Retire(ullong completedFence);                     // recicla trechos j usados pela GPU
+
+    bool Pending() const;                   // existem trechos aguardando uma cerca
+    ullong OldestFence() const;             // cerca do trecho mais antigo
+    void Stall();                           // registra uma espera pela GPU
+    void Overflow();                        // registra pedido atendido fora do buffer
+    RingStats Stats() const;                // estatsticas do buffer
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline bool UploadRing::Pending() const
+{ return !spans.empty(); }
+
+inline ullong UploadRing::OldestFence() const
+{ return spans.empty() ? 0 : spans.front().fence; }
+
+inline void UploadRing::Stall()
+{ ++stats.stalls; }
+
+inline void UploadRing::Overflow()
+{ ++stats.overflows; }
+
+inline RingStats UploadRing::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
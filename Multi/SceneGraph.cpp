@@ -0,0 +1,481 @@
+/**********************************************************************************
+// SceneGraph (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de ns com transformaes locais (translao, rotao
+//              e escala). Os ns ficam em vetores planos na ordem de uma busca
+//              em largura, com os filhos de cada n em posies contguas;
+//              assim os descendentes de um n em cada nvel tambm so
+//              contguos. Alterar, inserir ou trocar o pai de um n s o marca
+//              como sujo: a atualizao recalcula as matrizes de mundo apenas
+//              das subrvores sujas, nvel por nvel (mundo = local x pai).
+//
+**********************************************************************************/
+
+#include "SceneGraph.h"
+#include <algorithm>
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+
+// out = a x b (out no pode ser a nem b)
+static void Multiply(const float * a, const float * b, float * out)
+{
+    for (uint r = 0; r < 4; ++r)
+        for (uint c = 0; c < 4; ++c)
+            out[r * 4 + c] = a[r * 4] * b[c] + a[r * 4 + 1] * b[4 + c] + a[r * 4 + 2] * b[8 + c] + a[r * 4 + 3] * b[12 + c];
+}
+
+// inversa de uma matriz afim (ltima coluna 0, 0, 0, 1)
+static void InverseAffine(const float * m, float * out)
+{
+    float det = m[0] * (m[5] * m[10] - m[6] * m[9])
+              - m[1] * (m[4] * m[10] - m[6] * m[8])
+              + m[2] * (m[4] * m[9] - m[5] * m[8]);
+    float inv = det != 0 ? 1.0f / det : 0.0f;
+
+    out[0] = (m[5] * m[10] - m[6] * m[9]) * inv;
+    out[1] = (m[2] * m[9] - m[1] * m[10]) * inv;
+    out[2] = (m[1] * m[6] - m[2] * m[5]) * inv;
+    out[4] = (m[6] * m[8] - m[4] * m[10]) * inv;
+    out[5] = (m[0] * m[10] - m[2] * m[8]) * inv;
+    out[6] = (m[2] * m[4] - m[0] * m[6]) * inv;
+    out[8] = (m[4] * m[9] - m[5] * m[8]) * inv;
+    out[9] = (m[1] * m[8] - m[0] * m[9]) * inv;
+    out[10] = (m[0] * m[5] - m[1] * m[4]) * inv;
+
+    // translao desfeita no espao j invertido
+    for (uint c = 0; c < 3; ++c)
+        out[12 + c] = -(m[12] * out[c] + m[13] * out[4 + c] + m[14] * out[8 + c]);
+
+    out[3] = out[7] = out[11] = 0.0f;
+    out[15] = 1.0f;
+}
+
+// -------------------------------------------------------------------------------
+
+void Trs::Matrix(float * m) const
+{
+    float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+
+    // linhas da rotao (vetor linha), cada uma multiplicada pela escala do eixo
+    float r[3][3] =
+    {
+        { 1 - 2 * (y * y + z * z), 2 * (x * y + w * z), 2 * (x * z - w * y) },
+        { 2 * (x * y - w * z), 1 - 2 * (x * x + z * z), 2 * (y * z + w * x) },
+        { 2 * (x * z + w * y), 2 * (y * z - w * x), 1 - 2 * (x * x + y * y) }
+    };
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        for (uint j = 0; j < 3; ++j)
+            m[i * 4 + j] = r[i][j] * scale[i];
+
+        m[i * 4 + 3] = 0.0f;
+        m[12 + i] = translation[i];
+    }
+
+    m[15] = 1.0f;
+}
+
+// -------------------------------------------------------------------------------
+
+void Trs::Rotate(const float * axis, float angle)
+{
+    float len = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+    if (len == 0)
+        return;
+
+    float s = sinf(angle * 0.5f) / len;
+    float d[4] = { axis[0] * s, axis[1] * s, axis[2] * s, cosf(angle * 0.5f) };
+    const float * q = rotation;
+
+    // produto q * d: com vetores linha, d  aplicada antes de q
+    float r[4] =
+    {
+        q[3] * d[0] + d[3] * q[0] + q[1] * d[2] - q[2] * d[1],
+        q[3] * d[1] + d[3] * q[1] + q[2] * d[0] - q[0] * d[2],
+        q[3] * d[2] + d[3] * q[2] + q[0] * d[1] - q[1] * d[0],
+        q[3] * d[3] - q[0] * d[0] - q[1] * d[1] - q[2] * d[2]
+    };
+
+    // renormaliza para no acumular erro em giros repetidos
+    float n = 1.0f / sqrtf(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+
+    for (uint k = 0; k < 4; ++k)
+        rotation[k] = r[k] * n;
+}
+
+// -------------------------------------------------------------------------------
+
+Trs Trs::FromMatrix(const float * m)
+{
+    Trs t;
+    float r[3][3];
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        t.translation[i] = m[12 + i];
+        t.scale[i] = sqrtf(m[i * 4] * m[i * 4] + m[i * 4 + 1] * m[i * 4 + 1] + m[i * 4 + 2] * m[i * 4 + 2]);
+
+        for (uint j = 0; j < 3; ++j)
+            r[i][j] = t.scale[i] != 0 ? m[i * 4 + j] / t.scale[i] : (i == j ? 1.0f : 0.0f);
+    }
+
+    // reflexes ficam na escala do primeiro eixo
+    float det = r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1])
+              - r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0])
+              + r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0]);
+
+    if (det < 0)
+    {
+        t.scale[0] = -t.scale[0];
+
+        for (uint j = 0; j < 3; ++j)
+            r[0][j] = -r[0][j];
+    }
+
+    // quatrnio a partir do maior termo da diagonal, para estabilidade
+    float * q = t.rotation;
+    float trace = r[0][0] + r[1][1] + r[2][2];
+
+    if (trace > 0)
+    {
+        float s = sqrtf(trace + 1.0f) * 2.0f;
+        q[3] = 0.25f * s;
+        q[0] = (r[1][2] - r[2][1]) / s;
+        q[1] = (r[2][0] - r[0][2]) / s;
+        q[2] = (r[0][1] - r[1][0]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        float s = sqrtf(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;
+        q[3] = (r[1][2] - r[2][1]) / s;
+        q[0] = 0.25f * s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = (r[2][0] + r[0][2]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+        float s = sqrtf(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;
+        q[3] = (r[2][0] - r[0][2]) / s;
+        q[0] = (r[0][1] + r[1][0]) / s;
+        q[1] = 0.25f * s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+    }
+    else
+    {
+        float s = sqrtf(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;
+        q[3] = (r[0][1] - r[1][0]) / s;
+        q[0] = (r[2][0] + r[0][2]) / s;
+        q[1] = (r[1][2] + r[2][1]) / s;
+        q[2] = 0.25f * s;
+    }
+
+    return t;
+}
+
+// -------------------------------------------------------------------------------
+
+SceneGraph::SceneGraph() : roots(0), stamp(0), rebuild(false)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Attach(uint id, uint parent)
+{
+    parentOf[id] = parent;
+
+    if (parent != None)
+        children[parent].push_back(id);
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Detach(uint id)
+{
+    uint parent = parentOf[id];
+
+    if (parent != None)
+    {
+        vector<uint> & list = children[parent];
+        list.erase(std::find(list.begin(), list.end(), id));
+    }
+
+    parentOf[id] = None;
+}
+
+// -------------------------------------------------------------------------------
+
+uint SceneGraph::Add(const Trs & local, uint parent)
+{
+    uint id;
+
+    if (freeIds.empty())
+    {
+        id = uint(slot.size());
+        slot.push_back(uint(None));
+        parentOf.push_back(uint(None));
+        children.emplace_back();
+    }
+    else
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+
+    // o novo n fica no final at a prxima reordenao
+    slot[id] = uint(ids.size());
+    ids.push_back(id);
+    locals.push_back(local);
+    Attach(id, Valid(parent) ? parent : uint(None));
+
+    ++stats.nodes;
+    rebuild = true;
+    dirty.push_back(id);
+    return id;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Remove(uint id)
+{
+    if (!Valid(id))
+        return;
+
+    // os filhos sobem um nvel sem sair do lugar no mundo
+    vector<uint> orphans = children[id];
+
+    for (uint child : orphans)
+        SetParent(child, parentOf[id]);
+
+    Detach(id);
+    ids[slot[id]] = None;
+    slot[id] = None;
+    freeIds.push_back(id);
+
+    --stats.nodes;
+    rebuild = true;
+}
+
+// -------------------------------------------------------------------------------
+
+bool SceneGraph::SetParent(uint id, uint parent)
+{
+    if (!Valid(id) || (parent != None && !Valid(parent)) || parentOf[id] == parent)
+        return false;
+
+    // um n no pode virar filho de si mesmo ou de um descendente
+    for (uint p = parent; p != None; p = parentOf[p])
+    {
+        if (p == id)
+            return false;
+    }
+
+    // nova transformao local que mantm a matriz de mundo
+    float world[16];
+    Compose(id, world);
+
+    if (parent != None)
+    {
+        float parentWorld[16], inverse[16], local[16];
+        Compose(parent, parentWorld);
+        InverseAffine(parentWorld, inverse);
+        Multiply(world, inverse, local);
+        locals[slot[id]] = Trs::FromMatrix(local);
+    }
+    else
+    {
+        locals[slot[id]] = Trs::FromMatrix(world);
+    }
+
+    Detach(id);
+    Attach(id, parent);
+    rebuild = true;
+    dirty.push_back(id);
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::SetLocal(uint id, const Trs & local)
+{
+    locals[slot[id]] = local;
+    dirty.push_back(id);
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Clear()
+{
+    slot.clear();
+    parentOf.clear();
+    children.clear();
+    freeIds.clear();
+    ids.clear();
+    parents.clear();
+    firstChild.clear();
+    childCount.clear();
+    locals.clear();
+    worlds.clear();
+    stamps.clear();
+    dirty.clear();
+    changed.clear();
+
+    roots = 0;
+    rebuild = false;
+    stats.nodes = 0;
+    stats.updated = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Compose(uint id, float * world) const
+{
+    locals[slot[id]].Matrix(world);
+
+    for (uint p = parentOf[id]; p != None; p = parentOf[p])
+    {
+        float local[16], parent[16];
+        std::copy(world, world + 16, local);
+        locals[slot[p]].Matrix(parent);
+        Multiply(local, parent, world);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Rebuild()
+{
+    // razes primeiro, depois cada nvel na ordem dos pais
+    vector<uint> order;
+    order.reserve(stats.nodes);
+
+    for (uint id = 0; id < slot.size(); ++id)
+    {
+        if (slot[id] != None && parentOf[id] == None)
+            order.push_back(id);
+    }
+
+    roots = uint(order.size());
+    firstChild.resize(stats.nodes);
+    childCount.resize(stats.nodes);
+
+    for (uint head = 0; head < order.size(); ++head)
+    {
+        const vector<uint> & list = children[order[head]];
+        firstChild[head] = uint(order.size());
+        childCount[head] = uint(list.size());
+        order.insert(order.end(), list.begin(), list.end());
+    }
+
+    // transformaes e matrizes de mundo seguem os ns para as novas
+    // posies; ns inseridos depois da ltima ordenao ainda no tm mundo
+    vector<Trs> sorted(order.size());
+    vector<float> placed(order.size() * 16);
+
+    for (uint p = 0; p < order.size(); ++p)
+    {
+        uint old = slot[order[p]];
+        sorted[p] = locals[old];
+
+        if (size_t(old) * 16 < worlds.size())
+            std::copy(&worlds[size_t(old) * 16], &worlds[size_t(old) * 16] + 16, &placed[size_t(p) * 16]);
+    }
+
+    for (uint p = 0; p < order.size(); ++p)
+        slot[order[p]] = p;
+
+    parents.resize(order.size());
+
+    for (uint p = 0; p < order.size(); ++p)
+        parents[p] = parentOf[order[p]] == None ? uint(None) : slot[parentOf[order[p]]];
+
+    locals.swap(sorted);
+    ids.swap(order);
+    worlds.swap(placed);
+    stamps.assign(ids.size(), 0);
+
+    rebuild = false;
+    ++stats.rebuilds;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Propagate(uint first, uint last)
+{
+    // os descendentes de um intervalo de ns formam o intervalo do nvel seguinte
+    while (first < last)
+    {
+        for (uint i = first; i < last; ++i)
+        {
+            float * world = &worlds[size_t(i) * 16];
+
+            if (parents[i] == None)
+            {
+                locals[i].Matrix(world);
+            }
+            else
+            {
+                float local[16];
+                locals[i].Matrix(local);
+                Multiply(local, &worlds[size_t(parents[i]) * 16], world);
+            }
+
+            stamps[i] = stamp;
+            changed.push_back(ids[i]);
+        }
+
+        stats.updated += last - first;
+
+        uint next = firstChild[first];
+        last = firstChild[last - 1] + childCount[last - 1];
+        first = next;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool SceneGraph::Update()
+{
+    changed.clear();
+    stats.updated = 0;
+    ++stamp;
+
+    // mudanas na estrutura reordenam os ns, mas apenas as subrvores
+    // dos ns inseridos ou trocados de pai recebem novas matrizes
+    if (rebuild)
+        Rebuild();
+
+    if (dirty.empty())
+        return false;
+
+    // na ordem em largura os ancestrais vm antes: uma subrvore j
+    // recalculada cobre os ns sujos que esto dentro dela
+    uint count = 0;
+
+    for (uint id : dirty)
+    {
+        if (Valid(id))
+            dirty[count++] = slot[id];
+    }
+
+    dirty.resize(count);
+    std::sort(dirty.begin(), dirty.end());
+
+    for (uint p : dirty)
+    {
+        if (stamps[p] != stamp)
+            Propagate(p, p + 1);
+    }
+
+    dirty.clear();
+    return !changed.empty();
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+/**********************************************************************************
+// SceneGraph (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de ns com transformaes locais (translao, rotao
+//              e escala). Os ns ficam em vetores planos na ordem de uma busca
+//              em largura, com os filhos de cada n em posies contguas;
+//              assim os descendentes de um n em cada nvel tambm so
+//              contguos. Alterar, inserir ou trocar o pai de um n s o marca
+//              como sujo: a atualizao recalcula as matrizes de mundo apenas
+//              das subrvores sujas, nvel por nvel (mundo = local x pai).
+//
+**********************************************************************************/
+
+#ifndef DXUT_SCENEGRAPH_H_
+#define DXUT_SCENEGRAPH_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct Trs
+{
+    float translation[3] = { 0, 0, 0 };     // posio em relao ao pai
+    float rotation[4] = { 0, 0, 0, 1 };     // quatrnio unitrio (x, y, z, w)
+    float scale[3] = { 1, 1, 1 };           // escala em cada eixo
+
+    void Matrix(float * m) const;                       // escala x rotao x translao
+    void Rotate(const float * axis, float angle);       // gira no espao local, antes da rotao atual
+    static Trs FromMatrix(const float * m);             // decompe uma matriz sem cisalhamento
+};
+
+// -------------------------------------------------------------------------------
+
+struct SceneGraphStats
+{
+    uint nodes = 0;                         // ns na hierarquia
+    uint updated = 0;                       // matrizes recalculadas na ltima atualizao
+    uint rebuilds = 0;                      // reordenaes em largura
+};
+
+// -------------------------------------------------------------------------------
+
+class SceneGraph
+{
+public:
+    static const uint None = ~0u;           // n inexistente ou sem pai
+
+private:
+    // estrutura, indexada pelo identificador do n
+    vector<uint> slot;                      // posio na ordem em largura (None se livre)
+    vector<uint> parentOf;                  // identificador do pai
+    vector<vector<uint>> children;          // identificadores dos filhos
+    vector<uint> freeIds;                   // identificadores para reaproveitar
+
+    // dados, indexados pela posio na ordem em largura
+    vector<uint> ids;                       // identificador do n
+    vector<uint> parents;                   // posio do pai
+    vector<uint> firstChild;                // posio onde comeam os filhos
+    vector<uint> childCount;                // nmero de filhos
+    vector<Trs> locals;                     // transformao local
+    vector<float> worlds;                   // matriz de mundo (16 floats por n)
+    vector<uint> stamps;                    // ltima atualizao que calculou o n
+
+    uint roots;                             // razes no incio da ordem
+    uint stamp;                             // contador de atualizaes
+    bool rebuild;                           // estrutura alterada desde a ltima ordenao
+    vector<uint> dirty;                     // ns com transformao local alterada
+    vector<uint> changed;                   // ns com nova matriz de mundo
+    SceneGraphStats stats;                  // estatsticas da hierarquia
+
+    void Rebuild();                                 // reordena os ns em largura
+    void Propagate(uint first, uint last);          // recalcula uma subrvore nvel por nvel
+    void Compose(uint id, float * world) const;     // matriz de mundo subindo pelos ancestrais
+    void Attach(uint id, uint parent);              // liga um n  lista de filhos do pai
+    void Detach(uint id);                           // desliga um n do pai atual
+
+public:
+    SceneGraph();
+
+    uint Add(const Trs & local, uint parent = None);    // insere um n e retorna seu identificador
+    void Remove(uint id);                               // remove; os filhos passam ao av
+    bool SetParent(uint id, uint parent);               // troca o pai mantendo a posio no mundo
+    void SetLocal(uint id, const Trs & local);          // altera a transformao local
+    void Clear();                                       // remove todos os ns
+
+    // recalcula as matrizes sujas; retorna true se alguma mudou
+    bool Update();
+
+    const Trs & Local(uint id) const;                   // transformao local
+    const float * World(uint id) const;                 // matriz de mundo da ltima atualizao
+    uint Parent(uint id) const;                         // pai do n (None se raiz)
+    bool Valid(uint id) const;                          // identificador em uso?
+    const vector<uint> & Changed() const;               // ns recalculados na ltima atualizao
+    SceneGraphStats Stats() const;                      // estatsticas da hierarquia
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline const Trs & SceneGraph::Local(uint id) const
+{ return locals[slot[id]]; }
+
+inline const float * SceneGraph::World(uint id) const
+{ return &worlds[ullong(slot[id]) * 16]; }
+
+inline uint SceneGraph::Parent(uint id) const
+{ return parentOf[id]; }
+
+inline bool SceneGraph::Valid(uint id) const
+{ return id < slot.size() && slot[id] != None; }
+
+inline const vector<uint> & SceneGraph::Changed() const
+{ return changed; }
+
+inline SceneGraphStats SceneGraph::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
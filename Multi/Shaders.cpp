@@ -0,0 +1,108 @@
+/**********************************************************************************
+// Shaders (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Biblioteca de shaders compilados. Cada arquivo .cso  aberto uma
+//              nica vez e mapeado em memria. Arquivos com o mesmo contedo
+//              compartilham o mesmo bytecode, identificado por um hash, e os
+//              pipelines recebem apenas referncias para ele.
+//
+**********************************************************************************/
+
+#include "Shaders.h"
+#include "Error.h"
+#include "Hash.h"
+
+// -------------------------------------------------------------------------------
+
+ShaderLibrary::ShaderLibrary()
+{
+}
+
+// -------------------------------------------------------------------------------
+
+ShaderLibrary::~ShaderLibrary()
+{
+    for (auto & c : contents)
+        Unmap(c.second);
+}
+
+// -------------------------------------------------------------------------------
+
+void ShaderLibrary::Unmap(Mapping * mapping)
+{
+    if (mapping->code.data)
+        UnmapViewOfFile(mapping->code.data);
+
+    if (mapping->map)
+        CloseHandle(mapping->map);
+
+    if (mapping->file != INVALID_HANDLE_VALUE)
+        CloseHandle(mapping->file);
+
+    delete mapping;
+}
+
+// -------------------------------------------------------------------------------
+
+const ShaderCode & ShaderLibrary::Load(const wchar_t * file)
+{
+    ++stats.requests;
+
+    // arquivo j carregado: apenas devolve a referncia
+    auto it = files.find(file);
+    if (it != files.end())
+        return *it->second;
+
+    Mapping * mapping = new Mapping{ INVALID_HANDLE_VALUE, nullptr, {} };
+
+    mapping->file = CreateFileW(file, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    LARGE_INTEGER size = {};
+    if (mapping->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(mapping->file, &size) || size.QuadPart == 0)
+    {
+        Unmap(mapping);
+        ThrowIfFailed(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+    }
+
+    mapping->map = CreateFileMappingW(mapping->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping->map)
+        mapping->code.data = MapViewOfFile(mapping->map, FILE_MAP_READ, 0, 0, 0);
+
+    if (!mapping->code.data)
+    {
+        Unmap(mapping);
+        ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+    }
+
+    mapping->code.size = ullong(size.QuadPart);
+
+    // hash do contedo
+    ullong hash = Fnv1a(mapping->code.data, mapping->code.size);
+    mapping->code.hash = hash;
+
+    ++stats.loads;
+    stats.bytes += mapping->code.size;
+
+    // contedo idntico a outro arquivo: compartilha o primeiro mapeamento
+    auto dup = contents.find(hash);
+    if (dup != contents.end())
+    {
+        ++stats.duplicates;
+        Unmap(mapping);
+        mapping = dup->second;
+    }
+    else
+    {
+        contents[hash] = mapping;
+    }
+
+    files[file] = &mapping->code;
+    return mapping->code;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,80 @@
+/**********************************************************************************
+// Shaders (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Biblioteca de shaders compilados. Cada arquivo .cso  aberto uma
+//              nica vez e mapeado em memria. Arquivos com o mesmo contedo
+//              compartilham o mesmo bytecode, identificado por um hash, e os
+//              pipelines recebem apenas referncias para ele.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SHADERS_H_
+#define DXUT_SHADERS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <windows.h>
+#include <string>
+#include <unordered_map>
+using std::unordered_map;
+using std::wstring;
+
+// -------------------------------------------------------------------------------
+
+struct ShaderCode
+{
+    const void * data = nullptr;            // bytecode mapeado em memria
+    ullong size = 0;                        // tamanho do bytecode
+    ullong hash = 0;                        // hash do contedo
+};
+
+// -------------------------------------------------------------------------------
+
+struct ShaderStats
+{
+    uint requests = 0;                      // pedidos de shaders
+    uint loads = 0;                         // arquivos abertos e mapeados
+    uint duplicates = 0;                    // arquivos com contedo j carregado
+    ullong bytes = 0;                       // bytes lidos do disco
+};
+
+// -------------------------------------------------------------------------------
+
+class ShaderLibrary
+{
+private:
+    struct Mapping
+    {
+        HANDLE file;                        // arquivo do shader
+        HANDLE map;                         // objeto de mapeamento
+        ShaderCode code;                    // bytecode compartilhado
+    };
+
+    unordered_map<wstring, const ShaderCode*> files;    // bytecode por arquivo
+    unordered_map<ullong, Mapping*> contents;           // mapeamentos por contedo
+    ShaderStats stats;                                  // estatsticas de carga
+
+    static void Unmap(Mapping * mapping);               // libera o mapeamento
+
+public:
+    ShaderLibrary();
+    ~ShaderLibrary();
+
+    const ShaderCode & Load(const wchar_t * file);      // mapeia o arquivo na primeira vez
+    ShaderStats Stats() const;                          // estatsticas de carga
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline ShaderStats ShaderLibrary::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
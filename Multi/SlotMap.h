@@ -0,0 +1,174 @@
+/**********************************************************************************
+// SlotMap (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Mapa de entradas com geraes. Os objetos ficam contguos em
+//              um vetor denso, percorrido diretamente na renderizao, e so
+//              referenciados por handles estveis: ndice de uma entrada e a
+//              gerao dela. Inserir e remover custam O(1); a remoo move o
+//              ltimo objeto para o lugar do removido e incrementa a gerao
+//              da entrada, o que invalida os handles antigos.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SLOTMAP_H_
+#define DXUT_SLOTMAP_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <utility>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct Handle
+{
+    uint index = ~0u;                       // entrada na tabela do mapa
+    uint generation = 0;                    // gerao da entrada na criao do handle
+
+    bool operator==(const Handle & h) const { return index == h.index && generation == h.generation; }
+    bool operator!=(const Handle & h) const { return !(*this == h); }
+};
+
+// -------------------------------------------------------------------------------
+
+template<class T>
+class SlotMap
+{
+public:
+    static const uint None = ~0u;           // entrada ou posio inexistente
+
+private:
+    struct Slot
+    {
+        uint dense;                         // posio do objeto (ou prxima entrada livre)
+        uint generation;                    // incrementada a cada remoo
+    };
+
+    vector<Slot> slots;                     // entradas referenciadas pelos handles
+    vector<T> items;                        // objetos contguos
+    vector<uint> owners;                    // entrada de cada objeto denso
+    uint freeHead = None;                   // primeira entrada livre
+
+public:
+    Handle Insert(const T & item);          // insere no final e retorna o handle
+    bool Remove(Handle h);                  // o ltimo objeto ocupa o lugar do removido
+    void Clear();                           // remove todos os objetos
+
+    bool Valid(Handle h) const;             // handle ainda aponta para um objeto?
+    T * Get(Handle h);                      // objeto do handle (nullptr se obsoleto)
+    uint Index(Handle h) const;             // posio densa do objeto (None se obsoleto)
+    Handle At(uint index) const;            // handle do objeto em uma posio densa
+
+    T & operator[](uint index);             // objeto em uma posio densa
+    const T & operator[](uint index) const;
+    uint Size() const;                      // nmero de objetos
+
+    typename vector<T>::iterator begin();   // percurso denso
+    typename vector<T>::iterator end();
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+template<class T>
+inline Handle SlotMap<T>::Insert(const T & item)
+{
+    uint slot = freeHead;
+
+    if (slot == None)
+    {
+        slot = uint(slots.size());
+        slots.push_back(Slot { 0, 1 });
+    }
+    else
+    {
+        freeHead = slots[slot].dense;
+    }
+
+    slots[slot].dense = uint(items.size());
+    items.push_back(item);
+    owners.push_back(slot);
+
+    return Handle { slot, slots[slot].generation };
+}
+
+template<class T>
+inline bool SlotMap<T>::Remove(Handle h)
+{
+    if (!Valid(h))
+        return false;
+
+    uint index = slots[h.index].dense;
+    uint last = uint(items.size()) - 1;
+
+    // o ltimo objeto ocupa a posio liberada
+    if (index != last)
+    {
+        items[index] = std::move(items[last]);
+        owners[index] = owners[last];
+        slots[owners[index]].dense = index;
+    }
+
+    items.pop_back();
+    owners.pop_back();
+
+    // nova gerao invalida os handles existentes
+    slots[h.index].generation++;
+    slots[h.index].dense = freeHead;
+    freeHead = h.index;
+    return true;
+}
+
+template<class T>
+inline void SlotMap<T>::Clear()
+{
+    // as entradas mudam de gerao: handles antigos ficam obsoletos
+    while (!items.empty())
+        Remove(At(Size() - 1));
+}
+
+template<class T>
+inline bool SlotMap<T>::Valid(Handle h) const
+{ return h.index < slots.size() && slots[h.index].generation == h.generation; }
+
+template<class T>
+inline T * SlotMap<T>::Get(Handle h)
+{ return Valid(h) ? &items[slots[h.index].dense] : nullptr; }
+
+template<class T>
+inline uint SlotMap<T>::Index(Handle h) const
+{ return Valid(h) ? slots[h.index].dense : uint(None); }
+
+template<class T>
+inline Handle SlotMap<T>::At(uint index) const
+{ return Handle { owners[index], slots[owners[index]].generation }; }
+
+template<class T>
+inline T & SlotMap<T>::operator[](uint index)
+{ return items[index]; }
+
+template<class T>
+inline const T & SlotMap<T>::operator[](uint index) const
+{ return items[index]; }
+
+template<class T>
+inline uint SlotMap<T>::Size() const
+{ return uint(items.size()); }
+
+template<class T>
+inline typename vector<T>::iterator SlotMap<T>::begin()
+{ return items.begin(); }
+
+template<class T>
+inline typename vector<T>::iterator SlotMap<T>::end()
+{ return items.end(); }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,55 @@
+/**********************************************************************************
+// TessLevels (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Faixas de tesselao de esferas e cilindros (fatias e camadas)
+//              e a escolha da faixa a partir do raio projetado na tela, sem
+//              depender do Direct3D.
+//
+**********************************************************************************/
+
+#ifndef DXUT_TESSLEVELS_H_
+#define DXUT_TESSLEVELS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+
+const uint TessBuckets = 6;                 // nmero de faixas de tesselao
+
+// fatias e camadas de cada faixa
+const uint SphereLevels[TessBuckets][2] =
+{
+    {  8,  6 }, { 12,  8 }, { 20, 20 }, { 32, 24 }, { 48, 32 }, { 64, 40 }
+};
+
+const uint CylinderLevels[TessBuckets][2] =
+{
+    {  8,  1 }, { 12,  2 }, { 20, 10 }, { 32, 10 }, { 48, 12 }, { 64, 16 }
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+// menor faixa cujo erro da corda fica abaixo de meio pixel
+inline uint TessBucket(float pixels)
+{
+    // n = PI / acos(1 - 0.5/r), aproximado por PI * sqrt(r)
+    float segments = 3.14159265f * sqrtf(pixels > 1.0f ? pixels : 1.0f);
+
+    for (uint i = 0; i < TessBuckets; ++i)
+        if (float(SphereLevels[i][0]) >= segments)
+            return i;
+
+    return TessBuckets - 1;
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,146 @@
+/**********************************************************************************
+// Tessellation (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Gera sob demanda variantes de esferas e cilindros com nmero
+//              de fatias e camadas escolhido a partir do raio projetado na tela
+//
+**********************************************************************************/
+
+#include "Tessellation.h"
+#include "Engine.h"
+
+// -------------------------------------------------------------------------------
+
+Tessellation::Tessellation(const TessDesc & shape, uint cbSize, uint bucket)
+    : desc(shape), cbufferSize(cbSize), current(bucket), wanted(bucket)
+{
+    for (uint i = 0; i < Buckets; ++i)
+    {
+        meshes[i] = nullptr;
+        indexCount[i] = 0;
+        pending[i] = nullptr;
+        ready[i] = nullptr;
+    }
+
+    // a variante inicial  gerada imediatamente para que o
+    // objeto tenha sempre uma malha vlida para desenhar
+    ready[bucket] = new Geometry(Generate(desc, bucket));
+    Upload();
+}
+
+// -------------------------------------------------------------------------------
+
+Tessellation::~Tessellation()
+{
+    for (uint i = 0; i < Buckets; ++i)
+    {
+        // espera geraes em andamento
+        Engine::jobs->Wait(generating[i]);
+
+        delete pending[i];
+        delete ready[i];
+        delete meshes[i];
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+Geometry Tessellation::Generate(const TessDesc & desc, uint bucket)
+{
+    Geometry geo;
+
+    if (desc.shape == TESS_SPHERE)
+        geo = Sphere(desc.radius, SphereLevels[bucket][0], SphereLevels[bucket][1]);
+    else
+        geo = Cylinder(desc.radius, desc.top, desc.height, CylinderLevels[bucket][0], CylinderLevels[bucket][1]);
+
+    for (auto & v : geo.vertices) v.color = desc.color;
+
+    return geo;
+}
+
+// -------------------------------------------------------------------------------
+
+void Tessellation::Request(uint bucket)
+{
+    wanted = bucket;
+
+    // variante j est na GPU: a troca  imediata
+    if (meshes[bucket])
+    {
+        current = bucket;
+        return;
+    }
+
+    // gera a variante em segundo plano e continua
+    // desenhando a atual at que ela fique pronta
+    if (!pending[bucket] && !ready[bucket])
+    {
+        Geometry * geo = pending[bucket] = new Geometry();
+        TessDesc shape = desc;
+
+        Engine::jobs->Run([geo, shape, bucket] { *geo = Generate(shape, bucket); }, &generating[bucket]);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool Tessellation::Poll()
+{
+    bool any = false;
+
+    for (uint i = 0; i < Buckets; ++i)
+    {
+        if (pending[i] && generating[i].Done())
+        {
+            ready[i] = pending[i];
+            pending[i] = nullptr;
+        }
+
+        any |= (ready[i] != nullptr);
+    }
+
+    return any;
+}
+
+// -------------------------------------------------------------------------------
+
+void Tessellation::Upload()
+{
+    for (uint i = 0; i < Buckets; ++i)
+    {
+        if (!ready[i])
+            continue;
+
+        Geometry * geo = ready[i];
+
+        meshes[i] = new Mesh();
+        meshes[i]->VertexBuffer(geo->VertexData(), geo->VertexCount() * sizeof(Vertex), sizeof(Vertex));
+        meshes[i]->IndexBuffer(geo->IndexData(), geo->IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
+        meshes[i]->ConstantBuffer(cbufferSize);
+        indexCount[i] = geo->IndexCount();
+
+        delete geo;
+        ready[i] = nullptr;
+    }
+
+    // troca para a variante desejada assim que ela estiver disponvel
+    if (meshes[wanted])
+        current = wanted;
+}
+
+// -------------------------------------------------------------------------------
+
+float Tessellation::Radius()
+{
+    if (desc.shape == TESS_SPHERE)
+        return desc.radius;
+
+    return desc.radius > desc.top ? desc.radius : desc.top;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+/**********************************************************************************
+// Tessellation (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Gera sob demanda variantes de esferas e cilindros com nmero
+//              de fatias e camadas escolhido a partir do raio projetado na tela
+//
+**********************************************************************************/
+
+#ifndef DXUT_TESSELLATION_H_
+#define DXUT_TESSELLATION_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Geometry.h"
+#include "Mesh.h"
+#include "Jobs.h"
+#include "TessLevels.h"
+
+// -------------------------------------------------------------------------------
+
+enum TessShape { TESS_SPHERE, TESS_CYLINDER };
+
+// -------------------------------------------------------------------------------
+
+struct TessDesc
+{
+    uint     shape = TESS_SPHERE;           // forma gerada (esfera ou cilindro)
+    float    radius = 1.0f;                 // raio da esfera ou raio da base do cilindro
+    float    top = 1.0f;                    // raio do topo do cilindro
+    float    height = 1.0f;                 // altura do cilindro
+    XMFLOAT4 color = XMFLOAT4(Colors::Yellow); // cor dos vrtices
+};
+
+// -------------------------------------------------------------------------------
+
+class Tessellation
+{
+public:
+    static const uint Buckets = TessBuckets; // nmero de faixas de tesselao
+    static const uint Default = 2;          // faixa usada fora do modo adaptativo
+
+private:
+    TessDesc desc;                          // descrio da forma
+    uint cbufferSize;                       // tamanho do buffer constante de cada variante
+    uint current;                           // faixa em uso no desenho
+    uint wanted;                            // faixa desejada para o prximo quadro
+
+    Mesh * meshes[Buckets];                 // variantes j copiadas para a GPU
+    uint indexCount[Buckets];               // nmero de ndices de cada variante
+    JobCounter generating[Buckets];         // tarefas de gerao de cada variante
+    Geometry * pending[Buckets];            // variantes em gerao nas threads de trabalho
+    Geometry * ready[Buckets];              // variantes geradas aguardando cpia para a GPU
+
+public:
+    Tessellation(const TessDesc & shape, uint cbSize, uint bucket = Default);
+    ~Tessellation();
+
+    static Geometry Generate(const TessDesc & desc, uint bucket);   // gera uma variante na CPU
+
+    static uint Bucket(float pixels);       // escolhe a faixa a partir do raio projetado (em pixels)
+
+    void Request(uint bucket);              // solicita uma variante (gerada em segundo plano)
+    bool Poll();                            // verifica se existem variantes prontas para cpia
+    void Upload();                          // agenda cpia das variantes prontas para a GPU
+
+    Mesh * Current();                       // malha da variante em uso
+    uint IndexCount();                      // nmero de ndices da variante em uso
+    float Radius();                         // maior raio da forma (espao do objeto)
+};
+
+// -------------------------------------------------------------------------------
+// Funes Inline
+
+inline uint Tessellation::Bucket(float pixels)
+{ return TessBucket(pixels); }
+
+inline Mesh * Tessellation::Current()
+{ return meshes[current]; }
+
+inline uint Tessellation::IndexCount()
+{ return indexCount[current]; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,190 @@
+/**********************************************************************************
+// AllocatorTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Exercita o pool de heaps sobre MemoryHeap: blocos alinhados
+//              que no se sobrepem, estatsticas, heaps maiores para pedidos
+//              grandes e a destruio de heaps vazias por Trim. Com "bench",
+//              mede alocaes e liberaes misturadas contra malloc e free.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Allocator.h"
+#include <cstdlib>
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// MemoryHeap que conta as heaps vivas
+class CountingHeap : public MemoryHeap
+{
+public:
+    uint live = 0;
+    uint created = 0;
+
+    void * Create(ullong size) { ++live; ++created; return MemoryHeap::Create(size); }
+    void Destroy(void * heap) { --live; MemoryHeap::Destroy(heap); }
+};
+
+// bytes de uma alocao na memria do sistema
+static byte * Bytes(const PoolAllocation & alloc)
+{
+    return static_cast<byte *>(alloc.heap) + alloc.offset;
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(17);
+    const ullong HeapSize = 1 << 20;
+
+    {
+        CountingHeap heaps;
+        HeapPool pool(&heaps, HeapSize, 256);
+        vector<PoolAllocation> allocs;
+        ullong requested = 0;
+
+        // tamanhos e alinhamentos variados; cada bloco recebe um padro prprio
+        for (uint i = 0; i < 2000; ++i)
+        {
+            ullong size = 1 + rng() % 20000;
+            ullong alignment = 256ull << (rng() % 5);
+            PoolAllocation alloc;
+
+            CHECK(pool.Allocate(size, alignment, &alloc));
+            CHECK(alloc.offset % alignment == 0);
+            CHECK(alloc.size == size);
+
+            memset(Bytes(alloc), int(i & 0xFF), size_t(size));
+            allocs.push_back(alloc);
+            requested += size;
+        }
+
+        // nenhum bloco foi sobrescrito por outro
+        bool intact = true;
+
+        for (uint i = 0; i < allocs.size(); ++i)
+            for (ullong b = 0; b < allocs[i].size; ++b)
+                intact = intact && Bytes(allocs[i])[b] == byte(i & 0xFF);
+
+        CHECK(intact);
+
+        AllocStats stats = pool.Stats();
+        CHECK(stats.allocations == 2000);
+        CHECK(stats.bytesInUse == requested);
+        CHECK(stats.bytesReserved >= requested);
+        CHECK(stats.heaps == heaps.live);
+        CHECK(stats.capacity == stats.heaps * HeapSize);
+
+        // pedido maior que a heap padro cria uma heap do tamanho dele
+        PoolAllocation big;
+        CHECK(pool.Allocate(3 * HeapSize, 256, &big));
+        CHECK(big.offset == 0);
+        memset(Bytes(big), 0xAB, size_t(big.size));
+        CHECK(pool.Stats().capacity == stats.capacity + 4 * HeapSize);
+        pool.Free(big);
+
+        // metade liberada: a memria volta para novas alocaes
+        for (uint i = 0; i < allocs.size(); i += 2)
+            pool.Free(allocs[i]);
+
+        CHECK(pool.Stats().allocations == 1000);
+
+        for (uint i = 0; i < allocs.size(); i += 2)
+            CHECK(pool.Allocate(allocs[i].size, 256, &allocs[i]));
+
+        uint heapsBefore = heaps.created;
+
+        for (PoolAllocation & alloc : allocs)
+            pool.Free(alloc);
+
+        // tudo livre: Trim mantm apenas a primeira heap
+        stats = pool.Stats();
+        CHECK(stats.allocations == 0 && stats.bytesInUse == 0 && stats.bytesReserved == 0);
+
+        pool.Trim();
+        CHECK(heaps.live == 1);
+
+        // os blocos liberados voltaram a formar a heap inteira
+        stats = pool.Stats();
+        CHECK(stats.heaps == 1);
+        CHECK(stats.largestFree == HeapSize);
+        CHECK(stats.Fragmentation() == 0.0f);
+
+        // posies de heaps destrudas so reaproveitadas
+        PoolAllocation again;
+        CHECK(pool.Allocate(HeapSize, 256, &again));
+        CHECK(pool.Allocate(HeapSize, 256, &again));
+        CHECK(heaps.live == 2);
+        CHECK(again.block < heapsBefore);
+    }
+
+    // o destrutor do pool devolve todas as heaps
+    CountingHeap heaps;
+    {
+        HeapPool pool(&heaps, HeapSize, 256);
+        PoolAllocation alloc;
+        pool.Allocate(100, 256, &alloc);
+        pool.Allocate(2 * HeapSize, 256, &alloc);
+    }
+    CHECK(heaps.live == 0);
+
+    if (Bench(argc, argv))
+    {
+        // 10 mil blocos vivos, trocados em rodzio por blocos de tamanho aleatrio
+        const uint live = 10000, steps = 1000000;
+        vector<ullong> sizes(steps);
+
+        for (ullong & size : sizes)
+            size = 256 + rng() % 65536;
+
+        MemoryHeap memory;
+        HeapPool pool(&memory, 64ull << 20, 256);
+        vector<PoolAllocation> allocs(live);
+        vector<void *> blocks(live);
+
+        for (uint i = 0; i < live; ++i)
+        {
+            pool.Allocate(sizes[i], 256, &allocs[i]);
+            blocks[i] = malloc(size_t(sizes[i]));
+        }
+
+        double pooled = Measure(3, [&] {
+            for (uint s = 0; s < steps; ++s)
+            {
+                PoolAllocation & alloc = allocs[s % live];
+                pool.Free(alloc);
+                pool.Allocate(sizes[s], 256, &alloc);
+            }
+        });
+
+        double system = Measure(3, [&] {
+            for (uint s = 0; s < steps; ++s)
+            {
+                void *& block = blocks[s % live];
+                free(block);
+                block = malloc(size_t(sizes[s]));
+            }
+        });
+
+        AllocStats stats = pool.Stats();
+        printf("allocator: %u blocos vivos, %u trocas\n", live, steps);
+        printf("  pool buddy     %6.1f ns por troca, %u heaps, fragmentao %.2f\n",
+               pooled * 1e6 / steps, stats.heaps, stats.Fragmentation());
+        printf("  malloc e free  %6.1f ns por troca\n", system * 1e6 / steps);
+
+        for (void * block : blocks)
+            free(block);
+    }
+
+    return Report("AllocatorTest");
+}
+
+// -------------------------------------------------------------------------------
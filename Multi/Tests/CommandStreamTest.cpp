@@ -0,0 +1,161 @@
+/**********************************************************************************
+// CommandStreamTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica a gravao de comandos e a validao feita pelo
+//              NullBackend: contagens por tipo, estados que persistem entre
+//              fluxos da mesma lista e cada tipo de comando invlido. Com
+//              "bench", mede a gravao e a execuo de um milho de comandos.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "CommandStream.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// estados exigidos por um desenho, com um index buffer de 100 ndices de 4 bytes
+static void States(CommandStream & stream)
+{
+    stream.Pipeline(1);
+    stream.RootSignature(2);
+    stream.Topology(4);
+    stream.Viewport(0, 0, 640, 360);
+    stream.Constants(1, 0x100);
+    stream.Table(0, 0x200);
+    stream.VertexBuffer(0x1000, 4096, 28);
+    stream.IndexBuffer(0x2000, 400, 4);
+}
+
+// erros encontrados ao executar um nico comando depois dos estados vlidos
+template<class Record>
+static uint Errors(Record record)
+{
+    CommandStream stream;
+    NullBackend backend;
+
+    States(stream);
+    record(stream);
+    backend.Execute(stream);
+    return backend.Stats().errors;
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    CommandStream stream;
+    NullBackend backend;
+
+    // gravao: os campos de cada comando chegam ao backend como foram gravados
+    States(stream);
+    stream.Draw(36, 6, -2, 3);
+    CHECK(stream.Size() == 9);
+
+    const RenderCommand & draw = stream.Data()[8];
+    CHECK(draw.type == CMD_DRAW);
+    CHECK(draw.draw.indexCount == 36 && draw.draw.startIndex == 6);
+    CHECK(draw.draw.baseVertex == -2 && draw.draw.instanceCount == 3);
+    CHECK(stream.Data()[6].buffer.address == 0x1000 && stream.Data()[6].buffer.stride == 28);
+    CHECK(stream.Data()[4].slot == 1 && stream.Data()[4].handle == 0x100);
+    CHECK(stream.Data()[3].viewport.width == 640 && stream.Data()[3].viewport.maxDepth == 1.0f);
+
+    backend.Execute(stream);
+    CommandStats stats = backend.Stats();
+    CHECK(stats.errors == 0);
+    CHECK(stats.commands == 9);
+    CHECK(stats.draws == 1);
+    CHECK(stats.indices == 36 * 3);
+
+    for (uint type = 0; type < CMD_COUNT; ++type)
+        CHECK(stats.counts[type] == 1);
+
+    // estados persistem entre fluxos da mesma lista
+    CommandStream next;
+    next.Draw(100);
+    next.Draw(50, 50);
+    backend.Execute(next);
+    CHECK(backend.Stats().errors == 0);
+    CHECK(backend.Stats().draws == 3);
+
+    // nova lista: nenhum estado definido
+    backend.Reset();
+    CHECK(backend.Stats().commands == 0);
+    backend.Execute(next);
+    CHECK(backend.Stats().errors == 2);
+
+    stream.Clear();
+    CHECK(stream.Size() == 0);
+
+    // cada comando invlido gera exatamente um erro
+    CHECK(Errors([](CommandStream &) {}) == 0);
+    CHECK(Errors([](CommandStream & s) { s.Draw(100); }) == 0);
+    CHECK(Errors([](CommandStream & s) { s.Draw(101); }) == 1);               // alm do index buffer
+    CHECK(Errors([](CommandStream & s) { s.Draw(50, 51); }) == 1);            // incio alm do fim
+    CHECK(Errors([](CommandStream & s) { s.Draw(0); }) == 1);                 // nenhum ndice
+    CHECK(Errors([](CommandStream & s) { s.Draw(3, 0, 0, 0); }) == 1);        // nenhuma instncia
+    CHECK(Errors([](CommandStream & s) { s.Pipeline(0); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.Constants(1, 0); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.Viewport(0, 0, 0, 360); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.Viewport(0, 0, 640, 360, 1.0f, 0.0f); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.VertexBuffer(0x1000, 4096, 0); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.VertexBuffer(0x1000, 16, 28); }) == 1);
+    CHECK(Errors([](CommandStream & s) { s.IndexBuffer(0x2000, 400, 3); }) == 1);
+
+    // um index buffer de 2 bytes por ndice comporta o dobro de ndices
+    CHECK(Errors([](CommandStream & s) { s.IndexBuffer(0x2000, 400, 2); s.Draw(200); }) == 0);
+
+    // desenho sem nenhum estado definido
+    CommandStream alone;
+    alone.Draw(3);
+    backend.Reset();
+    backend.Execute(alone);
+    CHECK(backend.Stats().errors == 1);
+
+    if (Bench(argc, argv))
+    {
+        // 1 milho de comandos: a cada 8 desenhos, trocas de malha e de tabela
+        const uint commands = 1000000;
+        uint recorded = 0;
+
+        double record = Measure(10, [&] {
+            stream.Clear();
+            States(stream);
+
+            for (uint i = 0; stream.Size() < commands; ++i)
+            {
+                if (i % 8 == 0)
+                {
+                    stream.VertexBuffer(0x1000 + i * 4096ull, 4096, 28);
+                    stream.IndexBuffer(0x9000000 + i * 4096ull, 4096, 4);
+                }
+
+                stream.Table(0, 0x200 + i * 32ull);
+                stream.Draw(36);
+            }
+
+            recorded = stream.Size();
+        });
+
+        double execute = Measure(10, [&] {
+            backend.Reset();
+            backend.Execute(stream);
+        });
+
+        CHECK(backend.Stats().errors == 0);
+
+        printf("command stream: %u comandos, %u desenhos (%zu bytes por comando)\n",
+               recorded, backend.Stats().draws, sizeof(RenderCommand));
+        printf("  gravao  %7.3f ms (%5.1f milhes de comandos/s)\n", record, recorded / record / 1e3);
+        printf("  execuo  %7.3f ms (%5.1f milhes de comandos/s)\n", execute, recorded / execute / 1e3);
+    }
+
+    return Report("CommandStreamTest");
+}
+
+// -------------------------------------------------------------------------------
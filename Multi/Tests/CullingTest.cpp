@@ -0,0 +1,260 @@
+/**********************************************************************************
+// CullingTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Compara o descarte por volume de viso, na passada linear e no
+//              percurso da BVH, com um teste escalar de referncia, inclusive
+//              depois de mover e remover objetos. Com "bench", mede as duas
+//              passadas em uma cena de 100 mil objetos vista por 4 cmeras.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Culling.h"
+#include "Bvh.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+const uint Views = 4;                       // vistas testadas na mesma passada
+
+// perspectiva com vetores linha (conveno do Direct3D) girada em torno do eixo y
+static void ViewProj(float yaw, float * m)
+{
+    float c = cosf(yaw), s = sinf(yaw);
+    float n = 1.0f, f = 500.0f, ys = 1.7320508f, xs = ys * 9.0f / 16.0f;
+
+    float view[16] = { c, 0, s, 0,  0, 1, 0, 0,  -s, 0, c, 0,  0, 0, 0, 1 };
+    float proj[16] = { xs, 0, 0, 0,  0, ys, 0, 0,  0, 0, f / (f - n), 1,  0, 0, -n * f / (f - n), 0 };
+
+    for (uint r = 0; r < 4; ++r)
+        for (uint col = 0; col < 4; ++col)
+        {
+            m[r * 4 + col] = 0;
+
+            for (uint k = 0; k < 4; ++k)
+                m[r * 4 + col] += view[r * 4 + k] * proj[k * 4 + col];
+        }
+}
+
+// -------------------------------------------------------------------------------
+
+// teste escalar de referncia: esfera e caixa contra os 6 planos normalizados;
+// margin recebe a menor distncia do volume s fronteiras do teste
+static bool Inside(const float * m, const Bounds & b, float & margin)
+{
+    float planes[6][4];
+
+    for (uint r = 0; r < 4; ++r)
+    {
+        planes[0][r] = m[r * 4 + 3] + m[r * 4];
+        planes[1][r] = m[r * 4 + 3] - m[r * 4];
+        planes[2][r] = m[r * 4 + 3] + m[r * 4 + 1];
+        planes[3][r] = m[r * 4 + 3] - m[r * 4 + 1];
+        planes[4][r] = m[r * 4 + 2];
+        planes[5][r] = m[r * 4 + 3] - m[r * 4 + 2];
+    }
+
+    bool inside = true;
+    margin = 1e30f;
+
+    for (uint p = 0; p < 6; ++p)
+    {
+        float * pl = planes[p];
+        float len = sqrtf(pl[0] * pl[0] + pl[1] * pl[1] + pl[2] * pl[2]);
+
+        for (uint k = 0; k < 4; ++k)
+            pl[k] /= len;
+
+        float d = b.center[0] * pl[0] + b.center[1] * pl[1] + b.center[2] * pl[2] + pl[3];
+        float e = b.extents[0] * fabsf(pl[0]) + b.extents[1] * fabsf(pl[1]) + b.extents[2] * fabsf(pl[2]);
+
+        inside = inside && d >= -b.radius && d + e >= 0;
+        margin = std::min(margin, std::min(fabsf(d + b.radius), fabsf(d + e)));
+    }
+
+    return inside;
+}
+
+// -------------------------------------------------------------------------------
+
+static Bounds Random(std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+
+    Bounds b;
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        b.center[k] = position(rng);
+        b.extents[k] = size(rng);
+    }
+
+    b.radius = sqrtf(b.extents[0] * b.extents[0] + b.extents[1] * b.extents[1] + b.extents[2] * b.extents[2]);
+    return b;
+}
+
+// -------------------------------------------------------------------------------
+
+// listas visveis do culler iguais  referncia, exceto nos volumes que tocam
+// uma fronteira, onde a ordem das operaes em ponto flutuante decide
+static uint Mismatches(const FrustumCuller & culler, const vector<Bounds> & scene, float viewProj[][16])
+{
+    uint errors = 0;
+    vector<char> visible(scene.size());
+
+    for (uint v = 0; v < Views; ++v)
+    {
+        std::fill(visible.begin(), visible.end(), 0);
+
+        for (uint i : culler.Visible(v))
+        {
+            if (visible[i])
+                ++errors;
+
+            visible[i] = 1;
+        }
+
+        for (uint i = 0; i < scene.size(); ++i)
+        {
+            float margin;
+            bool inside = Inside(viewProj[v], scene[i], margin);
+
+            if (margin > 1e-3f && inside != bool(visible[i]))
+                ++errors;
+        }
+    }
+
+    return errors;
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(7);
+    float viewProj[Views][16];
+
+    FrustumCuller culler;
+    Bvh bvh;
+    vector<Bounds> scene;
+
+    for (uint v = 0; v < Views; ++v)
+    {
+        ViewProj(v * 1.5707963f, viewProj[v]);
+        culler.View(v, viewProj[v]);
+    }
+
+    for (uint i = 0; i < 20000; ++i)
+    {
+        scene.push_back(Random(rng));
+        culler.Add(scene.back());
+        bvh.Add(scene.back());
+    }
+
+    bvh.Build();
+
+    // passada linear e percurso da BVH contra a referncia
+    culler.Cull((1u << Views) - 1);
+    CHECK(Mismatches(culler, scene, viewProj) == 0);
+
+    for (uint v = 0; v < Views; ++v)
+    {
+        CHECK(!culler.Visible(v).empty());
+        CHECK(culler.Stats(v).tested == scene.size());
+        CHECK(culler.Stats(v).culled == scene.size() - culler.Visible(v).size());
+    }
+
+    culler.Cull((1u << Views) - 1, bvh);
+    CHECK(Mismatches(culler, scene, viewProj) == 0);
+
+    // objetos movidos reajustam a rvore
+    for (uint k = 0; k < 2000; ++k)
+    {
+        uint i = rng() % scene.size();
+        scene[i] = Random(rng);
+        culler.Set(i, scene[i]);
+        bvh.Set(i, scene[i]);
+    }
+
+    bvh.Update();
+    culler.Cull((1u << Views) - 1, bvh);
+    CHECK(Mismatches(culler, scene, viewProj) == 0);
+
+    // remoes: o ltimo volume ocupa o lugar do removido nas duas estruturas
+    for (uint k = 0; k < 1000; ++k)
+    {
+        uint i = rng() % scene.size();
+        scene[i] = scene.back();
+        scene.pop_back();
+        culler.Remove(i);
+        bvh.Remove(i);
+    }
+
+    bvh.Update();
+    culler.Cull((1u << Views) - 1, bvh);
+    CHECK(Mismatches(culler, scene, viewProj) == 0);
+    culler.Cull((1u << Views) - 1);
+    CHECK(Mismatches(culler, scene, viewProj) == 0);
+
+    if (Bench(argc, argv))
+    {
+        const uint objects = 100000;
+
+        culler.Clear();
+        bvh.Clear();
+        scene.clear();
+
+        for (uint i = 0; i < objects; ++i)
+        {
+            scene.push_back(Random(rng));
+            culler.Add(scene.back());
+            bvh.Add(scene.back());
+        }
+
+        double build = Measure(5, [&] { bvh.Build(); });
+        double linear = Measure(20, [&] { culler.Cull((1u << Views) - 1); });
+        uint visible = 0;
+
+        for (uint v = 0; v < Views; ++v)
+            visible += uint(culler.Visible(v).size());
+
+        double tree = Measure(20, [&] { culler.Cull((1u << Views) - 1, bvh); });
+
+        // 1% dos objetos se desloca um pouco a cada quadro
+        std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+
+        double refit = Measure(20, [&] {
+            for (uint k = 0; k < objects / 100; ++k)
+            {
+                uint i = rng() % objects;
+
+                for (uint c = 0; c < 3; ++c)
+                    scene[i].center[c] += step(rng);
+
+                culler.Set(i, scene[i]);
+                bvh.Set(i, scene[i]);
+            }
+
+            bvh.Update();
+        });
+
+        printf("culling: %u objetos, %u vistas, %u visveis\n", objects, Views, visible);
+        printf("  passada linear   %8.3f ms\n", linear);
+        printf("  percurso da BVH  %8.3f ms\n", tree);
+        printf("  construo       %8.3f ms\n", build);
+        printf("  mover 1%%         %8.3f ms\n", refit);
+    }
+
+    return Report("CullingTest");
+}
+
+// -------------------------------------------------------------------------------
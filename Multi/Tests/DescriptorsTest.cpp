@@ -0,0 +1,209 @@
+/**********************************************************************************
+// DescriptorsTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica o DescriptorAllocator: a regio persistente reserva o
+//              primeiro intervalo que comporta o pedido, intervalos liberados
+//              vizinhos voltam a formar um s e a regio de cada quadro 
+//              reiniciada por BeginFrame sem invadir as demais. Com "bench",
+//              mede reservas e liberaes de 3 descritores com 100 mil blocos
+//              vivos.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Descriptors.h"
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    const uint Invalid = DescriptorAllocator::Invalid;
+
+    // first-fit: blocos consecutivos e o primeiro buraco que comporta o pedido
+    {
+        DescriptorAllocator heap(100, 10, 3);
+        CHECK(heap.Capacity() == 130);
+
+        uint a = heap.Allocate(10);
+        uint b = heap.Allocate(20);
+        uint c = heap.Allocate(30);
+        CHECK(a == 0 && b == 10 && c == 30);
+
+        // o buraco de 10 no incio recebe o primeiro pedido que cabe nele;
+        // o de 10 que sobraria s com 5 livres vai para o fim da regio
+        heap.Free(a, 10);
+        CHECK(heap.Allocate(5) == 0);
+        CHECK(heap.Allocate(10) == 60);
+        CHECK(heap.Allocate(5) == 5);
+
+        DescriptorStats stats = heap.Stats();
+        CHECK(stats.persistentUsed == 70);
+        CHECK(stats.persistentFree == 30);
+        CHECK(stats.largestFree == 30);
+
+        // pedido maior que qualquer intervalo falha sem alterar nada
+        CHECK(heap.Allocate(31) == Invalid);
+        CHECK(heap.Stats().persistentUsed == 70);
+        CHECK(heap.Allocate(30) == 70);
+        CHECK(heap.Allocate(1) == Invalid);
+        CHECK(heap.Stats().largestFree == 0);
+    }
+
+    // fuso dos intervalos livres com o anterior, o seguinte ou ambos
+    {
+        DescriptorAllocator heap(60, 0);
+        uint blocks[6];
+        for (uint i = 0; i < 6; ++i)
+            blocks[i] = heap.Allocate(10);
+
+        heap.Free(blocks[1], 10);
+        heap.Free(blocks[3], 10);
+        CHECK(heap.Stats().largestFree == 10);
+
+        // entre dois livres: os trs viram um intervalo de 30
+        heap.Free(blocks[2], 10);
+        CHECK(heap.Stats().largestFree == 30);
+        CHECK(heap.Allocate(30) == 10);
+
+        heap.Free(10, 30);
+        heap.Free(blocks[0], 10);
+        heap.Free(blocks[5], 10);
+        heap.Free(blocks[4], 10);
+
+        // tudo livre volta a ser um nico intervalo
+        DescriptorStats stats = heap.Stats();
+        CHECK(stats.persistentUsed == 0);
+        CHECK(stats.persistentFree == 60);
+        CHECK(stats.largestFree == 60);
+        CHECK(heap.Allocate(60) == 0);
+
+        // ndices invlidos e contagens nulas so ignorados
+        heap.Free(Invalid, 10);
+        heap.Free(0, 0);
+        CHECK(heap.Stats().persistentUsed == 60);
+    }
+
+    // regies de quadro: depois da persistente, uma por quadro em voo
+    {
+        DescriptorAllocator heap(100, 10, 3);
+
+        for (uint frame = 0; frame < 6; ++frame)
+        {
+            heap.BeginFrame(frame);
+            CHECK(heap.Stats().frameUsed == 0);
+
+            uint base = 100 + (frame % 3) * 10;
+            CHECK(heap.AllocateFrame(4) == base);
+            CHECK(heap.AllocateFrame(6) == base + 4);
+
+            // a regio do quadro est cheia e no invade a seguinte
+            CHECK(heap.AllocateFrame(1) == Invalid);
+            CHECK(heap.Stats().frameUsed == 10);
+        }
+
+        CHECK(heap.Stats().framePeak == 10);
+
+        // a regio persistente no  afetada pelos quadros
+        CHECK(heap.Allocate(100) == 0);
+
+        heap.BeginFrame(1);
+        heap.AllocateFrame(2);
+        CHECK(heap.Stats().frameUsed == 2);
+        CHECK(heap.Stats().framePeak == 10);
+    }
+
+    // reservas e liberaes aleatrias conferidas contra um mapa de ocupao
+    {
+        const uint Count = 4096;
+        DescriptorAllocator heap(Count, 0);
+        vector<bool> used(Count, false);
+        vector<uint> starts, sizes;
+        std::mt19937 rng(29);
+        bool consistent = true;
+
+        for (uint step = 0; step < 20000; ++step)
+        {
+            if (starts.empty() || rng() % 3)
+            {
+                uint size = 1 + rng() % 24;
+                uint index = heap.Allocate(size);
+
+                if (index == Invalid)
+                    continue;
+
+                // o bloco no cruza outro em uso nem o fim da regio
+                consistent = consistent && index + size <= Count;
+                for (uint i = index; i < index + size && i < Count; ++i)
+                {
+                    consistent = consistent && !used[i];
+                    used[i] = true;
+                }
+
+                starts.push_back(index);
+                sizes.push_back(size);
+            }
+            else
+            {
+                uint k = rng() % starts.size();
+                heap.Free(starts[k], sizes[k]);
+
+                for (uint i = starts[k]; i < starts[k] + sizes[k]; ++i)
+                    used[i] = false;
+
+                // o ltimo bloco ocupa a posio do liberado
+                starts[k] = starts.back();
+                sizes[k] = sizes.back();
+                starts.pop_back();
+                sizes.pop_back();
+            }
+
+            uint total = 0;
+            for (uint s : sizes)
+                total += s;
+
+            consistent = consistent && heap.Stats().persistentUsed == total;
+        }
+
+        CHECK(consistent);
+
+        for (uint k = 0; k < starts.size(); ++k)
+            heap.Free(starts[k], sizes[k]);
+
+        CHECK(heap.Stats().largestFree == Count);
+    }
+
+    if (Bench(argc, argv))
+    {
+        // 100 mil malhas com 3 descritores cada, trocadas em rodzio
+        const uint live = 100000, steps = 1000000;
+        DescriptorAllocator heap(live * 3 + 3, 0);
+        vector<uint> blocks(live);
+        std::mt19937 rng(7);
+
+        for (uint & block : blocks)
+            block = heap.Allocate(3);
+
+        double time = Measure(3, [&] {
+            for (uint s = 0; s < steps; ++s)
+            {
+                uint & block = blocks[rng() % live];
+                heap.Free(block, 3);
+                block = heap.Allocate(3);
+            }
+        });
+
+        printf("descriptors: %u blocos vivos de 3 descritores\n", live);
+        printf("  liberao e reserva %7.1f ns, maior intervalo livre %u\n", time * 1e6 / steps, heap.Stats().largestFree);
+    }
+
+    return Report("DescriptorsTest");
+}
+
+// -------------------------------------------------------------------------------
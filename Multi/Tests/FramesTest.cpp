@@ -0,0 +1,101 @@
+/**********************************************************************************
+// FramesTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica o NullFence e o controle dos quadros em voo: a CPU s
+//              espera quando a GPU simulada fica mais quadros para trs do que
+//              os recursos permitem. Com "bench", mede o custo de encerrar um
+//              quadro.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Frames.h"
+
+// -------------------------------------------------------------------------------
+
+// esperas em 100 quadros com frames quadros em voo e uma GPU latency sinais atrs
+static FrameStats Run(uint frames, uint latency)
+{
+    NullFence fence(latency);
+    FrameSync sync(&fence, frames);
+
+    for (uint i = 0; i < 100; ++i)
+    {
+        CHECK(sync.Index() == i % frames);
+        ullong value = sync.EndFrame();
+
+        // o quadro que ser reutilizado j foi concludo pela GPU
+        CHECK(value == i + 1);
+        CHECK(i + 1 < frames || fence.Completed() >= value - frames + 1);
+    }
+
+    sync.WaitIdle();
+    CHECK(fence.Completed() == 100);
+    return sync.Stats();
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    // GPU sem atraso conclui cada sinal imediatamente
+    NullFence immediate;
+    CHECK(immediate.Signal() == 1);
+    CHECK(immediate.Completed() == 1);
+
+    // GPU com atraso de 2 sinais
+    NullFence late(2);
+    late.Signal();
+    late.Signal();
+    CHECK(late.Completed() == 0);
+    late.Signal();
+    CHECK(late.Completed() == 1);
+    late.Wait(3);
+    CHECK(late.Completed() == 3);
+    late.Wait(2);
+    CHECK(late.Completed() == 3);
+
+    // at frames - 1 quadros de atraso cabem nos recursos em voo
+    for (uint frames = 1; frames <= 3; ++frames)
+    {
+        for (uint latency = 0; latency < frames; ++latency)
+        {
+            FrameStats stats = Run(frames, latency);
+            CHECK(stats.frames == 100);
+            CHECK(stats.waits == 0);
+        }
+
+        // um quadro a mais de atraso faz a CPU esperar a cada quadro
+        FrameStats stats = Run(frames, frames);
+        CHECK(stats.frames == 100);
+        CHECK(stats.waits >= 100 - frames);
+    }
+
+    // zero quadros em voo equivale a um
+    NullFence fence;
+    FrameSync single(&fence, 0);
+    CHECK(single.Count() == 1);
+
+    if (Bench(argc, argv))
+    {
+        // GPU dois quadros atrs com trs quadros em voo: a CPU nunca espera
+        const uint frames = 1000000;
+        NullFence gpu(2);
+        FrameSync sync(&gpu, 3);
+
+        double time = Measure(5, [&] {
+            for (uint i = 0; i < frames; ++i)
+                sync.EndFrame();
+        });
+
+        printf("frames: %u quadros, %.2f ns por quadro, %u esperas\n", frames, time * 1e6 / frames, sync.Stats().waits);
+    }
+
+    return Report("FramesTest");
+}
+
+// -------------------------------------------------------------------------------
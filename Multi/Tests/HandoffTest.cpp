@@ -0,0 +1,210 @@
+/**********************************************************************************
+// HandoffTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Entrega quadros numerados de uma thread de atualizao para
+//              uma de renderizao pelas duas cpias do FrameHandoff e
+//              confere que cada quadro  lido uma vez, em ordem, sem que a
+//              atualizao escreva na cpia em leitura. Verifica tambm que
+//              Stop acorda uma renderizao parada e que os quadros j
+//              entregues so renderizados antes do encerramento. Com "bench",
+//              compara o intervalo entre quadros com a soma e o maior dos
+//              tempos de atualizao e de renderizao.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Handoff.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// dados de um quadro: o nmero do quadro e uma marca de escrita em andamento
+struct Slot
+{
+    std::atomic<uint> frame { 0 };
+    std::atomic<bool> writing { false };
+};
+
+// espera ativa curta para embaralhar o ritmo das threads
+static void Spin(uint iterations)
+{
+    for (volatile uint i = 0; i < iterations; i = i + 1);
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    const uint Frames = 2000;
+
+    // entrega em ordem: a renderizao l 1, 2, 3... e nunca a cpia em escrita
+    {
+        FrameHandoff handoff;
+        Slot slots[FrameHandoff::Slots];
+        std::atomic<uint> published { 0 };
+        std::atomic<uint> consumed { 0 };
+        std::atomic<uint> maxAhead { 0 };
+        vector<uint> rendered;
+        uint overlaps = 0;
+
+        std::thread render([&] {
+            while (handoff.BeginRender())
+            {
+                Slot & slot = slots[handoff.RenderSlot()];
+                overlaps += slot.writing.load();
+                rendered.push_back(slot.frame.load());
+                Spin(rendered.size() % 3 ? 200 : 5000);
+
+                // a cpia no mudou durante a leitura
+                overlaps += slot.frame.load() != rendered.back();
+                ++consumed;
+                handoff.EndRender();
+            }
+        });
+
+        for (uint f = 1; f <= Frames; ++f)
+        {
+            handoff.BeginUpdate();
+
+            // a cpia a escrever no est com a renderizao
+            // (menos de Slots quadros  frente)
+            uint ahead = published.load() - consumed.load();
+            if (ahead > maxAhead) maxAhead = ahead;
+
+            Slot & slot = slots[handoff.UpdateSlot()];
+            slot.writing = true;
+            slot.frame = f;
+            Spin(f % 5 ? 200 : 5000);
+            slot.writing = false;
+
+            ++published;
+            handoff.EndUpdate();
+        }
+
+        handoff.Stop();
+        render.join();
+
+        CHECK(rendered.size() == Frames);
+        CHECK(overlaps == 0);
+        CHECK(maxAhead < FrameHandoff::Slots);
+
+        bool ordered = true;
+        for (uint i = 0; i < rendered.size(); ++i)
+            ordered = ordered && rendered[i] == i + 1;
+
+        CHECK(ordered);
+        CHECK(handoff.Stats().frames == Frames);
+
+        handoff.ResetStats();
+        CHECK(handoff.Stats().frames == 0);
+    }
+
+    // Stop acorda a renderizao que espera sem quadros entregues
+    {
+        FrameHandoff handoff;
+        std::atomic<int> result { -1 };
+
+        std::thread render([&] { result = handoff.BeginRender(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(result == -1);
+
+        handoff.Stop();
+        render.join();
+        CHECK(result == 0);
+
+        // Start permite renderizar de novo
+        handoff.Start();
+        handoff.BeginUpdate();
+        handoff.EndUpdate();
+        CHECK(handoff.BeginRender());
+        handoff.EndRender();
+    }
+
+    // quadros entregues antes de Stop ainda so renderizados
+    {
+        FrameHandoff handoff;
+
+        for (uint f = 0; f < FrameHandoff::Slots; ++f)
+        {
+            handoff.BeginUpdate();
+            handoff.EndUpdate();
+        }
+
+        handoff.Stop();
+        uint rendered = 0;
+
+        while (handoff.BeginRender())
+        {
+            ++rendered;
+            handoff.EndRender();
+        }
+
+        CHECK(rendered == FrameHandoff::Slots);
+    }
+
+    if (Bench(argc, argv))
+    {
+        // atualizao de 2 ms e renderizao de 3 ms: em paralelo o intervalo
+        // se aproxima de 3 ms em vez dos 5 ms da execuo em srie
+        const uint frames = 200;
+        const auto update = std::chrono::milliseconds(2);
+        const auto draw = std::chrono::milliseconds(3);
+
+        FrameHandoff handoff;
+
+        std::thread render([&] {
+            while (handoff.BeginRender())
+            {
+                std::this_thread::sleep_for(draw);
+                handoff.EndRender();
+            }
+        });
+
+        for (uint f = 0; f < frames; ++f)
+        {
+            handoff.BeginUpdate();
+            std::this_thread::sleep_for(update);
+            handoff.EndUpdate();
+        }
+
+        handoff.Stop();
+        render.join();
+
+        HandoffStats stats = handoff.Stats();
+        printf("handoff: %u quadros\n", stats.frames);
+        printf("  atualizao %.2f ms, renderizao %.2f ms, intervalo %.2f ms, latncia %.2f ms\n",
+               stats.update, stats.render, stats.interval, stats.latency);
+        printf("  esperas: atualizao %.2f ms, renderizao %.2f ms\n", stats.updateWait, stats.renderWait);
+
+        // custo da entrega sem trabalho em nenhum dos lados
+        FrameHandoff empty;
+        const uint handoffs = 100000;
+
+        double time = Measure(3, [&] {
+            empty.Start();
+            std::thread consumer([&] { while (empty.BeginRender()) empty.EndRender(); });
+
+            for (uint f = 0; f < handoffs; ++f)
+            {
+                empty.BeginUpdate();
+                empty.EndUpdate();
+            }
+
+            empty.Stop();
+            consumer.join();
+        });
+
+        printf("  entrega vazia: %.2f us por quadro\n", time * 1e3 / handoffs);
+    }
+
+    return Report("HandoffTest");
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,223 @@
+/**********************************************************************************
+// JobsTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica que ParallelFor visita cada ndice exatamente uma vez,
+//              que tarefas dependentes s comeam depois do contador da
+//              dependncia zerar, que threads ociosas roubam tarefas da fila
+//              da principal e que uma thread registrada tem fila prpria, da
+//              qual a principal no rouba enquanto espera. Com "bench", mede o
+//              custo de agendar e executar uma tarefa vazia e um ParallelFor.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Jobs.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    // cada ndice visitado uma vez, com intervalos dentro dos limites
+    for (uint threads : { 1u, 2u, 4u })
+    {
+        JobSystem jobs(threads);
+        CHECK(jobs.Threads() == threads);
+        CHECK(jobs.Queues() == threads + 1);
+
+        for (uint count : { 0u, 1u, 7u, 64u, 1000u, 4097u })
+        {
+            for (uint grain : { 0u, 1u, 3u, 64u, 5000u })
+            {
+                vector<std::atomic<uint>> visits(count);
+                std::atomic<uint> bad { 0 };
+
+                jobs.ParallelFor(count, grain, [&](uint begin, uint end) {
+                    if (begin >= end || end > count)
+                        ++bad;
+
+                    for (uint i = begin; i < end; ++i)
+                        ++visits[i];
+                });
+
+                bool once = true;
+                for (auto & v : visits)
+                    once = once && v.load() == 1;
+
+                CHECK(once);
+                CHECK(bad == 0);
+            }
+        }
+    }
+
+    // dependncias: cada nvel comea s depois do anterior terminar
+    for (uint threads : { 1u, 2u, 4u })
+    {
+        JobSystem jobs(threads);
+        const uint Levels = 4, Width = 16;
+        JobCounter counters[Levels];
+        std::atomic<uint> done[Levels] = {};
+        std::atomic<uint> early { 0 };
+
+        for (uint l = 0; l < Levels; ++l)
+        {
+            for (uint w = 0; w < Width; ++w)
+            {
+                auto task = [&, l] {
+                    if (l > 0 && done[l - 1].load() != Width)
+                        ++early;
+
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    ++done[l];
+                };
+
+                if (l == 0)
+                    jobs.Run(task, &counters[0]);
+                else
+                    jobs.Run(task, &counters[l], counters[l - 1]);
+            }
+        }
+
+        jobs.Wait(counters[Levels - 1]);
+        CHECK(early == 0);
+
+        for (uint l = 0; l < Levels; ++l)
+        {
+            CHECK(done[l] == Width);
+            CHECK(counters[l].Done());
+        }
+
+        // dependncia j concluda: a tarefa  agendada na hora
+        JobCounter after;
+        bool ran = false;
+        jobs.Run([&] { ran = true; }, &after, counters[0]);
+        jobs.Wait(after);
+        CHECK(ran);
+    }
+
+    // roubo: tarefas que dormem deixam as threads de trabalho
+    // esvaziarem a fila da principal pelo incio
+    {
+        JobSystem jobs(4);
+        JobCounter counter;
+        std::atomic<uint> runs[4] = {};
+
+        for (uint i = 0; i < 64; ++i)
+        {
+            jobs.Run([&] {
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                ++runs[jobs.ThreadIndex()];
+            }, &counter);
+        }
+
+        jobs.Wait(counter);
+
+        uint jobsRun = 0, steals = 0, helpers = 0;
+        for (uint t = 0; t < jobs.Threads(); ++t)
+        {
+            jobsRun += jobs.Stats(t).jobs;
+            steals += jobs.Stats(t).steals;
+            helpers += t > 0 && runs[t] > 0;
+        }
+
+        CHECK(jobsRun == 64);
+        CHECK(runs[0] + runs[1] + runs[2] + runs[3] == 64);
+        CHECK(steals > 0 && helpers > 0);
+        CHECK(jobs.Stats(0).steals == 0);
+
+        jobs.ResetStats();
+        CHECK(jobs.Stats(1).jobs == 0);
+    }
+
+    // thread registrada: fila e estatsticas prprias; enquanto a principal
+    // espera, ela rouba da thread de trabalho mas no da fila da registrada
+    {
+        JobSystem jobs(2);
+        std::atomic<bool> started { false };
+        std::atomic<bool> queued { false };
+        std::atomic<uint> externalRuns { 0 };
+        std::atomic<uint> wrong { 0 };
+        uint externalIndex = 0;
+
+        // a tarefa da principal ocupa a thread de trabalho por 30 ms
+        JobCounter counter;
+        jobs.Run([&] { started = true; std::this_thread::sleep_for(std::chrono::milliseconds(30)); }, &counter);
+
+        while (!started)
+            std::this_thread::yield();
+
+        // a registrada enfileira 50 ms de tarefas e as executa sozinha
+        std::thread external([&] {
+            CHECK(jobs.ThreadIndex() == 0);
+            jobs.Attach(0);
+            externalIndex = jobs.ThreadIndex();
+
+            JobCounter own;
+            for (uint i = 0; i < 50; ++i)
+            {
+                jobs.Run([&] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    wrong += jobs.ThreadIndex() == 0;
+                    ++externalRuns;
+                }, &own);
+            }
+
+            queued = true;
+            jobs.Wait(own);
+        });
+
+        while (!queued)
+            std::this_thread::yield();
+
+        // a principal espera com a prpria fila vazia
+        jobs.Wait(counter);
+        external.join();
+
+        CHECK(externalIndex == 2);
+        CHECK(externalRuns == 50);
+        CHECK(wrong == 0);
+        CHECK(jobs.Stats(0).jobs == 0);
+        CHECK(jobs.Stats(1).jobs + jobs.Stats(2).jobs == 51);
+    }
+
+    if (Bench(argc, argv))
+    {
+        printf("jobs: %u threads de hardware\n", std::thread::hardware_concurrency());
+        const uint tasks = 100000;
+        const uint count = 1 << 20;
+        vector<float> data(count, 1.0f);
+
+        for (uint threads : { 1u, 2u, 4u })
+        {
+            JobSystem jobs(threads);
+
+            double run = Measure(5, [&] {
+                JobCounter counter;
+                for (uint i = 0; i < tasks; ++i)
+                    jobs.Run([] {}, &counter);
+                jobs.Wait(counter);
+            });
+
+            double loop = Measure(5, [&] {
+                jobs.ParallelFor(count, 4096, [&](uint begin, uint end) {
+                    for (uint i = begin; i < end; ++i)
+                        data[i] = data[i] * 0.5f + 1.0f;
+                });
+            });
+
+            printf("  %u threads: tarefa vazia %6.1f ns, ParallelFor de %u elementos %7.3f ms\n",
+                   threads, run * 1e6 / tasks, count, loop);
+        }
+    }
+
+    return Report("JobsTest");
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,314 @@
+/**********************************************************************************
+// OcclusionTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Compara OcclusionBuffer::Occluded com uma rasterizao de
+//              fora bruta com profundidade exata por amostra. Nas amostras
+//              do prprio buffer, um objeto dado como escondido precisa estar
+//              escondido na referncia. Em resoluo 4 vezes maior, apenas
+//              frestas menores que um pixel entre dois oclusores podem revelar
+//              um objeto descartado, e elas precisam ser raras. A frao dos
+//              objetos escondidos que o teste encontra tambm  verificada.
+//              Com "bench", mede a rasterizao dos oclusores e o teste dos
+//              objetos contra o tempo da referncia.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Occlusion.h"
+#include "Culling.h"
+#include "Picking.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+const uint Width = 256;                     // largura do buffer testado
+const uint Height = 128;                    // altura do buffer testado
+const uint Scale = 4;                       // resoluo da referncia em cada eixo
+
+// perspectiva com vetores linha (conveno do Direct3D) olhando ao longo de +z
+static void ViewProj(float * m)
+{
+    float n = 1.0f, f = 500.0f, ys = 1.7320508f, xs = ys * 0.5f;
+    float proj[16] = { xs, 0, 0, 0,  0, ys, 0, 0,  0, 0, f / (f - n), 1,  0, 0, -n * f / (f - n), 0 };
+    std::copy(proj, proj + 16, m);
+}
+
+// os 8 cantos e os 12 tringulos de uma caixa
+static void Corners(const Bounds & b, float (*corners)[3])
+{
+    for (uint i = 0; i < 8; ++i)
+        for (uint k = 0; k < 3; ++k)
+            corners[i][k] = b.center[k] + ((i >> k) & 1 ? b.extents[k] : -b.extents[k]);
+}
+
+static const uint BoxIndices[36] =
+{
+    0, 2, 1,  1, 2, 3,  4, 5, 6,  5, 7, 6,      // -z, +z
+    0, 1, 4,  1, 5, 4,  2, 6, 3,  3, 6, 7,      // -y, +y
+    0, 4, 2,  2, 4, 6,  1, 3, 5,  3, 7, 5       // -x, +x
+};
+
+// -------------------------------------------------------------------------------
+
+// rasterizao escalar com profundidade exata em cada amostra
+class Reference
+{
+private:
+    uint width, height;
+    vector<float> depth;
+    float viewProj[16];
+
+    // vrtice na tela da referncia; false se estiver atrs do plano prximo
+    bool Screen(const float * p, float * s) const
+    {
+        float clip[4];
+
+        for (uint c = 0; c < 4; ++c)
+            clip[c] = p[0] * viewProj[c] + p[1] * viewProj[4 + c] + p[2] * viewProj[8 + c] + viewProj[12 + c];
+
+        if (clip[3] < 1e-5f || clip[2] < 0)
+            return false;
+
+        s[0] = (clip[0] / clip[3] * 0.5f + 0.5f) * width;
+        s[1] = (0.5f - clip[1] / clip[3] * 0.5f) * height;
+        s[2] = clip[2] / clip[3];
+        return true;
+    }
+
+    // visita as amostras cobertas pelo tringulo com sua profundidade
+    template<class Visit>
+    bool Triangle(const float * a, const float * b, const float * c, Visit visit) const
+    {
+        float s[3][3];
+
+        if (!Screen(a, s[0]) || !Screen(b, s[1]) || !Screen(c, s[2]))
+            return false;
+
+        float area = (s[1][0] - s[0][0]) * (s[2][1] - s[0][1]) - (s[2][0] - s[0][0]) * (s[1][1] - s[0][1]);
+
+        if (area == 0)
+            return true;
+
+        int x0 = std::max(0, int(std::min({ s[0][0], s[1][0], s[2][0] })));
+        int x1 = std::min(int(width) - 1, int(std::max({ s[0][0], s[1][0], s[2][0] })));
+        int y0 = std::max(0, int(std::min({ s[0][1], s[1][1], s[2][1] })));
+        int y1 = std::min(int(height) - 1, int(std::max({ s[0][1], s[1][1], s[2][1] })));
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+            {
+                float px = x + 0.5f, py = y + 0.5f, w[3];
+
+                for (uint i = 0; i < 3; ++i)
+                {
+                    const float * p = s[(i + 1) % 3];
+                    const float * q = s[(i + 2) % 3];
+                    w[i] = ((q[0] - p[0]) * (py - p[1]) - (px - p[0]) * (q[1] - p[1])) / area;
+                }
+
+                if (w[0] >= 0 && w[1] >= 0 && w[2] >= 0)
+                    visit(size_t(y) * width + x, w[0] * s[0][2] + w[1] * s[1][2] + w[2] * s[2][2]);
+            }
+
+        return true;
+    }
+
+public:
+    Reference(uint w, uint h, const float * m) : width(w), height(h), depth(size_t(w) * h, 1.0f)
+    {
+        std::copy(m, m + 16, viewProj);
+    }
+
+    void Occluder(const Bounds & box)
+    {
+        float corners[8][3];
+        Corners(box, corners);
+
+        for (uint t = 0; t < 36; t += 3)
+            Triangle(corners[BoxIndices[t]], corners[BoxIndices[t + 1]], corners[BoxIndices[t + 2]],
+                [this](size_t i, float z) { depth[i] = std::min(depth[i], z); });
+    }
+
+    // escondida se nenhuma amostra da caixa fica  frente dos oclusores
+    bool Hidden(const Bounds & box) const
+    {
+        float corners[8][3];
+        Corners(box, corners);
+        bool visible = false;
+
+        for (uint t = 0; t < 36; t += 3)
+        {
+            bool projected = Triangle(corners[BoxIndices[t]], corners[BoxIndices[t + 1]], corners[BoxIndices[t + 2]],
+                [&](size_t i, float z) { visible = visible || z < depth[i]; });
+
+            if (!projected)
+                return false;
+        }
+
+        return !visible;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+static Bounds Box(std::mt19937 & rng, float x, float y, float zMin, float zMax, float sMin, float sMax)
+{
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> size(sMin, sMax);
+    std::uniform_real_distribution<float> depth(zMin, zMax);
+
+    Bounds b;
+    b.center[0] = unit(rng) * x;
+    b.center[1] = unit(rng) * y;
+    b.center[2] = depth(rng);
+
+    for (uint k = 0; k < 3; ++k)
+        b.extents[k] = size(rng);
+
+    b.radius = sqrtf(b.extents[0] * b.extents[0] + b.extents[1] * b.extents[1] + b.extents[2] * b.extents[2]);
+    return b;
+}
+
+// malha de uma caixa unitria na origem, posicionada pela matriz de mundo
+static PickMesh UnitBox()
+{
+    Bounds unit;
+    unit.extents[0] = unit.extents[1] = unit.extents[2] = 1.0f;
+
+    float corners[8][3];
+    Corners(unit, corners);
+    return PickMesh(corners, sizeof(corners[0]), BoxIndices, 36);
+}
+
+static void World(const Bounds & b, float * m)
+{
+    float world[16] = { b.extents[0], 0, 0, 0,  0, b.extents[1], 0, 0,  0, 0, b.extents[2], 0,
+                        b.center[0], b.center[1], b.center[2], 1 };
+    std::copy(world, world + 16, m);
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(9);
+    float viewProj[16];
+    ViewProj(viewProj);
+
+    PickMesh box = UnitBox();
+    OcclusionBuffer buffer(Width, Height);
+    CHECK(buffer.Width() == Width && buffer.Height() == Height);
+
+    uint trulyHidden = 0, found = 0, wrong = 0, cracks = 0;
+
+    for (uint scene = 0; scene < 20; ++scene)
+    {
+        Reference exact(Width, Height, viewProj);
+        Reference fine(Width * Scale, Height * Scale, viewProj);
+        buffer.Begin(viewProj);
+
+        // paredes entre a cmera e os objetos
+        for (uint i = 0; i < 12; ++i)
+        {
+            Bounds wall = Box(rng, 12.0f, 6.0f, 15.0f, 30.0f, 0.5f, 4.0f);
+            float world[16];
+            World(wall, world);
+            buffer.Rasterize(box, world);
+            exact.Occluder(wall);
+            fine.Occluder(wall);
+        }
+
+        buffer.Finish();
+
+        for (uint i = 0; i < 500; ++i)
+        {
+            Bounds object = Box(rng, 30.0f, 15.0f, 35.0f, 80.0f, 0.2f, 1.5f);
+            bool hidden = exact.Hidden(object);
+            bool occluded = buffer.Occluded(object);
+
+            trulyHidden += hidden;
+            found += hidden && occluded;
+            wrong += occluded && !hidden;
+            cracks += occluded && !fine.Hidden(object);
+        }
+
+        buffer.End();
+        CHECK(buffer.Stats().occluders == 12);
+        CHECK(buffer.Stats().triangles == 12 * 12);
+        CHECK(buffer.Stats().occludees == 500);
+    }
+
+    // o teste  conservador: nada visvel nas amostras do buffer  descartado
+    CHECK(wrong == 0);
+    CHECK(cracks * 100 < trulyHidden);
+
+    // e ainda encontra a maior parte do que est escondido
+    CHECK(trulyHidden > 500);
+    CHECK(found * 2 > trulyHidden);
+    printf("occlusion: %u de %u objetos escondidos encontrados, %u vistos s por frestas\n", found, trulyHidden, cracks);
+
+    // objetos que cruzam o plano prximo nunca so descartados
+    Bounds near;
+    near.extents[0] = near.extents[1] = near.extents[2] = 1.0f;
+    CHECK(!buffer.Occluded(near));
+
+    if (Bench(argc, argv))
+    {
+        const uint occluders = 64, objects = 10000;
+        vector<Bounds> walls, scene;
+
+        for (uint i = 0; i < occluders; ++i)
+            walls.push_back(Box(rng, 12.0f, 6.0f, 15.0f, 30.0f, 0.5f, 4.0f));
+
+        for (uint i = 0; i < objects; ++i)
+            scene.push_back(Box(rng, 30.0f, 15.0f, 35.0f, 80.0f, 0.2f, 1.5f));
+
+        double raster = Measure(20, [&] {
+            buffer.Begin(viewProj);
+
+            for (const Bounds & wall : walls)
+            {
+                float world[16];
+                World(wall, world);
+                buffer.Rasterize(box, world);
+            }
+
+            buffer.Finish();
+        });
+
+        uint hidden = 0;
+        double test = Measure(20, [&] {
+            hidden = 0;
+
+            for (const Bounds & object : scene)
+                hidden += buffer.Occluded(object);
+        });
+
+        double brute = Measure(1, [&] {
+            Reference reference(Width * Scale, Height * Scale, viewProj);
+
+            for (const Bounds & wall : walls)
+                reference.Occluder(wall);
+
+            for (uint i = 0; i < objects / 10; ++i)
+                reference.Hidden(scene[i]);
+        });
+
+        printf("occlusion: %u oclusores, %u objetos, %u escondidos\n", occluders, objects, hidden);
+        printf("  rasterizao     %8.3f ms\n", raster);
+        printf("  teste dos objetos %7.3f ms (%.1f ns por objeto)\n", test, test * 1e6 / objects);
+        printf("  fora bruta      %8.3f ms (%u objetos, resoluo %ux)\n", brute, objects / 10, Scale);
+    }
+
+    return Report("OcclusionTest");
+}
+
+// -------------------------------------------------------------------------------
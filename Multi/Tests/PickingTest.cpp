@@ -0,0 +1,219 @@
+/**********************************************************************************
+// PickingTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Compara a interseo de raios com PickMesh com um teste de
+//              Mller-Trumbore escalar aplicado a todos os tringulos da
+//              malha. Com "bench", mede o tempo de uma seleo em malhas de
+//              at 100 mil tringulos e verifica que ele cabe com folga em um
+//              quadro.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Picking.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// vrtice com posio e cor, como os da aplicao
+struct Vertex
+{
+    float pos[3];
+    float color[4];
+};
+
+struct Mesh
+{
+    vector<Vertex> vertices;
+    vector<uint> indices;
+};
+
+// esfera de raio 1 com slices fatias e stacks pilhas, deformada por rudo
+static Mesh Sphere(uint slices, uint stacks, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+    Mesh mesh;
+
+    for (uint i = 0; i <= stacks; ++i)
+    {
+        float phi = 3.14159265f * i / stacks;
+
+        for (uint j = 0; j <= slices; ++j)
+        {
+            float theta = 6.28318531f * j / slices;
+            float r = (i == 0 || i == stacks) ? 1.0f : noise(rng);
+            mesh.vertices.push_back(Vertex { { r * sinf(phi) * cosf(theta), r * cosf(phi), r * sinf(phi) * sinf(theta) }, { 1, 1, 1, 1 } });
+        }
+    }
+
+    for (uint i = 0; i < stacks; ++i)
+        for (uint j = 0; j < slices; ++j)
+        {
+            uint a = i * (slices + 1) + j, b = a + slices + 1;
+            uint quad[6] = { a, b, a + 1, a + 1, b, b + 1 };
+            mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+        }
+
+    return mesh;
+}
+
+// -------------------------------------------------------------------------------
+
+// Mller-Trumbore escalar sobre todos os tringulos, sem descartar faces de trs
+static bool Reference(const Mesh & mesh, const Ray & ray, float maxT, float & t, uint & triangle)
+{
+    bool found = false;
+    t = maxT;
+
+    for (uint k = 0; k < mesh.indices.size() / 3; ++k)
+    {
+        const float * v0 = mesh.vertices[mesh.indices[k * 3]].pos;
+        const float * v1 = mesh.vertices[mesh.indices[k * 3 + 1]].pos;
+        const float * v2 = mesh.vertices[mesh.indices[k * 3 + 2]].pos;
+        const float * d = ray.direction;
+
+        float e1[3] = { v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2] };
+        float e2[3] = { v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+        float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+        float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+        if (det * det <= 1e-20f)
+            continue;
+
+        float inv = 1.0f / det;
+        float s[3] = { ray.origin[0] - v0[0], ray.origin[1] - v0[1], ray.origin[2] - v0[2] };
+        float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv;
+
+        if (u < 0 || u > 1)
+            continue;
+
+        float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+        float v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inv;
+        float dist = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv;
+
+        if (v < 0 || u + v > 1 || dist < 0 || dist >= t)
+            continue;
+
+        t = dist;
+        triangle = k;
+        found = true;
+    }
+
+    return found;
+}
+
+// -------------------------------------------------------------------------------
+
+// raio que parte de fora da esfera na direo de um ponto prximo dela
+static Ray RandomRay(std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    Ray ray;
+
+    for (uint k = 0; k < 3; ++k)
+        ray.origin[k] = value(rng) * 4.0f;
+
+    ray.origin[2] += ray.origin[2] < 0 ? -2.0f : 2.0f;
+
+    for (uint k = 0; k < 3; ++k)
+        ray.direction[k] = value(rng) * 1.6f - ray.origin[k];
+
+    return ray;
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(5);
+
+    // tringulos que no completam o ltimo bloco de 8
+    Mesh mesh = Sphere(37, 19, rng);
+    PickMesh pick(mesh.vertices.data(), sizeof(Vertex), mesh.indices.data(), uint(mesh.indices.size()));
+    CHECK(pick.Triangles() == mesh.indices.size() / 3);
+    CHECK(pick.Blocks().size() == (pick.Triangles() + PickMesh::Width - 1) / PickMesh::Width);
+
+    uint hits = 0, misses = 0, wrongHit = 0, wrongT = 0;
+
+    for (uint r = 0; r < 5000; ++r)
+    {
+        Ray ray = RandomRay(rng);
+        float t, expectedT;
+        uint triangle, expected;
+
+        bool found = pick.Intersect(ray, t, triangle);
+        bool reference = Reference(mesh, ray, 3.4e38f, expectedT, expected);
+
+        found ? ++hits : ++misses;
+
+        if (found != reference)
+            ++wrongHit;
+
+        // tringulos vizinhos podem empatar na aresta comum: vale a distncia
+        else if (found && fabsf(t - expectedT) > 1e-4f * expectedT)
+            ++wrongT;
+
+        // o limite exclui acertos a partir de maxT
+        if (found)
+        {
+            float limited;
+            CHECK(!pick.Intersect(ray, limited, triangle, t * 0.999f));
+            CHECK(pick.Intersect(ray, limited, triangle, t * 1.001f));
+        }
+    }
+
+    CHECK(hits > 1000 && misses > 1000);
+    CHECK(wrongHit == 0);
+    CHECK(wrongT == 0);
+
+    // raio que nasce dentro da malha acerta a parede por dentro
+    Ray inside = { { 0, 0, 0 }, { 0.3f, 0.2f, 1.0f } };
+    float t, expectedT;
+    uint triangle, expected;
+    CHECK(pick.Intersect(inside, t, triangle));
+    CHECK(Reference(mesh, inside, 3.4e38f, expectedT, expected) && fabsf(t - expectedT) < 1e-4f);
+
+    if (Bench(argc, argv))
+    {
+        printf("picking: tempo mdio por raio\n");
+
+        for (uint slices : { 32u, 100u, 316u })
+        {
+            Mesh big = Sphere(slices, slices / 2, rng);
+            PickMesh bigPick(big.vertices.data(), sizeof(Vertex), big.indices.data(), uint(big.indices.size()));
+
+            vector<Ray> rays;
+
+            for (uint r = 0; r < 1000; ++r)
+                rays.push_back(RandomRay(rng));
+
+            double picked = Measure(5, [&] {
+                for (const Ray & ray : rays)
+                    bigPick.Intersect(ray, t, triangle);
+            }) / rays.size();
+
+            double brute = Measure(1, [&] {
+                for (uint r = 0; r < 20; ++r)
+                    Reference(big, rays[r], 3.4e38f, t, triangle);
+            }) / 20;
+
+            printf("  %6u tringulos: PickMesh %8.4f ms, fora bruta escalar %8.4f ms\n",
+                   bigPick.Triangles(), picked, brute);
+
+            // a seleo acontece no quadro do clique: deve caber com folga em 16 ms
+            CHECK(picked < 1.0);
+        }
+    }
+
+    return Report("PickingTest");
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,135 @@
+/**********************************************************************************
+// RecorderTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Grava segmentos em paralelo, com durao variada para que
+//              terminem fora de ordem, e confere que Submit os entrega ao
+//              backend na ordem dos ndices. S o primeiro segmento define os
+//              estados, ento o NullBackend acusa erro se outro segmento
+//              chegar antes dele. Com "bench", mede a gravao de 4 segmentos
+//              com 1, 2 e 4 threads.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Recorder.h"
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// backend que anota o segmento de cada fluxo recebido (constantes do primeiro comando)
+class OrderBackend : public CommandBackend
+{
+public:
+    vector<ullong> order;
+
+    void Execute(const CommandStream & stream)
+    {
+        order.push_back(stream.Size() ? stream.Data()[0].handle : 0);
+    }
+};
+
+// segmento com o ndice no primeiro comando; o segmento 0 define os estados
+static void Record(uint segment, CommandStream & stream, uint draws)
+{
+    stream.Constants(1, 0x100 + segment);
+
+    if (segment == 0)
+    {
+        stream.Pipeline(1);
+        stream.RootSignature(2);
+        stream.Topology(4);
+        stream.Viewport(0, 0, 640, 360);
+        stream.Table(0, 0x200);
+        stream.VertexBuffer(0x1000, 4096, 28);
+        stream.IndexBuffer(0x2000, 4096, 4);
+    }
+
+    // segmentos pares demoram mais para terminar
+    uint work = segment % 2 ? draws : draws * 20;
+
+    for (uint i = 0; i < work; ++i)
+    {
+        stream.Table(0, 0x200 + i * 32ull);
+        stream.Draw(36);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    for (uint threads : { 1u, 2u, 4u })
+    {
+        JobSystem jobs(threads);
+        ParallelRecorder recorder(&jobs);
+        CHECK(recorder.Threads() == threads);
+
+        for (uint segments : { 16u, 5u, 1u })
+        {
+            recorder.Record(segments, [](uint segment, CommandStream & stream) { Record(segment, stream, 50); });
+
+            RecordStats stats = recorder.Stats();
+            CHECK(recorder.Segments() == segments);
+            CHECK(stats.segments == segments);
+            CHECK(stats.threads >= 1 && stats.threads <= threads);
+
+            uint commands = 0;
+
+            for (uint s = 0; s < segments; ++s)
+            {
+                CHECK(recorder.Segment(s).Data()[0].handle == 0x100 + s);
+                commands += recorder.Segment(s).Size();
+            }
+
+            CHECK(stats.commands == commands);
+
+            // ordem dos ndices, no a de concluso; segmentos de gravaes
+            // anteriores maiores no so submetidos
+            OrderBackend order;
+            recorder.Submit(order);
+            CHECK(order.order.size() == segments);
+
+            for (uint s = 0; s < order.order.size(); ++s)
+                CHECK(order.order[s] == 0x100 + s);
+
+            // os estados do segmento 0 valem para os seguintes
+            NullBackend backend;
+            recorder.Submit(backend);
+            CHECK(backend.Stats().errors == 0);
+            CHECK(backend.Stats().commands == commands);
+        }
+    }
+
+    if (Bench(argc, argv))
+    {
+        printf("recorder: 4 segmentos, %u threads de hardware\n", std::thread::hardware_concurrency());
+
+        for (uint threads : { 1u, 2u, 4u })
+        {
+            JobSystem jobs(threads);
+            ParallelRecorder recorder(&jobs);
+
+            double time = Measure(20, [&] {
+                recorder.Record(4, [](uint segment, CommandStream & stream) { Record(segment, stream, 5000); });
+            });
+
+            NullBackend backend;
+            double submit = Measure(20, [&] {
+                backend.Reset();
+                recorder.Submit(backend);
+            });
+
+            printf("  %u threads: gravao %7.3f ms (%u threads usadas), submisso %7.3f ms, %u comandos\n",
+                   threads, time, recorder.Stats().threads, submit, recorder.Stats().commands);
+        }
+    }
+
+    return Report("RecorderTest");
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+/**********************************************************************************
+// RenderQueueTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Compara o radix sort da fila de desenho com std::stable_sort,
+//              confere os campos guardados nas chaves e conta os comandos de
+//              estado emitidos e evitados em uma fila pequena conhecida. Com
+//              "bench", mede a ordenao de 10 mil e 100 mil desenhos contra
+//              std::sort e std::stable_sort.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// ordem esperada: chaves crescentes, empates na ordem de insero
+static vector<DrawItem> Expected(const vector<DrawItem> & items)
+{
+    vector<DrawItem> sorted(items);
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const DrawItem & a, const DrawItem & b) { return a.key < b.key; });
+    return sorted;
+}
+
+static bool Same(const vector<DrawItem> & a, const vector<DrawItem> & b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (uint i = 0; i < a.size(); ++i)
+        if (a[i].key != b[i].key || a[i].index != b[i].index)
+            return false;
+
+    return true;
+}
+
+// fila aleatria com poucas vistas, pipelines e malhas para forar empates
+static void Fill(RenderQueue & queue, vector<DrawItem> & pushed, uint count, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> depth(-0.1f, 1.1f);
+
+    queue.Clear();
+    pushed.clear();
+
+    for (uint i = 0; i < count; ++i)
+    {
+        ullong key = RenderQueue::Key(rng() % 4, rng() % 3, rng() % 50, float(int(depth(rng) * 64)) / 64);
+        queue.Push(key, i);
+        pushed.push_back(DrawItem { key, i });
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(13);
+    RenderQueue queue;
+    vector<DrawItem> pushed;
+
+    // campos da chave
+    ullong key = RenderQueue::Key(9, 4000, 1234567, 0.5f);
+    CHECK(RenderQueue::View(key) == 9);
+    CHECK(RenderQueue::Pipeline(key) == 4000);
+    CHECK(RenderQueue::Mesh(key) == 1234567);
+    CHECK(RenderQueue::Key(0, 0, 0, -1.0f) == RenderQueue::Key(0, 0, 0, 0.0f));
+    CHECK(RenderQueue::Key(0, 0, 0, 2.0f) == RenderQueue::Key(0, 0, 0, 1.0f));
+    CHECK(RenderQueue::Key(0, 0, 0, 0.25f) < RenderQueue::Key(0, 0, 0, 0.75f));
+    CHECK(RenderQueue::Key(0, 0, 1, 0.9f) < RenderQueue::Key(0, 1, 0, 0.1f));
+    CHECK(RenderQueue::Key(0, 1, 0, 0.9f) < RenderQueue::Key(1, 0, 0, 0.1f));
+
+    // mesma ordem de std::stable_sort, inclusive entre chaves iguais
+    for (uint round = 0; round < 20; ++round)
+    {
+        Fill(queue, pushed, rng() % 5000, rng);
+        queue.Sort();
+        CHECK(Same(queue.Items(), Expected(pushed)));
+        CHECK(queue.Stats().draws == pushed.size());
+    }
+
+    // filas vazias, com um desenho ou com todas as chaves iguais
+    for (uint count : { 0u, 1u, 300u })
+    {
+        queue.Clear();
+        pushed.clear();
+
+        for (uint i = 0; i < count; ++i)
+        {
+            queue.Push(RenderQueue::Key(2, 1, 7, 0.5f), i);
+            pushed.push_back(DrawItem { RenderQueue::Key(2, 1, 7, 0.5f), i });
+        }
+
+        queue.Sort();
+        CHECK(Same(queue.Items(), pushed));
+        CHECK(queue.Stats().passes == 0);
+    }
+
+    // 8 desenhos em 2 vistas e 2 malhas, 3 estados por desenho: 24 consultas,
+    // das quais s as trocas de vista (2), de malha (4) e a topologia (1) emitem
+    queue.Clear();
+
+    for (uint i = 0; i < 8; ++i)
+        queue.Push(RenderQueue::Key(i % 2, 0, (i / 2) % 2, 0.1f * i), i);
+
+    queue.Sort();
+    uint emitted = 0;
+
+    for (const DrawItem & item : queue.Items())
+    {
+        emitted += queue.Change(STATE_TOPOLOGY, 4);
+        emitted += queue.Change(STATE_VIEWPORT, RenderQueue::View(item.key));
+        emitted += queue.Change(STATE_VERTEXBUFFER, 0x1000 + RenderQueue::Mesh(item.key));
+    }
+
+    CHECK(emitted == 7);
+    CHECK(queue.Stats().changes == 7);
+    CHECK(queue.Stats().avoided == 17);
+
+    // estados definidos fora da fila contam como conhecidos; Clear os esquece
+    queue.Set(STATE_PIPELINE, 1);
+    CHECK(!queue.Change(STATE_PIPELINE, 1));
+    CHECK(queue.Change(STATE_PIPELINE, 2));
+    queue.Clear();
+    CHECK(queue.Change(STATE_PIPELINE, 2));
+    CHECK(queue.Items().empty());
+
+    if (Bench(argc, argv))
+    {
+        printf("render queue: ordenao\n");
+
+        for (uint count : { 10000u, 100000u })
+        {
+            Fill(queue, pushed, count, rng);
+            auto less = [](const DrawItem & a, const DrawItem & b) { return a.key < b.key; };
+            double radix = 1e30, sort = 1e30, stable = 1e30;
+
+            // cada medida ordena uma cpia da fila original
+            for (uint repeat = 0; repeat < 20; ++repeat)
+            {
+                queue.Clear();
+
+                for (const DrawItem & item : pushed)
+                    queue.Push(item.key, item.index);
+
+                queue.Sort();
+                radix = std::min(radix, queue.Stats().sortTime);
+
+                vector<DrawItem> copy(pushed);
+                sort = std::min(sort, Measure(1, [&] { std::sort(copy.begin(), copy.end(), less); }));
+
+                copy = pushed;
+                stable = std::min(stable, Measure(1, [&] { std::stable_sort(copy.begin(), copy.end(), less); }));
+            }
+
+            printf("  %6u desenhos: radix %6.3f ms (%u passadas), std::sort %6.3f ms, std::stable_sort %6.3f ms\n",
+                   count, radix, queue.Stats().passes, sort, stable);
+        }
+    }
+
+    return Report("RenderQueueTest");
+}
+
+// -------------------------------------------------------------------------------
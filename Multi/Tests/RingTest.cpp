@@ -0,0 +1,244 @@
+/**********************************************************************************
+// RingTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica o UploadRing: o alinhamento e o descarte do final do
+//              buffer entram na ocupao, os trechos s so reciclados quando
+//              a cerca associada  atingida e uma sequncia de uploads com a
+//              GPU simulada atrasada nunca sobrescreve um trecho em uso. Com
+//              "bench", mede o custo de uma alocao com reciclagem por cerca.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "Ring.h"
+#include "Frames.h"
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    const ullong Invalid = UploadRing::Invalid;
+
+    // alinhamento: o preenchimento antes do trecho conta como ocupado
+    {
+        UploadRing ring(1024);
+        CHECK(ring.Allocate(3) == 0);
+        CHECK(ring.Allocate(8, 256) == 256);
+        CHECK(ring.Allocate(4) == 264);
+
+        RingStats stats = ring.Stats();
+        CHECK(stats.used == 268);
+        CHECK(stats.peak == 268);
+        CHECK(stats.allocations == 3);
+        CHECK(stats.capacity == 1024);
+
+        // pedidos vazios ou maiores que o buffer no so atendidos
+        CHECK(ring.Allocate(0) == Invalid);
+        CHECK(ring.Allocate(1025) == Invalid);
+        CHECK(ring.Stats().allocations == 3);
+    }
+
+    // reciclagem por cerca e volta ao incio do buffer
+    {
+        UploadRing ring(1024);
+        CHECK(!ring.Pending());
+
+        CHECK(ring.Allocate(400) == 0);
+        ring.Close(1);
+        CHECK(ring.Allocate(400) == 400);
+        ring.Close(2);
+        CHECK(ring.Pending());
+        CHECK(ring.OldestFence() == 1);
+
+        // sem alocaes abertas, Close no cria trecho
+        ring.Close(3);
+        ring.Retire(2);
+        CHECK(!ring.Pending());
+        CHECK(ring.Stats().used == 0);
+
+        // buffer vazio recomea do incio
+        CHECK(ring.Allocate(400) == 0);
+        ring.Close(4);
+        CHECK(ring.Allocate(400) == 400);
+        ring.Close(5);
+
+        // no cabe no final nem antes do trecho mais antigo
+        CHECK(ring.Allocate(400) == Invalid);
+
+        // cerca anterior  do trecho no libera nada
+        ring.Retire(3);
+        CHECK(ring.Stats().used == 800);
+        CHECK(ring.Allocate(400) == Invalid);
+
+        // o final descartado (224 bytes) entra na ocupao
+        ring.Retire(4);
+        CHECK(ring.OldestFence() == 5);
+        CHECK(ring.Allocate(400) == 0);
+        CHECK(ring.Stats().used == 1024);
+        CHECK(ring.Stats().Occupancy() == 1.0f);
+
+        // cheio: head alcanou tail
+        CHECK(ring.Allocate(1) == Invalid);
+        ring.Close(6);
+
+        // entre head e tail depois de liberar o trecho do meio
+        ring.Retire(5);
+        CHECK(ring.Stats().used == 624);
+        CHECK(ring.Allocate(100) == 400);
+        CHECK(ring.Allocate(301) == Invalid);
+        CHECK(ring.Allocate(300) == 500);
+        ring.Close(7);
+
+        ring.Retire(7);
+        CHECK(!ring.Pending());
+        CHECK(ring.Stats().used == 0);
+        CHECK(ring.Stats().peak == 1024);
+    }
+
+    // uploads em lotes com a GPU 3 cercas atrs: cada byte entregue
+    // pertence a um nico lote ainda no concludo pela GPU
+    {
+        const ullong Capacity = 64 * 1024;
+        UploadRing ring(Capacity);
+        NullFence fence(3);
+        vector<ullong> owner(Capacity, 0);
+        std::mt19937 rng(28);
+
+        ullong batch = fence.Signal() + 1;
+        bool open = false;
+        bool consistent = true;
+        uint overflows = 0;
+
+        // libera os bytes dos lotes j concludos pela GPU
+        auto retire = [&] {
+            ring.Retire(fence.Completed());
+            for (ullong & o : owner)
+                if (o != 0 && o <= fence.Completed())
+                    o = 0;
+        };
+
+        for (uint step = 0; step < 4000; ++step)
+        {
+            retire();
+
+            ullong size = rng() % 8 == 0 ? 8192 + rng() % 16384 : 1 + rng() % 2048;
+            ullong alignment = ullong(4) << (rng() % 7);
+            if (step % 500 == 0)
+                size = Capacity + 1;
+
+            ullong offset = ring.Allocate(size, alignment);
+
+            // mesmo lao de Graphics::Upload
+            while (offset == Invalid)
+            {
+                if (ring.Pending())
+                {
+                    ring.Stall();
+                    fence.Wait(ring.OldestFence());
+                    retire();
+                }
+                else if (open)
+                {
+                    ring.Close(batch);
+                    batch = fence.Signal() + 1;
+                    open = false;
+                }
+                else
+                {
+                    break;
+                }
+
+                offset = ring.Allocate(size, alignment);
+            }
+
+            if (offset == Invalid)
+            {
+                ring.Overflow();
+                ++overflows;
+                continue;
+            }
+
+            consistent = consistent && offset % alignment == 0 && offset + size <= Capacity;
+            for (ullong i = offset; i < offset + size && i < Capacity; ++i)
+            {
+                consistent = consistent && owner[i] == 0;
+                owner[i] = batch;
+            }
+
+            open = true;
+
+            // lote enviado  GPU a cada poucos uploads
+            if (rng() % 4 == 0)
+            {
+                ring.Close(batch);
+                batch = fence.Signal() + 1;
+                open = false;
+            }
+        }
+
+        RingStats stats = ring.Stats();
+        CHECK(consistent);
+        CHECK(stats.stalls > 0);
+        CHECK(stats.overflows == overflows && overflows == 8);
+        CHECK(stats.peak <= Capacity);
+
+        // os bytes entregues e no reciclados cabem na ocupao registrada,
+        // que inclui tambm o preenchimento
+        ullong live = 0;
+        for (ullong o : owner)
+            live += o != 0;
+        CHECK(live <= stats.used);
+
+        ring.Close(batch);
+        fence.Wait(batch);
+        ring.Retire(fence.Completed());
+        CHECK(ring.Stats().used == 0);
+    }
+
+    if (Bench(argc, argv))
+    {
+        // constantes de 256 bytes em um buffer de 4 MB, lote a cada 64
+        const uint uploads = 1000000;
+        UploadRing ring(4 << 20);
+        NullFence fence(2);
+        ullong batch = fence.Signal() + 1;
+
+        double time = Measure(3, [&] {
+            for (uint i = 0; i < uploads; ++i)
+            {
+                ring.Retire(fence.Completed());
+                ullong offset = ring.Allocate(256, 256);
+
+                while (offset == Invalid)
+                {
+                    ring.Stall();
+                    fence.Wait(ring.OldestFence());
+                    ring.Retire(fence.Completed());
+                    offset = ring.Allocate(256, 256);
+                }
+
+                if (i % 64 == 63)
+                {
+                    ring.Close(batch);
+                    batch = fence.Signal() + 1;
+                }
+            }
+        });
+
+        RingStats stats = ring.Stats();
+        printf("ring: %u uploads de 256 bytes em %llu KB\n", uploads, stats.capacity / 1024);
+        printf("  alocao %6.1f ns, pico %.0f%%, esperas %u\n",
+               time * 1e6 / uploads, 100.0 * double(stats.peak) / double(stats.capacity), stats.stalls);
+    }
+
+    return Report("RingTest");
+}
+
+// -------------------------------------------------------------------------------
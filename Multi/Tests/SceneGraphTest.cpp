@@ -0,0 +1,232 @@
+/**********************************************************************************
+// SceneGraphTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica a propagao das matrizes de mundo do SceneGraph: s
+//              as subrvores dos ns alterados, inseridos ou trocados de pai
+//              so recalculadas, a troca de pai e a remoo mantm os ns no
+//              mesmo lugar do mundo e ciclos so recusados. Com "bench", mede
+//              a troca de pai de 10 mil filhos e a atualizao que a segue.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "SceneGraph.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// transformao com translao e escala uniforme
+static Trs Make(float x, float y, float z, float s = 1.0f)
+{
+    Trs t;
+    t.translation[0] = x;
+    t.translation[1] = y;
+    t.translation[2] = z;
+    t.scale[0] = t.scale[1] = t.scale[2] = s;
+    return t;
+}
+
+// matrizes iguais a menos de erro de arredondamento
+static bool Near(const float * a, const float * b)
+{
+    for (uint i = 0; i < 16; ++i)
+    {
+        if (fabsf(a[i] - b[i]) > 1e-4f)
+            return false;
+    }
+
+    return true;
+}
+
+// posio de mundo do n
+static bool At(const SceneGraph & graph, uint id, float x, float y, float z)
+{
+    const float * m = graph.World(id);
+    return fabsf(m[12] - x) < 1e-4f && fabsf(m[13] - y) < 1e-4f && fabsf(m[14] - z) < 1e-4f;
+}
+
+// n presente na lista de recalculados
+static bool Changed(const SceneGraph & graph, uint id)
+{
+    const vector<uint> & list = graph.Changed();
+    return std::find(list.begin(), list.end(), id) != list.end();
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    // propagao: mundo = local x pai, apenas nas subrvores sujas
+    {
+        SceneGraph graph;
+        uint root = graph.Add(Make(10, 0, 0, 2));
+        uint a = graph.Add(Make(1, 0, 0), root);
+        uint b = graph.Add(Make(0, 1, 0), a);
+        uint c = graph.Add(Make(0, 0, 1), root);
+        uint other = graph.Add(Make(-5, 0, 0));
+
+        CHECK(graph.Update());
+        CHECK(graph.Stats().updated == 5);
+        CHECK(graph.Stats().nodes == 5);
+        CHECK(At(graph, a, 12, 0, 0));
+        CHECK(At(graph, b, 12, 2, 0));
+        CHECK(At(graph, c, 10, 0, 2));
+        CHECK(At(graph, other, -5, 0, 0));
+
+        // nada alterado: nada recalculado
+        CHECK(!graph.Update());
+        CHECK(graph.Stats().updated == 0);
+        CHECK(graph.Changed().empty());
+
+        // um n interno recalcula s ele e seus descendentes
+        graph.SetLocal(a, Make(3, 0, 0));
+        CHECK(graph.Update());
+        CHECK(graph.Stats().updated == 2);
+        CHECK(Changed(graph, a) && Changed(graph, b));
+        CHECK(!Changed(graph, root) && !Changed(graph, c) && !Changed(graph, other));
+        CHECK(At(graph, b, 16, 2, 0));
+
+        // pai e filho sujos: a subrvore do pai cobre o filho uma vez s
+        graph.SetLocal(b, Make(0, 2, 0));
+        graph.SetLocal(root, Make(0, 0, 0));
+        graph.SetLocal(b, Make(0, 3, 0));
+        CHECK(graph.Update());
+        CHECK(graph.Stats().updated == 4);
+        CHECK(graph.Changed().size() == 4);
+        CHECK(At(graph, b, 3, 3, 0));
+        CHECK(At(graph, other, -5, 0, 0));
+
+        // inserir reordena a hierarquia, mas s o novo n  calculado
+        uint rebuilds = graph.Stats().rebuilds;
+        uint d = graph.Add(Make(0, 0, 5), b);
+        CHECK(graph.Update());
+        CHECK(graph.Stats().rebuilds == rebuilds + 1);
+        CHECK(graph.Stats().updated == 1);
+        CHECK(At(graph, d, 3, 3, 5));
+
+        // as matrizes dos demais seguem os ns para as novas posies
+        CHECK(At(graph, a, 3, 0, 0));
+        CHECK(At(graph, c, 0, 0, 1));
+        CHECK(At(graph, other, -5, 0, 0));
+    }
+
+    // troca de pai e remoo mantm a posio no mundo
+    {
+        SceneGraph graph;
+        Trs spun = Make(4, 0, 0, 2);
+        float axis[3] = { 0, 1, 0 };
+        spun.Rotate(axis, 0.7f);
+
+        uint p = graph.Add(spun);
+        uint q = graph.Add(Make(0, 5, 0, 0.5f));
+        uint child = graph.Add(Make(1, 2, 3), p);
+        uint grandchild = graph.Add(Make(0, 1, 0), child);
+        graph.Update();
+
+        float before[16], after[16];
+        std::copy(graph.World(grandchild), graph.World(grandchild) + 16, before);
+
+        CHECK(graph.SetParent(child, q));
+        CHECK(graph.Parent(child) == q);
+        CHECK(graph.Update());
+
+        // o filho e o neto so recalculados; p e q no
+        CHECK(graph.Stats().updated == 2);
+        CHECK(!Changed(graph, p) && !Changed(graph, q));
+        std::copy(graph.World(grandchild), graph.World(grandchild) + 16, after);
+        CHECK(Near(before, after));
+
+        // ciclos e pais invlidos so recusados
+        CHECK(!graph.SetParent(q, grandchild));
+        CHECK(!graph.SetParent(child, child));
+        CHECK(!graph.SetParent(child, q));
+        CHECK(!graph.SetParent(child, 999));
+
+        // removido o pai, o neto passa ao av sem sair do lugar
+        graph.Remove(child);
+        CHECK(!graph.Valid(child));
+        CHECK(graph.Parent(grandchild) == q);
+        graph.Update();
+        CHECK(Near(before, graph.World(grandchild)));
+
+        // o identificador removido  reaproveitado
+        CHECK(graph.Add(Make(0, 0, 0)) == child);
+        CHECK(graph.Stats().nodes == 4);
+
+        graph.Clear();
+        CHECK(graph.Stats().nodes == 0);
+        CHECK(!graph.Valid(p));
+    }
+
+    // troca de pai de muitos filhos: s as subrvores movidas so recalculadas
+    {
+        const uint Children = 10000;
+        SceneGraph graph;
+        uint from = graph.Add(Make(1, 0, 0));
+        uint to = graph.Add(Make(0, 1, 0));
+        uint still = graph.Add(Make(0, 0, 1));
+        vector<uint> nodes;
+
+        for (uint i = 0; i < Children; ++i)
+            nodes.push_back(graph.Add(Make(float(i), 0, 0), from));
+
+        for (uint i = 0; i < Children / 10; ++i)
+            graph.Add(Make(0, 0, 0), still);
+
+        graph.Update();
+
+        for (uint i = 0; i < Children; i += 2)
+            graph.SetParent(nodes[i], to);
+
+        graph.Update();
+        CHECK(graph.Stats().updated == Children / 2);
+
+        bool placed = true;
+        for (uint i = 0; i < Children; ++i)
+            placed = placed && At(graph, nodes[i], float(i + 1), 0, 0);
+
+        CHECK(placed);
+    }
+
+    if (Bench(argc, argv))
+    {
+        // 10 mil filhos trocam de pai entre duas razes, ida e volta
+        const uint Children = 10000;
+        SceneGraph graph;
+        uint roots[2] = { graph.Add(Make(1, 0, 0)), graph.Add(Make(0, 1, 0)) };
+        vector<uint> nodes;
+
+        for (uint i = 0; i < Children; ++i)
+            nodes.push_back(graph.Add(Make(float(i), 0, 0), roots[0]));
+
+        graph.Update();
+        double reparent = 1e30, update = 1e30;
+
+        for (uint r = 0; r < 6; ++r)
+        {
+            uint target = roots[(r + 1) % 2];
+
+            reparent = std::min(reparent, Measure(1, [&] {
+                for (uint id : nodes)
+                    graph.SetParent(id, target);
+            }));
+
+            update = std::min(update, Measure(1, [&] { graph.Update(); }));
+        }
+
+        printf("scene graph: %u filhos trocados de pai\n", Children);
+        printf("  SetParent %7.3f ms (%.0f ns por filho), Update %7.3f ms\n",
+               reparent, reparent * 1e6 / Children, update);
+    }
+
+    return Report("SceneGraphTest");
+}
+
+// -------------------------------------------------------------------------------
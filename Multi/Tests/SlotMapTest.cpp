@@ -0,0 +1,179 @@
+/**********************************************************************************
+// SlotMapTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica o SlotMap: remover um objeto incrementa a gerao da
+//              entrada, de modo que os handles antigos so recusados mesmo
+//              depois que a entrada  reaproveitada, e o ltimo objeto ocupa
+//              o lugar do removido sem mudar o handle dele. Com "bench", mede
+//              insero, remoo, consulta por handle e percurso denso.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "SlotMap.h"
+#include <random>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    const uint None = SlotMap<int>::None;
+
+    // handles obsoletos depois da remoo e do reaproveitamento da entrada
+    {
+        SlotMap<int> map;
+        Handle a = map.Insert(10);
+        Handle b = map.Insert(20);
+        Handle c = map.Insert(30);
+
+        CHECK(map.Size() == 3);
+        CHECK(*map.Get(a) == 10 && *map.Get(b) == 20 && *map.Get(c) == 30);
+        CHECK(map.Index(a) == 0 && map.Index(c) == 2);
+
+        // o ltimo objeto ocupa o lugar do removido e mantm o handle
+        CHECK(map.Remove(a));
+        CHECK(map.Size() == 2);
+        CHECK(!map.Valid(a));
+        CHECK(map.Get(a) == nullptr);
+        CHECK(map.Index(a) == None);
+        CHECK(map.Index(c) == 0 && *map.Get(c) == 30);
+        CHECK(map[0] == 30 && map[1] == 20);
+        CHECK(map.At(0) == c);
+
+        // remover de novo com o handle antigo no faz nada
+        CHECK(!map.Remove(a));
+        CHECK(map.Size() == 2);
+
+        // a entrada livre  reaproveitada com a gerao seguinte
+        Handle d = map.Insert(40);
+        CHECK(d.index == a.index);
+        CHECK(d.generation == a.generation + 1);
+        CHECK(d != a);
+        CHECK(!map.Valid(a));
+        CHECK(map.Get(a) == nullptr);
+        CHECK(*map.Get(d) == 40);
+
+        // um ciclo a mais de remoo e reuso invalida tambm o segundo handle
+        CHECK(map.Remove(d));
+        Handle e = map.Insert(50);
+        CHECK(e.index == a.index && e.generation == a.generation + 2);
+        CHECK(!map.Valid(a) && !map.Valid(d) && map.Valid(e));
+
+        // handles padro e de entradas inexistentes so recusados
+        CHECK(!map.Valid(Handle {}));
+        CHECK(!map.Valid(Handle { 99, 1 }));
+        CHECK(map.Get(Handle {}) == nullptr);
+        CHECK(!map.Remove(Handle {}));
+
+        // Clear invalida todos os handles em uso
+        map.Clear();
+        CHECK(map.Size() == 0);
+        CHECK(!map.Valid(b) && !map.Valid(c) && !map.Valid(e));
+    }
+
+    // remoes e inseres aleatrias conferidas contra uma cpia por handle
+    {
+        struct Entry
+        {
+            Handle handle;
+            uint value;
+        };
+
+        SlotMap<uint> map;
+        vector<Entry> live;
+        vector<Handle> dead;
+        std::mt19937 rng(44);
+        bool consistent = true;
+
+        for (uint step = 0; step < 50000; ++step)
+        {
+            if (live.empty() || rng() % 5 < 3)
+            {
+                uint value = rng();
+                live.push_back({ map.Insert(value), value });
+            }
+            else
+            {
+                uint k = rng() % live.size();
+                consistent = consistent && map.Remove(live[k].handle);
+                dead.push_back(live[k].handle);
+                live[k] = live.back();
+                live.pop_back();
+            }
+
+            // a cada tanto, todos os handles so conferidos
+            if (step % 997 == 0)
+            {
+                for (const Entry & e : live)
+                {
+                    uint * item = map.Get(e.handle);
+                    consistent = consistent && item && *item == e.value;
+                    consistent = consistent && map.At(map.Index(e.handle)) == e.handle;
+                }
+
+                for (Handle h : dead)
+                    consistent = consistent && !map.Valid(h) && !map.Get(h);
+            }
+        }
+
+        CHECK(consistent);
+        CHECK(map.Size() == live.size());
+
+        // o percurso denso visita exatamente os objetos vivos
+        ullong sum = 0, expected = 0;
+        for (uint v : map)
+            sum += v;
+        for (const Entry & e : live)
+            expected += e.value;
+
+        CHECK(sum == expected);
+    }
+
+    if (Bench(argc, argv))
+    {
+        // 100 mil objetos com 64 bytes, trocados em rodzio
+        struct Item { float data[16]; };
+        const uint count = 100000, steps = 1000000;
+        SlotMap<Item> map;
+        vector<Handle> handles(count);
+        std::mt19937 rng(7);
+
+        for (Handle & h : handles)
+            h = map.Insert(Item {});
+
+        double churn = Measure(3, [&] {
+            for (uint s = 0; s < steps; ++s)
+            {
+                Handle & h = handles[rng() % count];
+                map.Remove(h);
+                h = map.Insert(Item {});
+            }
+        });
+
+        // acumulado em voltil para as leituras no serem descartadas
+        volatile float total = 0;
+        double lookup = Measure(3, [&] {
+            for (uint s = 0; s < steps; ++s)
+                total += map.Get(handles[rng() % count])->data[0];
+        });
+
+        double walk = Measure(3, [&] {
+            for (Item & item : map)
+                total += item.data[0];
+        });
+
+        printf("slot map: %u objetos de %zu bytes\n", count, sizeof(Item));
+        printf("  remoo e insero %6.1f ns, consulta por handle %6.1f ns, percurso %7.3f ms\n",
+               churn * 1e6 / steps, lookup * 1e6 / steps, walk);
+    }
+
+    return Report("SlotMapTest");
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+/**********************************************************************************
+// TessLevelsTest (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Verifica a escolha da faixa de tesselao: a faixa cresce com
+//              o raio projetado,  a menor cujo erro da corda fica abaixo de
+//              meio pixel e satura na ltima quando nenhuma basta. Com
+//              "bench", mede o custo de uma escolha.
+//
+**********************************************************************************/
+
+#include "Test.h"
+#include "TessLevels.h"
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+
+// distncia mxima entre um crculo de raio r (em pixels) e o polgono de n lados
+static double ChordError(double r, uint n)
+{
+    return r * (1.0 - cos(3.14159265358979 / n));
+}
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    // faixas em ordem crescente de detalhe
+    bool increasing = true;
+    for (uint i = 1; i < TessBuckets; ++i)
+    {
+        increasing = increasing && SphereLevels[i][0] > SphereLevels[i - 1][0];
+        increasing = increasing && SphereLevels[i][1] >= SphereLevels[i - 1][1];
+        increasing = increasing && CylinderLevels[i][0] > CylinderLevels[i - 1][0];
+        increasing = increasing && CylinderLevels[i][1] >= CylinderLevels[i - 1][1];
+    }
+
+    CHECK(increasing);
+
+    // objetos minsculos, fora da tela ou com raio invlido usam a menor faixa
+    CHECK(TessBucket(0.0f) == 0);
+    CHECK(TessBucket(-10.0f) == 0);
+    CHECK(TessBucket(1.0f) == 0);
+    CHECK(TessBucket(6.0f) == 0);
+
+    // objetos enormes saturam na ltima faixa
+    CHECK(TessBucket(1e4f) == TessBuckets - 1);
+    CHECK(TessBucket(1e30f) == TessBuckets - 1);
+
+    // varredura de 1 a 1000 pixels: faixa nunca diminui, respeita meio pixel
+    // de erro e a faixa anterior no bastaria
+    bool monotonic = true, accurate = true, smallest = true;
+    uint last = 0;
+
+    for (float r = 1.0f; r <= 1000.0f; r *= 1.01f)
+    {
+        uint bucket = TessBucket(r);
+        monotonic = monotonic && bucket >= last && bucket < TessBuckets;
+        last = bucket;
+
+        // a ltima faixa  o limite de detalhe, mesmo acima de meio pixel
+        if (bucket < TessBuckets - 1)
+            accurate = accurate && ChordError(r, SphereLevels[bucket][0]) <= 0.5 + 1e-3;
+
+        if (bucket > 0)
+            smallest = smallest && ChordError(r, SphereLevels[bucket - 1][0]) > 0.5 - 0.05;
+    }
+
+    CHECK(monotonic);
+    CHECK(accurate);
+    CHECK(smallest);
+    CHECK(last == TessBuckets - 1);
+
+    // limites das faixas: n = PI * sqrt(r) troca de faixa onde n passa do
+    // nmero de fatias (8 fatias atendem at r = 6.48 pixels)
+    CHECK(TessBucket(6.4f) == 0 && TessBucket(6.6f) == 1);
+    CHECK(TessBucket(14.5f) == 1 && TessBucket(14.7f) == 2);
+
+    if (Bench(argc, argv))
+    {
+        const uint calls = 10000000;
+        volatile uint sink = 0;
+
+        double time = Measure(5, [&] {
+            for (uint i = 0; i < calls; ++i)
+                sink = sink + TessBucket(float(i % 512));
+        });
+
+        printf("tess levels: %u faixas\n", TessBuckets);
+        printf("  escolha da faixa %5.2f ns\n", time * 1e6 / calls);
+    }
+
+    return Report("TessLevelsTest");
+}
+
+// -------------------------------------------------------------------------------
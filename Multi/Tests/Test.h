@@ -0,0 +1,73 @@
+/**********************************************************************************
+// Test (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022, g++
+//
+// Descrio:   Apoio aos programas de teste dos mdulos portveis. CHECK
+//              registra falhas sem interromper o programa, Measure devolve o
+//              menor tempo entre vrias repeties e as medidas de desempenho
+//              s so feitas quando o programa recebe o argumento "bench".
+//
+**********************************************************************************/
+
+#ifndef DXUT_TEST_H_
+#define DXUT_TEST_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// -------------------------------------------------------------------------------
+
+// falhas registradas pelo programa
+inline uint & Failures()
+{
+    static uint failures = 0;
+    return failures;
+}
+
+// registra uma falha com o arquivo e a linha da verificao
+#define CHECK(condition) \
+    do { if (!(condition)) { ++Failures(); printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #condition); } } while (0)
+
+// -------------------------------------------------------------------------------
+
+// menor tempo em milissegundos entre repeat execues de work
+template<class Work>
+double Measure(uint repeat, Work work)
+{
+    using Clock = std::chrono::steady_clock;
+    double best = 1e30;
+
+    for (uint i = 0; i < repeat; ++i)
+    {
+        auto start = Clock::now();
+        work();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        best = ms < best ? ms : best;
+    }
+
+    return best;
+}
+
+// medidas de desempenho foram pedidas?
+inline bool Bench(int argc, char ** argv)
+{
+    return argc > 1 && !strcmp(argv[1], "bench");
+}
+
+// resultado do programa: 0 se nenhuma verificao falhou
+inline int Report(const char * name)
+{
+    printf("%s: %s\n", name, Failures() ? "FALHOU" : "ok");
+    return Failures() ? 1 : 0;
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
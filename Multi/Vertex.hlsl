@@ -2,20 +2,27 @@
 // Vertex (Arquivo de Sombreamento)
 //
 // Criao:     22 Jul 2020
-// Atualizao: 08 Set 2023
+// Atualizao: 19 Out 2026
 // Compilador:  Direct3D Shader Compiler (FXC)
 //
 // Descrio:   Um vertex shader que faz a transformao de vrtices
-//              a partir de uma matriz combinada WorldViewProj fornecida
+//              a partir da matriz de mundo do objeto e da matriz
+//              ViewProj da vista, fornecidas em buffers separados. A cor
+//              do objeto multiplica a cor dos vrtices
 //
 **********************************************************************************/
 
-cbuffer Object
+cbuffer Object : register(b0)
 {
-    float4x4 WorldViewProj;
+    float4x4 World;
     float4 color;
 };
 
+cbuffer View : register(b1)
+{
+    float4x4 ViewProj;
+};
+
 struct VertexIn
 {
     float3 PosL  : POSITION;
@@ -33,10 +40,11 @@ VertexOut main(VertexIn vin)
     VertexOut vout;
 
     // transforma para espao homogneo de recorte
-    vout.PosH = mul(float4(vin.PosL, 1.0f), WorldViewProj);
+    float4 posW = mul(float4(vin.PosL, 1.0f), World);
+    vout.PosH = mul(posW, ViewProj);
 
-    // apenas passa a cor do vrtice para o pixel shader
-    vout.Color = vin.Color;
+    // cor do vrtice tingida pela cor do objeto
+    vout.Color = vin.Color * color;
 
     return vout;
 }
\ No newline at end of file